@@ -21,6 +21,7 @@ public class AudioPlayerPawn : ModuleRules
                 "SlateCore",
                 "EnhancedInput", 
                 "AudioProfiler",
+                "MetasoundEngine",
             }
         );
     }
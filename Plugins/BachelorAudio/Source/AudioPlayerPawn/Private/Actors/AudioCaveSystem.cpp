@@ -2,7 +2,10 @@
 
 #include "Actors/AudioCaveSystem.h"
 
+#include "AudioDevice.h"
 #include "AudioPlayerPawnModule.h"
+#include "MetasoundOperatorCacheSubsystem.h"
+#include "MetasoundSource.h"
 #include "Components/AudioComponent.h"
 #include "Subsystems/AudioProfilerSubsystem.h"
 
@@ -25,6 +28,7 @@ void AAudioCaveSystem::BeginPlay() {
 			);
 		AudioComponentPool.Add(audioSourceComponent);
 	}
+	PrewarmSounds();
 	GetWorld()->GetTimerManager().SetTimer(
 		TimerHandle,
 		this,
@@ -217,6 +221,30 @@ void AAudioCaveSystem::ProcessPendingSoundDrops() {
 	}
 }
 
+void AAudioCaveSystem::PrewarmSounds() {
+	if(!bPrewarmSounds) return;
+	FAudioDeviceHandle audioDevice = GetWorld()->GetAudioDevice();
+	if(!audioDevice.IsValid()) return;
+	UMetaSoundCacheSubsystem* cacheSubsystem = audioDevice->GetSubsystem<UMetaSoundCacheSubsystem>();
+	if(cacheSubsystem == nullptr) {
+		UE_LOG(LogAudioPlayerPawnModule, Warning, TEXT("No MetaSound operator cache, sounds are not prewarmed"));
+		return;
+	}
+	// Drop and impact lists may share sounds, every MetaSound is cached once.
+	TSet<UMetaSoundSource*> prewarmedSounds;
+	for(const TArray<USoundBase*>* sounds : { &DropSounds, &ImpactSounds }) {
+		for(USoundBase* sound : *sounds) {
+			UMetaSoundSource* metaSound = Cast<UMetaSoundSource>(sound);
+			if(metaSound == nullptr) continue;
+			bool bAlreadyPrewarmed = false;
+			prewarmedSounds.Add(metaSound, &bAlreadyPrewarmed);
+			if(bAlreadyPrewarmed) continue;
+			cacheSubsystem->PrecacheMetaSound(metaSound, FMath::Max(PrewarmInstancesPerSound, 1));
+		}
+	}
+	UE_LOG(LogAudioPlayerPawnModule, Log, TEXT("Prewarmed %d MetaSounds"), prewarmedSounds.Num());
+}
+
 UAudioComponent* AAudioCaveSystem::GetAvailableAudioComponent() {
 	for(UAudioComponent* audioSourceComponent : AudioComponentPool) {
 		if(!audioSourceComponent->IsPlaying()) return audioSourceComponent;
@@ -154,6 +154,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio")
 	int32 PoolSize = 10;
 
+	/** Whether the MetaSound graphs of all drop and impact sounds are built at BeginPlay instead of on first play. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Prewarm")
+	bool bPrewarmSounds = true;
+
+	/** Number of operator instances built per MetaSound, covers that many simultaneous first plays. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio|Prewarm", meta = (ClampMin = "1", EditCondition = "bPrewarmSounds"))
+	int32 PrewarmInstancesPerSound = 1;
+
 	/** Time interval between sound spawns. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawning")
 	float CustomSpawnTime = .2f;
@@ -189,6 +197,15 @@ private:
 	 */
 	UAudioComponent* GetAvailableAudioComponent();
 
+	/**
+	 * @brief Builds and caches the operators of every MetaSound in DropSounds and ImpactSounds.
+	 * 
+	 * Uses the MetaSound operator cache of the audio device, so the first Play() of a sound takes a
+	 * cached graph instead of building it on the audio render thread. Sounds that are no MetaSound
+	 * are skipped, they have no graph to build.
+	 */
+	void PrewarmSounds();
+
 	/** Timer handle for spawning sound events at a fixed interval. */
 	FTimerHandle TimerHandle;
 
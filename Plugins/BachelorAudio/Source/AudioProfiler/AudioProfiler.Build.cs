@@ -16,7 +16,9 @@ public class AudioProfiler : ModuleRules
                 "SlateCore",
                 "TestingHelper",
                 "DeveloperSettings",
-                "AudioMixer"
+                "AudioMixer",
+                "SignalProcessing",
+                "BachelorRenderStats"
             });
         DynamicallyLoadedModuleNames.AddRange(new string[] {});
     }
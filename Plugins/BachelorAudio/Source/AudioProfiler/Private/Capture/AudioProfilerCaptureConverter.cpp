@@ -0,0 +1,60 @@
+﻿/**
+ * @file AudioProfilerCaptureConverter.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerCaptureConverter.h"
+
+#include "Capture/AudioProfilerCaptureReader.h"
+#include "Statistics/AudioProfilerStatistics.h"
+#include "Subsystems/AudioProfilerExportWriter.h"
+
+namespace BachelorAudio::AudioProfiler {
+	bool FAudioProfilerCaptureConverter::Convert(
+		const FString& InCapturePath,
+		const FString& InCSVFilePath,
+		const FString& InMDFilePath
+		) {
+		FAudioProfilerCaptureReader reader;
+		if(!reader.Open(InCapturePath)) return false;
+
+		FAudioProfilerExportWriter writer(InCSVFilePath, InMDFilePath);
+		FAudioProfilerStatistics statistics;
+		bool bSucceeded = true;
+		TArray<FAudioProfilerTimestampModel> timestamps;
+		for(int32 i = 0; i < reader.GetNumChunks(); ++i) {
+			timestamps.Reset();
+			bSucceeded &= reader.ReadChunk(i, timestamps);
+			writer.Append(timestamps);
+			statistics.Add(timestamps);
+		}
+
+		const int32 numSamples = static_cast<int32>(reader.GetHeader().NumRecords);
+		bSucceeded &= writer.Finalize(BuildMDHeader(reader.GetHeaderModel(), numSamples, InCSVFilePath, statistics));
+		return bSucceeded;
+	}
+
+	FString FAudioProfilerCaptureConverter::BuildMDHeader(
+		const FAudioProfilerHeaderModel& InHeader,
+		const int32 InNumSamples,
+		const FString& InCSVFilePath,
+		const FAudioProfilerStatistics& InStatistics
+		) {
+		FString MDHeader = FString::Printf(TEXT("# %s\n\n"), *InHeader.SessionName);
+		MDHeader += FString::Printf(TEXT("**Tester:** Markus Schramm\t **Date:** %s\n**Time:** %s\t\t**World:** %s\n"),
+			*InHeader.Date.ToFormattedString(TEXT("%d.%m.%Y")),
+			*InHeader.Date.ToFormattedString(TEXT("%H:%M:%S")),
+			*InHeader.WorldName
+			);
+		MDHeader += FString::Printf(TEXT("**CSV Path:**\t%s\n"), *InCSVFilePath);
+		MDHeader += FString::Printf(TEXT("**Sample Rate:**\t%d\n"), InHeader.SampleRate);
+		MDHeader += FString::Printf(TEXT("**Max Channels:**\t%d\n"), InHeader.MaxChannels);
+		MDHeader += FString::Printf(TEXT("**Max Sources:**\t%d\n"), InHeader.MaxSources);
+		MDHeader += FString::Printf(TEXT("**Audio Buffer Length:**\t%d\n"), InHeader.BufferLength);
+		MDHeader += FString::Printf(TEXT("**Num Audio Buffers:**\t%d\n"), InHeader.NumBuffers);
+		MDHeader += FString::Printf(TEXT("**Num Source Workers:**\t%d\n"), InHeader.NumSourceWorkers);
+		MDHeader += FString::Printf(TEXT("**Samples:**\t%d\n"), InNumSamples);
+		MDHeader += InStatistics.BuildMDSummary();
+		return MDHeader;
+	}
+}
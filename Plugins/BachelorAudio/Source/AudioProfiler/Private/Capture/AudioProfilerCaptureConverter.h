@@ -0,0 +1,54 @@
+﻿/**
+ * @file AudioProfilerCaptureConverter.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/AudioProfilerHeaderModel.h"
+#include "Models/AudioProfilerTimestampModel.h"
+
+namespace BachelorAudio::AudioProfiler {
+	class FAudioProfilerStatistics;
+
+	/**
+	 * @class FAudioProfilerCaptureConverter
+	 * @brief Converts a binary capture into the CSV and Markdown report
+	 * @details Decodes one chunk at a time and streams it to the FAudioProfilerExportWriter,
+	 * so the reports equal the ones written from timestamp models while capturing.
+	 * Session percentiles are counted while converting, their memory does not grow with the session.
+	 * Runs on the calling thread and needs no world or audio device.
+	 */
+	class FAudioProfilerCaptureConverter {
+	public:
+		/**
+		 * Converts a capture file.
+		 * @param InCapturePath Path of the capture file.
+		 * @param InCSVFilePath Path of the CSV file to write.
+		 * @param InMDFilePath Path of the Markdown report to write.
+		 * @return Whether the capture was read and both files were written completely.
+		 */
+		static bool Convert(
+			const FString& InCapturePath,
+			const FString& InCSVFilePath,
+			const FString& InMDFilePath
+			);
+
+		/**
+		 * Builds the header section for the Markdown report.
+		 * Creates a title, summary, and link to the CSV data.
+		 * @param InHeader Session information of the capture.
+		 * @param InNumSamples Number of captured timestamps.
+		 * @param InCSVFilePath Path to the CSV file referenced in the markdown.
+		 * @param InStatistics Session percentiles listed below the session information.
+		 * @return String containing the markdown header content.
+		 */
+		static FString BuildMDHeader(
+			const FAudioProfilerHeaderModel& InHeader,
+			const int32 InNumSamples,
+			const FString& InCSVFilePath,
+			const FAudioProfilerStatistics& InStatistics
+			);
+	};
+}
@@ -0,0 +1,200 @@
+﻿/**
+ * @file AudioProfilerCaptureReader.cpp
+ * @author Markus Schramm
+ */
+
+#include "Capture/AudioProfilerCaptureReader.h"
+
+#include "AudioProfilerModule.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace BachelorAudio::AudioProfiler {
+	using namespace Capture;
+
+	FAudioProfilerCaptureReader::FAudioProfilerCaptureReader() = default;
+
+	// Defined here, where the mapped file types are complete
+	FAudioProfilerCaptureReader::~FAudioProfilerCaptureReader() {
+		MappedRegion.Reset();
+		MappedFile.Reset();
+	}
+
+	bool FAudioProfilerCaptureReader::Open(const FString& InFilePath) {
+		MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InFilePath));
+		if(MappedFile.IsValid()) MappedRegion.Reset(MappedFile->MapRegion());
+		if(MappedRegion.IsValid()) {
+			Data = MappedRegion->GetMappedPtr();
+			Size = static_cast<uint64>(MappedRegion->GetMappedSize());
+		} else if(FFileHelper::LoadFileToArray(FileData, *InFilePath)) {
+			Data = FileData.GetData();
+			Size = static_cast<uint64>(FileData.Num());
+		} else {
+			UE_LOG(LogAudioProfiler, Error, TEXT("Can not read capture %s"), *InFilePath);
+			return false;
+		}
+
+		Header = GetColumn<FAudioProfilerCaptureHeader>(0, 1);
+		if(Header == nullptr || Header->Magic != Magic || Header->Version != Version) {
+			UE_LOG(LogAudioProfiler, Error, TEXT("%s is no capture of version %u"), *InFilePath, Version);
+			return false;
+		}
+		if(Header->StringTableOffset == 0) {
+			UE_LOG(LogAudioProfiler, Error, TEXT("Capture %s was not finalized"), *InFilePath);
+			return false;
+		}
+
+		ChunkOffsets = GetColumn<uint64>(Header->ChunkTableOffset, Header->NumChunks);
+		const uint32* nodeClassIds = GetColumn<uint32>(Header->NodeClassTableOffset, Header->NumNodeClasses);
+
+		uint64 cursor = Header->StringTableOffset;
+		const FAudioProfilerCaptureStringTable* stringTable = NextColumn<FAudioProfilerCaptureStringTable>(cursor, 1);
+		const uint32* offsets = stringTable != nullptr
+			? NextColumn<uint32>(cursor, static_cast<uint64>(stringTable->NumStrings) + 1)
+			: nullptr;
+		const UTF8CHAR* bytes = offsets != nullptr
+			? GetColumn<UTF8CHAR>(cursor, offsets[stringTable->NumStrings])
+			: nullptr;
+		if(ChunkOffsets == nullptr || nodeClassIds == nullptr || bytes == nullptr) {
+			UE_LOG(LogAudioProfiler, Error, TEXT("Capture %s is truncated"), *InFilePath);
+			return false;
+		}
+
+		Strings.Reset(stringTable->NumStrings);
+		for(uint32 i = 0; i < stringTable->NumStrings; ++i) {
+			const uint32 begin = FMath::Min(offsets[i], offsets[i + 1]);
+			const FUTF8ToTCHAR string(reinterpret_cast<const ANSICHAR*>(bytes + begin), offsets[i + 1] - begin);
+			Strings.Emplace(string.Length(), string.Get());
+		}
+
+		NodeClassNames.Reset(Header->NumNodeClasses);
+		for(uint32 i = 0; i < Header->NumNodeClasses; ++i) {
+			NodeClassNames.Add(GetString(nodeClassIds[i]));
+		}
+		return true;
+	}
+
+	FAudioProfilerHeaderModel FAudioProfilerCaptureReader::GetHeaderModel() const {
+		FAudioProfilerHeaderModel headerModel;
+		headerModel.SessionName = GetString(Header->SessionNameId);
+		headerModel.WorldName = GetString(Header->WorldNameId);
+		headerModel.Date = FDateTime(Header->DateTicks);
+		headerModel.StartTime = Header->FirstTimestamp;
+		headerModel.SampleRate = Header->SampleRate;
+		headerModel.MaxChannels = Header->MaxChannels;
+		headerModel.MaxSources = Header->MaxSources;
+		headerModel.BufferLength = Header->BufferLength;
+		headerModel.NumBuffers = Header->NumBuffers;
+		headerModel.NumSourceWorkers = Header->NumSourceWorkers;
+		return headerModel;
+	}
+
+	const FString& FAudioProfilerCaptureReader::GetString(const uint32 InId) const {
+		static const FString empty;
+		return Strings.IsValidIndex(static_cast<int32>(InId)) ? Strings[static_cast<int32>(InId)] : empty;
+	}
+
+	bool FAudioProfilerCaptureReader::ReadChunk(const int32 InIndex, TArray<FAudioProfilerTimestampModel>& OutTimestamps) const {
+		if(InIndex < 0 || InIndex >= GetNumChunks()) return false;
+
+		uint64 cursor = ChunkOffsets[InIndex];
+		const FAudioProfilerCaptureChunkHeader* chunkHeader = NextColumn<FAudioProfilerCaptureChunkHeader>(cursor, 1);
+		if(chunkHeader == nullptr) return false;
+		const uint64 numRecords = chunkHeader->NumRecords;
+
+		bool bIsComplete = true;
+		const uint32* timestampDeltas = NextColumn<uint32>(cursor, numRecords);
+		bIsComplete &= timestampDeltas != nullptr;
+		const float* floatColumns[NumFloatColumns];
+		for(const float*& column : floatColumns) {
+			column = NextColumn<float>(cursor, numRecords);
+			bIsComplete &= column != nullptr;
+		}
+		const int32* intColumns[NumIntColumns];
+		for(const int32*& column : intColumns) {
+			column = NextColumn<int32>(cursor, numRecords);
+			bIsComplete &= column != nullptr;
+		}
+		TArray<const uint64*, TInlineAllocator<8>> cyclesColumns;
+		TArray<const uint32*, TInlineAllocator<8>> numExecutesColumns;
+		TArray<const uint32*, TInlineAllocator<8>> numSamplesColumns;
+		for(uint32 i = 0; i < Header->NumNodeClasses; ++i) {
+			bIsComplete &= cyclesColumns.Add_GetRef(NextColumn<uint64>(cursor, numRecords)) != nullptr;
+			bIsComplete &= numExecutesColumns.Add_GetRef(NextColumn<uint32>(cursor, numRecords)) != nullptr;
+			bIsComplete &= numSamplesColumns.Add_GetRef(NextColumn<uint32>(cursor, numRecords)) != nullptr;
+		}
+		const uint32* soundBegin = NextColumn<uint32>(cursor, numRecords + 1);
+		const FAudioProfilerCaptureSound* sounds = NextColumn<FAudioProfilerCaptureSound>(cursor, chunkHeader->NumSounds);
+		const uint32* bookmarkBegin = NextColumn<uint32>(cursor, numRecords + 1);
+		const FAudioProfilerCaptureBookmark* bookmarks = NextColumn<FAudioProfilerCaptureBookmark>(cursor, chunkHeader->NumBookmarks);
+		bIsComplete &= soundBegin != nullptr && sounds != nullptr && bookmarkBegin != nullptr && bookmarks != nullptr;
+		if(!bIsComplete) return false;
+
+		OutTimestamps.Reserve(OutTimestamps.Num() + static_cast<int32>(numRecords));
+		uint64 timestampMicroseconds = chunkHeader->FirstTimestampMicroseconds;
+		int32 intValues[NumIntColumns] = {};
+		for(uint64 i = 0; i < numRecords; ++i) {
+			FAudioProfilerTimestampModel& timestamp = OutTimestamps.AddDefaulted_GetRef();
+
+			timestampMicroseconds += timestampDeltas[i];
+			timestamp.Timestamp = Header->FirstTimestamp + timestampMicroseconds * 1.0e-6;
+			timestamp.CurrentAudioDelta = floatColumns[0][i];
+			timestamp.CurrentAudioTime = floatColumns[1][i];
+			timestamp.CurrentDelta = floatColumns[2][i];
+			timestamp.CPUUsage = floatColumns[3][i];
+			timestamp.MemoryUsageMB = floatColumns[4][i];
+			timestamp.MasterVolumeLin = floatColumns[5][i];
+			timestamp.Headroom = floatColumns[6][i];
+			timestamp.CallbackPeriodP50Ms = floatColumns[7][i];
+			timestamp.CallbackPeriodP99Ms = floatColumns[8][i];
+			timestamp.CallbackPeriodMaxMs = floatColumns[9][i];
+			timestamp.BufferLengthMs = floatColumns[10][i];
+			timestamp.OutputRmsDb = floatColumns[11][i];
+			timestamp.OutputTruePeakDb = floatColumns[12][i];
+			timestamp.OutputLoudnessLUFS = floatColumns[13][i];
+			timestamp.OutputSpectrumDb.SetNumUninitialized(NumFloatColumns - FirstSpectrumColumn);
+			for(int32 band = 0; band < timestamp.OutputSpectrumDb.Num(); ++band) {
+				timestamp.OutputSpectrumDb[band] = floatColumns[FirstSpectrumColumn + band][i];
+			}
+			timestamp.Framerate = timestamp.CurrentDelta > 0.f
+				? FMath::Clamp(1 / timestamp.CurrentDelta, 0.f, 1000.f)
+				: 0.f;
+
+			for(int32 column = 0; column < NumIntColumns; ++column) {
+				intValues[column] = i == 0 ? intColumns[column][i] : intValues[column] + intColumns[column][i];
+			}
+			timestamp.ActiveSoundCount = intValues[0];
+			timestamp.FreeSourcesCount = intValues[1];
+			timestamp.CallbackCount = intValues[2];
+			timestamp.LateCallbackCount = intValues[3];
+
+			for(uint32 nodeClass = 0; nodeClass < Header->NumNodeClasses; ++nodeClass) {
+				FAudioProfilerNodeCostModel& nodeCost = timestamp.NodeCosts.AddDefaulted_GetRef();
+				nodeCost.NodeClassName = NodeClassNames[nodeClass];
+				nodeCost.NumExecutes = numExecutesColumns[nodeClass][i];
+				nodeCost.NumSamples = numSamplesColumns[nodeClass][i];
+				nodeCost.RenderTimeMs = cyclesColumns[nodeClass][i] * Header->SecondsPerCycle * 1000.0;
+				nodeCost.NanosecondsPerSample = nodeCost.NumSamples > 0
+					? nodeCost.RenderTimeMs * 1.0e6 / nodeCost.NumSamples
+					: 0.0;
+			}
+
+			const uint32 lastSound = FMath::Min(soundBegin[i + 1], chunkHeader->NumSounds);
+			for(uint32 sound = soundBegin[i]; sound < lastSound; ++sound) {
+				FAudioProfilerSoundModel& activeSound = timestamp.ActiveSounds.AddDefaulted_GetRef();
+				activeSound.ActiveSoundName = GetString(sounds[sound].NameId);
+				activeSound.ActiveSoundVolume = sounds[sound].Volume;
+			}
+
+			const uint32 lastBookmark = FMath::Min(bookmarkBegin[i + 1], chunkHeader->NumBookmarks);
+			for(uint32 bookmark = bookmarkBegin[i]; bookmark < lastBookmark; ++bookmark) {
+				timestamp.ActiveBookmarks.Add(FString::Printf(TEXT("%s: %f"),
+					*GetString(bookmarks[bookmark].NameId),
+					bookmarks[bookmark].Time
+					));
+			}
+		}
+		return true;
+	}
+}
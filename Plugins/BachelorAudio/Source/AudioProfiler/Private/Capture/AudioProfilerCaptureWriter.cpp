@@ -0,0 +1,366 @@
+﻿/**
+ * @file AudioProfilerCaptureWriter.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerCaptureWriter.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/ScopeLock.h"
+#include "Models/AudioProfilerHeaderModel.h"
+#include "Sound/SoundBase.h"
+#include "Subsystems/AudioProfilerBookmarkQueue.h"
+#include "Subsystems/AudioProfilerSampler.h"
+
+namespace BachelorAudio::AudioProfiler {
+	using namespace Capture;
+
+	namespace {
+		/** Zeros used to pad columns to the section alignment */
+		constexpr uint8 Padding[8] = {};
+
+		/** Active sounds per record a chunk reserves if the device reports no channel limit */
+		constexpr int32 DefaultSoundsPerRecord = 16;
+
+		static_assert(FirstSpectrumColumn + NumSpectrumBands == NumFloatColumns, "Every spectrum band needs a float column");
+	}
+
+	void FAudioProfilerCaptureWriter::FChunk::Reserve(const int32 InNumNodeClasses, const int32 InNumSounds) {
+		TimestampDeltas.Reserve(RecordsPerChunk);
+		for(TArray<float>& column : FloatColumns) column.Reserve(RecordsPerChunk);
+		for(TArray<int32>& column : IntColumns) column.Reserve(RecordsPerChunk);
+		for(int32 i = 0; i < InNumNodeClasses; ++i) {
+			CyclesDeltas[i].Reserve(RecordsPerChunk);
+			NumExecutesDeltas[i].Reserve(RecordsPerChunk);
+			NumSamplesDeltas[i].Reserve(RecordsPerChunk);
+		}
+		SoundBegin.Reserve(RecordsPerChunk + 1);
+		Sounds.Reserve(InNumSounds);
+		BookmarkBegin.Reserve(RecordsPerChunk + 1);
+	}
+
+	void FAudioProfilerCaptureWriter::FChunk::Reset() {
+		FirstTimestampMicroseconds = 0;
+		TimestampDeltas.Reset();
+		for(TArray<float>& column : FloatColumns) column.Reset();
+		for(TArray<int32>& column : IntColumns) column.Reset();
+		for(int32 i = 0; i < MaxNodeClasses; ++i) {
+			CyclesDeltas[i].Reset();
+			NumExecutesDeltas[i].Reset();
+			NumSamplesDeltas[i].Reset();
+		}
+		SoundBegin.Reset();
+		Sounds.Reset();
+		BookmarkBegin.Reset();
+		Bookmarks.Reset();
+	}
+
+	FAudioProfilerCaptureWriter::FAudioProfilerCaptureWriter(
+		const FString& InFilePath,
+		const FAudioProfilerHeaderModel& InHeader,
+		const double InInterval,
+		const bool bInCaptureNodeCosts,
+		const uint32 InExpectedRecords
+		)
+	: FilePath(InFilePath) {
+		Header.SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+		Header.Interval = InInterval;
+		Header.DateTicks = InHeader.Date.GetTicks();
+		Header.SessionNameId = Intern(InHeader.SessionName);
+		Header.WorldNameId = Intern(InHeader.WorldName);
+		Header.SampleRate = InHeader.SampleRate;
+		Header.MaxChannels = InHeader.MaxChannels;
+		Header.MaxSources = InHeader.MaxSources;
+		Header.BufferLength = InHeader.BufferLength;
+		Header.NumBuffers = InHeader.NumBuffers;
+		Header.NumSourceWorkers = InHeader.NumSourceWorkers;
+
+		if(bInCaptureNodeCosts) {
+			using namespace BachelorMetasound;
+			Header.NumNodeClasses = MaxNodeClasses;
+			for(int32 i = 0; i < MaxNodeClasses; ++i) {
+				const ENodeRenderClass nodeClass = static_cast<ENodeRenderClass>(i);
+				NodeClassIds.Add(Intern(LexToString(nodeClass)));
+				NodeTotals[i] = FNodeRenderStats::GetSnapshot(nodeClass);
+			}
+		}
+
+		// Sized once from the expected session length, so filling a chunk never grows the sound arena
+		// unless more sounds play than the device has channels
+		const int32 recordsPerChunk = static_cast<int32>(FMath::Clamp<uint32>(InExpectedRecords, 1, RecordsPerChunk));
+		NumSoundsPerChunk = recordsPerChunk * (Header.MaxChannels > 0 ? Header.MaxChannels : DefaultSoundsPerRecord);
+		ChunkOffsets.Reserve(FMath::DivideAndRoundUp(FMath::Max<uint32>(InExpectedRecords, 1), RecordsPerChunk));
+		Chunk = AcquireChunk();
+	}
+
+	void FAudioProfilerCaptureWriter::SetBaseline(const FAudioProfilerSampleRecord& InRecord) {
+		if(!InRecord.bHasNodeTotals) return;
+		for(uint32 i = 0; i < Header.NumNodeClasses; ++i) NodeTotals[i] = InRecord.NodeTotals[i];
+	}
+
+	void FAudioProfilerCaptureWriter::Add(const FAudioProfilerSampleRecord& Record) {
+		if(Chunk->Num() == static_cast<int32>(RecordsPerChunk)) FlushChunk();
+
+		if(Header.NumRecords == 0) Header.FirstTimestamp = Record.Timestamp;
+		++Header.NumRecords;
+
+		// Rounding the offset to the first record, not every delta, keeps the timestamps free of drift
+		const uint64 timestampMicroseconds = static_cast<uint64>(
+			FMath::RoundToDouble(FMath::Max(Record.Timestamp - Header.FirstTimestamp, 0.0) * 1.0e6));
+		const bool bIsFirstInChunk = Chunk->Num() == 0;
+		if(bIsFirstInChunk) Chunk->FirstTimestampMicroseconds = timestampMicroseconds;
+		Chunk->TimestampDeltas.Add(bIsFirstInChunk
+			? 0
+			: static_cast<uint32>(timestampMicroseconds - LastTimestampMicroseconds));
+		LastTimestampMicroseconds = timestampMicroseconds;
+
+		// Same order as the float columns in AudioProfilerCaptureFormat.h
+		Chunk->FloatColumns[0].Add(Record.CurrentAudioDelta);
+		Chunk->FloatColumns[1].Add(Record.CurrentAudioTime);
+		Chunk->FloatColumns[2].Add(Record.CurrentDelta);
+		Chunk->FloatColumns[3].Add(Record.CPUUsage);
+		Chunk->FloatColumns[4].Add(Record.MemoryUsageMB);
+		Chunk->FloatColumns[5].Add(Record.MasterVolumeLin);
+		Chunk->FloatColumns[6].Add(Record.Headroom);
+		Chunk->FloatColumns[7].Add(Record.RenderTiming.PeriodP50Ms);
+		Chunk->FloatColumns[8].Add(Record.RenderTiming.PeriodP99Ms);
+		Chunk->FloatColumns[9].Add(Record.RenderTiming.PeriodMaxMs);
+		Chunk->FloatColumns[10].Add(Record.RenderTiming.BufferLengthMs);
+
+		// Records without an analyzed output read as silence
+		const float rmsDb = Record.bHasOutputAnalysis ? Record.OutputAnalysis.RmsDb : MinLevelDb;
+		const float truePeakDb = Record.bHasOutputAnalysis ? Record.OutputAnalysis.TruePeakDb : MinLevelDb;
+		const float loudnessLufs = Record.bHasOutputAnalysis ? Record.OutputAnalysis.ShortTermLufs : MinLevelDb;
+		Chunk->FloatColumns[11].Add(rmsDb);
+		Chunk->FloatColumns[12].Add(truePeakDb);
+		Chunk->FloatColumns[13].Add(loudnessLufs);
+		for(int32 band = 0; band < NumSpectrumBands; ++band) {
+			Chunk->FloatColumns[FirstSpectrumColumn + band].Add(Record.bHasOutputAnalysis ? Record.OutputAnalysis.SpectrumDb[band] : MinLevelDb);
+		}
+
+		const int32 intValues[NumIntColumns] = {
+			Record.ActiveSoundCount,
+			Record.FreeSourcesCount,
+			Record.RenderTiming.NumCallbacks,
+			Record.RenderTiming.NumLateCallbacks
+		};
+		for(int32 i = 0; i < NumIntColumns; ++i) {
+			Chunk->IntColumns[i].Add(bIsFirstInChunk ? intValues[i] : intValues[i] - LastIntValues[i]);
+			LastIntValues[i] = intValues[i];
+		}
+
+		for(uint32 i = 0; i < Header.NumNodeClasses; ++i) {
+			const BachelorMetasound::FNodeRenderStatsSnapshot& totals = Record.bHasNodeTotals ? Record.NodeTotals[i] : NodeTotals[i];
+			Chunk->CyclesDeltas[i].Add(totals.Cycles - NodeTotals[i].Cycles);
+			Chunk->NumExecutesDeltas[i].Add(static_cast<uint32>(totals.NumExecutes - NodeTotals[i].NumExecutes));
+			Chunk->NumSamplesDeltas[i].Add(static_cast<uint32>(totals.NumSamples - NodeTotals[i].NumSamples));
+			NodeTotals[i] = totals;
+		}
+
+		Chunk->SoundBegin.Add(Chunk->Sounds.Num());
+		Chunk->BookmarkBegin.Add(Chunk->Bookmarks.Num());
+	}
+
+	void FAudioProfilerCaptureWriter::AddSound(const FString& InName, const float InVolume) {
+		if(Chunk->Num() == 0) return;
+		Chunk->Sounds.Add({ Intern(InName), InVolume });
+	}
+
+	void FAudioProfilerCaptureWriter::AddSound(const USoundBase* InSound, const float InVolume) {
+		if(InSound == nullptr || Chunk->Num() == 0) return;
+
+		// Keyed by object, so GetName only builds a string the first time a sound plays
+		uint32 nameId;
+		if(const uint32* knownId = SoundNameIds.Find(FObjectKey(InSound))) {
+			nameId = *knownId;
+		} else {
+			nameId = Intern(InSound->GetName());
+			SoundNameIds.Add(FObjectKey(InSound), nameId);
+		}
+		Chunk->Sounds.Add({ nameId, InVolume });
+	}
+
+	void FAudioProfilerCaptureWriter::AddBookmark(const FString& InName, const double InTime) {
+		if(Chunk->Num() == 0) return;
+		FAudioProfilerCaptureBookmark& bookmark = Chunk->Bookmarks.AddDefaulted_GetRef();
+		bookmark.NameId = Intern(InName);
+		bookmark.Time = InTime;
+	}
+
+	void FAudioProfilerCaptureWriter::AddBookmark(
+		const FAudioProfilerBookmarkQueue& InBookmarks,
+		const uint32 InNameId,
+		const double InTime
+		) {
+		if(Chunk->Num() == 0) return;
+
+		// Keyed by queue id, so the lock of the queue names is only taken the first time a name is used
+		uint32 nameId;
+		if(const uint32* knownId = BookmarkNameIds.Find(InNameId)) {
+			nameId = *knownId;
+		} else {
+			nameId = Intern(InBookmarks.GetName(InNameId));
+			BookmarkNameIds.Add(InNameId, nameId);
+		}
+		FAudioProfilerCaptureBookmark& bookmark = Chunk->Bookmarks.AddDefaulted_GetRef();
+		bookmark.NameId = nameId;
+		bookmark.Time = InTime;
+	}
+
+	void FAudioProfilerCaptureWriter::Finalize(FOnFinalized&& InOnFinalized) {
+		if(Chunk->Num() > 0) FlushChunk();
+
+		Header.NumChunks = FMath::DivideAndRoundUp(Header.NumRecords, RecordsPerChunk);
+		Launch([
+			this,
+			header = Header,
+			strings = MoveTemp(Strings),
+			nodeClassIds = MoveTemp(NodeClassIds),
+			onFinalized = MoveTemp(InOnFinalized)
+			]() mutable {
+			onFinalized(WriteTables(header, strings, nodeClassIds));
+		});
+		StringIds.Empty();
+		SoundNameIds.Empty();
+		BookmarkNameIds.Empty();
+	}
+
+	uint32 FAudioProfilerCaptureWriter::Intern(const FString& InString) {
+		if(const uint32* id = StringIds.Find(InString)) return *id;
+		const uint32 id = Strings.Add(InString);
+		StringIds.Add(InString, id);
+		return id;
+	}
+
+	void FAudioProfilerCaptureWriter::FlushChunk() {
+		Chunk->SoundBegin.Add(Chunk->Sounds.Num());
+		Chunk->BookmarkBegin.Add(Chunk->Bookmarks.Num());
+		Launch([this, chunk = MoveTemp(Chunk)]() mutable {
+			WriteChunk(*chunk);
+			ReleaseChunk(MoveTemp(chunk));
+		});
+		Chunk = AcquireChunk();
+	}
+
+	TUniquePtr<FAudioProfilerCaptureWriter::FChunk> FAudioProfilerCaptureWriter::AcquireChunk() {
+		{
+			FScopeLock lock(&FreeChunksLock);
+			if(FreeChunks.Num() > 0) return FreeChunks.Pop(false);
+		}
+		TUniquePtr<FChunk> chunk = MakeUnique<FChunk>();
+		chunk->Reserve(Header.NumNodeClasses, NumSoundsPerChunk);
+		return chunk;
+	}
+
+	void FAudioProfilerCaptureWriter::ReleaseChunk(TUniquePtr<FChunk>&& InChunk) {
+		InChunk->Reset();
+		FScopeLock lock(&FreeChunksLock);
+		FreeChunks.Add(MoveTemp(InChunk));
+	}
+
+	void FAudioProfilerCaptureWriter::Launch(TUniqueFunction<void()>&& InTask) {
+		// The task holds a reference, so the writer outlives every task even if the owner lets go
+		auto body = [self = AsShared(), task = MoveTemp(InTask)]() mutable { task(); };
+		LastTask = LastTask.IsValid()
+			? UE::Tasks::Launch(
+				TEXT("AudioProfilerCaptureWriter"),
+				MoveTemp(body),
+				UE::Tasks::Prerequisites(LastTask),
+				UE::Tasks::ETaskPriority::BackgroundNormal
+				)
+			: UE::Tasks::Launch(
+				TEXT("AudioProfilerCaptureWriter"),
+				MoveTemp(body),
+				UE::Tasks::ETaskPriority::BackgroundNormal
+				);
+	}
+
+	bool FAudioProfilerCaptureWriter::Open() {
+		if(bHasFailed) return false;
+		if(Archive.IsValid()) return true;
+
+		Archive.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+		if(!Archive.IsValid()) {
+			bHasFailed = true;
+			return false;
+		}
+		// Rewritten by WriteTables, a file without valid offsets is recognized as unfinished
+		FAudioProfilerCaptureHeader placeholder;
+		WriteColumn(&placeholder, sizeof(placeholder));
+		return true;
+	}
+
+	void FAudioProfilerCaptureWriter::WriteChunk(const FChunk& InChunk) {
+		if(!Open()) return;
+
+		ChunkOffsets.Add(static_cast<uint64>(Archive->Tell()));
+
+		FAudioProfilerCaptureChunkHeader chunkHeader;
+		chunkHeader.NumRecords = InChunk.Num();
+		chunkHeader.NumSounds = InChunk.Sounds.Num();
+		chunkHeader.NumBookmarks = InChunk.Bookmarks.Num();
+		chunkHeader.FirstTimestampMicroseconds = InChunk.FirstTimestampMicroseconds;
+		WriteColumn(&chunkHeader, sizeof(chunkHeader));
+
+		WriteColumn(InChunk.TimestampDeltas.GetData(), InChunk.TimestampDeltas.NumBytes());
+		for(const TArray<float>& column : InChunk.FloatColumns) WriteColumn(column.GetData(), column.NumBytes());
+		for(const TArray<int32>& column : InChunk.IntColumns) WriteColumn(column.GetData(), column.NumBytes());
+		for(uint32 i = 0; i < Header.NumNodeClasses; ++i) {
+			WriteColumn(InChunk.CyclesDeltas[i].GetData(), InChunk.CyclesDeltas[i].NumBytes());
+			WriteColumn(InChunk.NumExecutesDeltas[i].GetData(), InChunk.NumExecutesDeltas[i].NumBytes());
+			WriteColumn(InChunk.NumSamplesDeltas[i].GetData(), InChunk.NumSamplesDeltas[i].NumBytes());
+		}
+		WriteColumn(InChunk.SoundBegin.GetData(), InChunk.SoundBegin.NumBytes());
+		WriteColumn(InChunk.Sounds.GetData(), InChunk.Sounds.NumBytes());
+		WriteColumn(InChunk.BookmarkBegin.GetData(), InChunk.BookmarkBegin.NumBytes());
+		WriteColumn(InChunk.Bookmarks.GetData(), InChunk.Bookmarks.NumBytes());
+
+		bHasFailed = Archive->IsError();
+	}
+
+	bool FAudioProfilerCaptureWriter::WriteTables(
+		FAudioProfilerCaptureHeader InHeader,
+		const TArray<FString>& InStrings,
+		const TArray<uint32>& InNodeClassIds
+		) {
+		if(!Open()) return false;
+
+		InHeader.ChunkTableOffset = static_cast<uint64>(Archive->Tell());
+		WriteColumn(ChunkOffsets.GetData(), ChunkOffsets.NumBytes());
+
+		InHeader.NodeClassTableOffset = static_cast<uint64>(Archive->Tell());
+		WriteColumn(InNodeClassIds.GetData(), InNodeClassIds.NumBytes());
+
+		InHeader.StringTableOffset = static_cast<uint64>(Archive->Tell());
+		TArray<uint32> offsets;
+		TArray<UTF8CHAR> bytes;
+		offsets.Reserve(InStrings.Num() + 1);
+		for(const FString& string : InStrings) {
+			offsets.Add(bytes.Num());
+			const FTCHARToUTF8 utf8(*string, string.Len());
+			bytes.Append(reinterpret_cast<const UTF8CHAR*>(utf8.Get()), utf8.Length());
+		}
+		offsets.Add(bytes.Num());
+
+		FAudioProfilerCaptureStringTable stringTable;
+		stringTable.NumStrings = InStrings.Num();
+		WriteColumn(&stringTable, sizeof(stringTable));
+		WriteColumn(offsets.GetData(), offsets.NumBytes());
+		WriteColumn(bytes.GetData(), bytes.NumBytes());
+
+		// Chunks written by a failed task are missing, the header must not claim them
+		InHeader.NumChunks = ChunkOffsets.Num();
+		Archive->Seek(0);
+		Archive->Serialize(&InHeader, sizeof(InHeader));
+
+		const bool bSucceeded = !bHasFailed && !Archive->IsError() && Archive->Close();
+		Archive.Reset();
+		return bSucceeded;
+	}
+
+	void FAudioProfilerCaptureWriter::WriteColumn(const void* InData, const int64 InSize) {
+		if(InSize > 0) Archive->Serialize(const_cast<void*>(InData), InSize);
+		const int64 padding = static_cast<int64>(AlignSection(InSize)) - InSize;
+		if(padding > 0) Archive->Serialize(const_cast<uint8*>(Padding), padding);
+	}
+}
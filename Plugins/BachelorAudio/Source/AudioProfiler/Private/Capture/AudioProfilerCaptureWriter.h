@@ -0,0 +1,258 @@
+﻿/**
+ * @file AudioProfilerCaptureWriter.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Capture/AudioProfilerCaptureFormat.h"
+#include "NodeRenderStats.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+
+class USoundBase;
+struct FAudioProfilerHeaderModel;
+
+namespace BachelorAudio::AudioProfiler {
+	struct FAudioProfilerSampleRecord;
+	class FAudioProfilerBookmarkQueue;
+
+	/**
+	 * @class FAudioProfilerCaptureWriter
+	 * @brief Writes sampled records into a binary capture file, see AudioProfilerCaptureFormat.h
+	 * @details The game thread only encodes records into the columns of the current chunk and
+	 * interns names. Full chunks are written by background tasks, each waiting for the previous
+	 * one, so the file is never touched by two threads at once.
+	 * Written chunks go back to a pool and keep their memory, so after the first chunks
+	 * adding records and sounds no longer allocates.
+	 * Tasks keep the writer alive, the owner may drop it right after Finalize.
+	 */
+	class FAudioProfilerCaptureWriter final : public TSharedFromThis<FAudioProfilerCaptureWriter, ESPMode::ThreadSafe> {
+	public:
+		/**
+		 * Called on the writer task once the capture file is closed.
+		 * @param bSucceeded Whether the file was written completely.
+		 */
+		using FOnFinalized = TUniqueFunction<void(bool bSucceeded)>;
+
+		/**
+		 * @param InFilePath Path of the capture file, replaced if it exists.
+		 * @param InHeader Session information stored in the capture header.
+		 * @param InInterval Capture interval in seconds.
+		 * @param bInCaptureNodeCosts Whether node cost columns are written, reads the current totals as baseline.
+		 * @param InExpectedRecords Expected number of records of the session, sizes the first chunk.
+		 */
+		FAudioProfilerCaptureWriter(
+			const FString& InFilePath,
+			const FAudioProfilerHeaderModel& InHeader,
+			const double InInterval,
+			const bool bInCaptureNodeCosts,
+			const uint32 InExpectedRecords = Capture::RecordsPerChunk
+			);
+
+		FAudioProfilerCaptureWriter(const FAudioProfilerCaptureWriter&) = delete;
+		FAudioProfilerCaptureWriter& operator=(const FAudioProfilerCaptureWriter&) = delete;
+
+		/**
+		 * Replaces the node cost baseline, the next record stores its costs relative to this one.
+		 * Used to write records sampled before the writer was created. Game thread only.
+		 * @param InRecord Record preceding the first added one, ignored without node totals.
+		 */
+		void SetBaseline(const FAudioProfilerSampleRecord& InRecord);
+
+		/**
+		 * Adds a record. Game thread only.
+		 * @param Record Record taken by the sampler thread.
+		 */
+		void Add(const FAudioProfilerSampleRecord& Record);
+
+		/**
+		 * Adds an active sound to the last added record. Game thread only.
+		 * @param InName Name of the sound.
+		 * @param InVolume Volume of the active sound.
+		 */
+		void AddSound(const FString& InName, const float InVolume);
+
+		/**
+		 * Adds an active sound to the last added record. Game thread only.
+		 * The name is read once per sound and session, later records only look up the object.
+		 * @param InSound The sound, ignored if null.
+		 * @param InVolume Volume of the active sound.
+		 */
+		void AddSound(const USoundBase* InSound, const float InVolume);
+
+		/**
+		 * Adds a bookmark to the last added record. Game thread only.
+		 * @param InName Name of the bookmark.
+		 * @param InTime Platform time the bookmark was added at.
+		 */
+		void AddBookmark(const FString& InName, const double InTime);
+
+		/**
+		 * Adds a bookmark to the last added record. Game thread only.
+		 * The name is read from the queue once per name and session, later bookmarks only look up the id.
+		 * @param InBookmarks Queue the name was interned in.
+		 * @param InNameId Id of the name in the queue.
+		 * @param InTime Platform time the bookmark was added at.
+		 */
+		void AddBookmark(const FAudioProfilerBookmarkQueue& InBookmarks, const uint32 InNameId, const double InTime);
+
+		/**
+		 * Writes the last chunk and the tables in the background. Game thread only, nothing may be added afterwards.
+		 * @param InOnFinalized Called on the writer task when the file is closed.
+		 */
+		void Finalize(FOnFinalized&& InOnFinalized);
+
+		/** @return Number of added records */
+		uint32 GetNumRecords() const { return Header.NumRecords; }
+
+		/** @return Path of the capture file */
+		const FString& GetFilePath() const { return FilePath; }
+
+	private:
+		/** Number of node classes with cost columns */
+		static constexpr int32 MaxNodeClasses = static_cast<int32>(BachelorMetasound::ENodeRenderClass::Num);
+
+		/**
+		 * @struct FChunk
+		 * @brief Columns of the records of one chunk
+		 */
+		struct FChunk {
+			uint64 FirstTimestampMicroseconds = 0;
+			TArray<uint32> TimestampDeltas;
+			TArray<float> FloatColumns[Capture::NumFloatColumns];
+			TArray<int32> IntColumns[Capture::NumIntColumns];
+			TArray<uint64> CyclesDeltas[MaxNodeClasses];
+			TArray<uint32> NumExecutesDeltas[MaxNodeClasses];
+			TArray<uint32> NumSamplesDeltas[MaxNodeClasses];
+			TArray<uint32> SoundBegin;
+
+			/** (name id, volume) spans of all records, a bump arena that keeps its memory when the chunk is recycled */
+			TArray<Capture::FAudioProfilerCaptureSound> Sounds;
+			TArray<uint32> BookmarkBegin;
+			TArray<Capture::FAudioProfilerCaptureBookmark> Bookmarks;
+
+			/**
+			 * Reserves every column for a full chunk.
+			 * @param InNumNodeClasses Number of node classes with cost columns.
+			 * @param InNumSounds Number of sound entries to reserve.
+			 */
+			void Reserve(const int32 InNumNodeClasses, const int32 InNumSounds);
+
+			/** Empties every column and keeps the memory */
+			void Reset();
+
+			/** @return Number of records in the chunk */
+			int32 Num() const { return TimestampDeltas.Num(); }
+		};
+
+		/**
+		 * Returns the id of a string, adds it to the string table if new.
+		 * @param InString String to intern.
+		 * @return Id of the string.
+		 */
+		uint32 Intern(const FString& InString);
+
+		/** Hands the current chunk to a task and starts a new one */
+		void FlushChunk();
+
+		/** @return A recycled chunk, a new reserved one if the pool is empty */
+		TUniquePtr<FChunk> AcquireChunk();
+
+		/**
+		 * Empties a written chunk and returns it to the pool. Runs on writer tasks.
+		 * @param InChunk The written chunk.
+		 */
+		void ReleaseChunk(TUniquePtr<FChunk>&& InChunk);
+
+		/**
+		 * Launches a task after the last one.
+		 * @param InTask Work of the task.
+		 */
+		void Launch(TUniqueFunction<void()>&& InTask);
+
+		/** Opens the file and writes a placeholder header, runs in the first task */
+		bool Open();
+
+		/**
+		 * Writes the columns of a chunk.
+		 * @param InChunk Chunk to write.
+		 */
+		void WriteChunk(const FChunk& InChunk);
+
+		/**
+		 * Writes the tables and the final header and closes the file.
+		 * @param InHeader Final header.
+		 * @param InStrings All interned strings.
+		 * @param InNodeClassIds String ids of the node classes.
+		 * @return Whether the file was written completely.
+		 */
+		bool WriteTables(
+			Capture::FAudioProfilerCaptureHeader InHeader,
+			const TArray<FString>& InStrings,
+			const TArray<uint32>& InNodeClassIds
+			);
+
+		/**
+		 * Appends a column and pads it to the section alignment.
+		 * @param InData First byte of the column.
+		 * @param InSize Size of the column in bytes.
+		 */
+		void WriteColumn(const void* InData, const int64 InSize);
+
+		/** Path of the capture file */
+		FString FilePath;
+
+		/** Header of the capture, counts are updated by the game thread */
+		Capture::FAudioProfilerCaptureHeader Header;
+
+		/** Chunk the game thread currently fills */
+		TUniquePtr<FChunk> Chunk;
+
+		/** Written chunks ready to be filled again */
+		TArray<TUniquePtr<FChunk>> FreeChunks;
+
+		/** Guards FreeChunks, tasks return chunks while the game thread takes them */
+		FCriticalSection FreeChunksLock;
+
+		/** Sound entries a new chunk reserves */
+		int32 NumSoundsPerChunk = 0;
+
+		/** Interned strings in id order, game thread only */
+		TArray<FString> Strings;
+
+		/** Ids of the interned strings, game thread only */
+		TMap<FString, uint32> StringIds;
+
+		/** Name ids of the sounds added so far, game thread only */
+		TMap<FObjectKey, uint32> SoundNameIds;
+
+		/** Name ids of the bookmark queue names added so far, game thread only */
+		TMap<uint32, uint32> BookmarkNameIds;
+
+		/** String ids of the node classes */
+		TArray<uint32> NodeClassIds;
+
+		/** Node cost totals of the last record, the next record stores the difference */
+		BachelorMetasound::FNodeRenderStatsSnapshot NodeTotals[MaxNodeClasses];
+
+		/** Microseconds of the last record since the first one */
+		uint64 LastTimestampMicroseconds = 0;
+
+		/** Int metrics of the last record */
+		int32 LastIntValues[Capture::NumIntColumns] = {};
+
+		/** Open capture file, only used by writer tasks */
+		TUniquePtr<FArchive> Archive;
+
+		/** File offsets of the written chunks, only used by writer tasks */
+		TArray<uint64> ChunkOffsets;
+
+		/** Whether opening or writing failed, only used by writer tasks */
+		bool bHasFailed = false;
+
+		/** Last launched task, the next one waits for it. Game thread only. */
+		UE::Tasks::FTask LastTask;
+	};
+}
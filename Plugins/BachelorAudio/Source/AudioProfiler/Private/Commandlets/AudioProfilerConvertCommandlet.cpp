@@ -0,0 +1,48 @@
+﻿/**
+ * @file AudioProfilerConvertCommandlet.cpp
+ * @author Markus Schramm
+ */
+
+#include "Commandlets/AudioProfilerConvertCommandlet.h"
+
+#include "AudioProfilerModule.h"
+#include "Capture/AudioProfilerCaptureConverter.h"
+#include "Misc/Paths.h"
+
+UAudioProfilerConvertCommandlet::UAudioProfilerConvertCommandlet() {
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UAudioProfilerConvertCommandlet::Main(const FString& Params) {
+	FString capturePath;
+	if(!FParse::Value(*Params, TEXT("Capture="), capturePath)) {
+		UE_LOG(LogAudioProfiler, Error, TEXT("Usage: -run=AudioProfilerConvert -Capture=<file.apcap> [-Output=<directory>]"));
+		return 1;
+	}
+	capturePath = FPaths::ConvertRelativePathToFull(capturePath);
+
+	FString outputDir;
+	if(!FParse::Value(*Params, TEXT("Output="), outputDir)) outputDir = FPaths::GetPath(capturePath);
+	IFileManager::Get().MakeDirectory(*outputDir, true);
+
+	const FString baseName = FPaths::Combine(outputDir, FPaths::GetBaseFilename(capturePath));
+	const FString csvFilePath = baseName + TEXT(".csv");
+	const FString mdFilePath = baseName + TEXT(".md");
+
+	const bool bSucceeded = BachelorAudio::AudioProfiler::FAudioProfilerCaptureConverter::Convert(
+		capturePath,
+		csvFilePath,
+		mdFilePath
+		);
+	if(!bSucceeded) {
+		UE_LOG(LogAudioProfiler, Error, TEXT("Conversion of %s failed"), *capturePath);
+		return 1;
+	}
+
+	UE_LOG(LogAudioProfiler, Display, TEXT("Data written to %s"), *csvFilePath);
+	UE_LOG(LogAudioProfiler, Display, TEXT("Report written to %s"), *mdFilePath);
+	return 0;
+}
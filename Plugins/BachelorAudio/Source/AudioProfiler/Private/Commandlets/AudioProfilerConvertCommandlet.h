@@ -0,0 +1,36 @@
+﻿/**
+ * @file AudioProfilerConvertCommandlet.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AudioProfilerConvertCommandlet.generated.h"
+
+/**
+ * @class UAudioProfilerConvertCommandlet
+ * @brief Converts binary audio profiler captures into the CSV and Markdown report
+ * @details Usage, e.g. on a build box after a profiling run:
+ * UnrealEditor-Cmd prototype.uproject -run=AudioProfilerConvert -Capture=Saved/Profiling/Session.apcap
+ * [-Output=Saved/Profiling/Reports] -nullrhi -nosound -unattended
+ * The reports are written next to the capture, or to the output directory, with the name of the capture.
+ */
+UCLASS()
+class UAudioProfilerConvertCommandlet : public UCommandlet {
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Default constructor.
+	 */
+	UAudioProfilerConvertCommandlet();
+
+	/**
+	 * Converts the capture given on the command line.
+	 * @param Params Command line of the commandlet.
+	 * @return 0 if both reports were written, 1 otherwise.
+	 */
+	virtual int32 Main(const FString& Params) override;
+};
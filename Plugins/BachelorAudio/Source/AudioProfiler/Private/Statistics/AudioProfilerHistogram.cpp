@@ -0,0 +1,61 @@
+﻿/**
+ * @file AudioProfilerHistogram.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerHistogram.h"
+
+namespace BachelorAudio::AudioProfiler {
+	FAudioProfilerHistogram::FAudioProfilerHistogram() {
+		Counts.SetNumZeroed(NumBuckets);
+	}
+
+	void FAudioProfilerHistogram::Record(const double InValue) {
+		const double value = FMath::Max(InValue, 0.0);
+		const uint64 storedValue = static_cast<uint64>(FMath::Min(value, MaxValue) * ValueScale);
+		++Counts[GetBucketIndex(FMath::Min(storedValue, MaxStoredValue))];
+		Max = FMath::Max(Max, value);
+		++NumValues;
+	}
+
+	void FAudioProfilerHistogram::Merge(const FAudioProfilerHistogram& InOther) {
+		if(InOther.NumValues == 0) return;
+		for(int32 i = 0; i < NumBuckets; ++i) Counts[i] += InOther.Counts[i];
+		Max = FMath::Max(Max, InOther.Max);
+		NumValues += InOther.NumValues;
+	}
+
+	void FAudioProfilerHistogram::Reset() {
+		FMemory::Memzero(Counts.GetData(), Counts.NumBytes());
+		NumValues = 0;
+		Max = 0.0;
+	}
+
+	double FAudioProfilerHistogram::GetPercentile(const double InQuantile) const {
+		if(NumValues == 0) return 0.0;
+
+		// Nearest rank, the first bucket whose running count reaches it holds the percentile
+		const uint64 rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(FMath::Clamp(InQuantile, 0.0, 1.0) * NumValues)));
+		uint64 count = 0;
+		for(int32 i = 0; i < NumBuckets; ++i) {
+			count += Counts[i];
+			if(count >= rank) return FMath::Min(GetHighestValue(i) / ValueScale, Max);
+		}
+		return Max;
+	}
+
+	int32 FAudioProfilerHistogram::GetBucketIndex(const uint64 InValue) {
+		// Below 2^SubBucketBits every value has its own bucket
+		if(InValue < static_cast<uint64>(2 * HalfSubBucketCount)) return static_cast<int32>(InValue);
+		const int32 exponent = static_cast<int32>(FMath::FloorLog2_64(InValue)) - (SubBucketBits - 1);
+		const int64 subBucket = static_cast<int64>(InValue >> exponent);
+		return static_cast<int32>(exponent * HalfSubBucketCount + subBucket);
+	}
+
+	uint64 FAudioProfilerHistogram::GetHighestValue(const int32 InIndex) {
+		if(InIndex < 2 * HalfSubBucketCount) return static_cast<uint64>(InIndex);
+		const int32 exponent = static_cast<int32>(InIndex / HalfSubBucketCount) - 1;
+		const uint64 subBucket = static_cast<uint64>(InIndex - exponent * HalfSubBucketCount);
+		return ((subBucket + 1) << exponent) - 1;
+	}
+}
@@ -0,0 +1,94 @@
+﻿/**
+ * @file AudioProfilerHistogram.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @class FAudioProfilerHistogram
+	 * @brief Histogram with a fixed relative error for percentiles of long sessions
+	 * @details Log-linear buckets like an HDR histogram: every power of two is split into
+	 * SubBucketCount / 2 linear buckets, so a percentile is off by less than 1 / 128 of its
+	 * value. The bucket array is allocated once, memory does not grow with the number of values.
+	 * Values are stored with a resolution of 1 / ValueScale and clamped to [0, MaxValue].
+	 */
+	class FAudioProfilerHistogram {
+	public:
+		/** Values per unit, the resolution of small values */
+		static constexpr double ValueScale = 1000.0;
+
+		/** Largest value that keeps its relative error, larger values count into the last bucket */
+		static constexpr double MaxValue = static_cast<double>((1ll << 40) - 1) / ValueScale;
+
+		FAudioProfilerHistogram();
+
+		/**
+		 * Counts a value.
+		 * @param InValue Value in the unit of the metric, negative values count as zero.
+		 */
+		void Record(const double InValue);
+
+		/**
+		 * Adds the values of another histogram.
+		 * @param InOther Histogram to add.
+		 */
+		void Merge(const FAudioProfilerHistogram& InOther);
+
+		/** Removes every value and keeps the buckets */
+		void Reset();
+
+		/**
+		 * Returns the value below or at which the given share of values lies.
+		 * @param InQuantile Share between 0 and 1, e.g. 0.99 for p99.
+		 * @return Highest value of the bucket holding the quantile, never above GetMax. Zero without values.
+		 */
+		double GetPercentile(const double InQuantile) const;
+
+		/** @return Largest recorded value, exact */
+		double GetMax() const { return NumValues > 0 ? Max : 0.0; }
+
+		/** @return Number of recorded values */
+		uint64 GetNumValues() const { return NumValues; }
+
+	private:
+		/** Linear buckets of the first power of two, as bits */
+		static constexpr int32 SubBucketBits = 8;
+
+		/** Linear buckets of every further power of two */
+		static constexpr int64 HalfSubBucketCount = 1ll << (SubBucketBits - 1);
+
+		/** Bits of the largest stored value */
+		static constexpr int32 MaxValueBits = 40;
+
+		/** Largest stored value */
+		static constexpr uint64 MaxStoredValue = (1ull << MaxValueBits) - 1;
+
+		/** Number of buckets covering [0, 2^MaxValueBits) */
+		static constexpr int32 NumBuckets = static_cast<int32>((MaxValueBits - SubBucketBits + 2) * HalfSubBucketCount);
+
+		/**
+		 * @param InValue Stored value.
+		 * @return Index of the bucket counting the value.
+		 */
+		static int32 GetBucketIndex(const uint64 InValue);
+
+		/**
+		 * @param InIndex Bucket index.
+		 * @return Largest stored value the bucket counts.
+		 */
+		static uint64 GetHighestValue(const int32 InIndex);
+
+		/** Number of values per bucket */
+		TArray<uint64> Counts;
+
+		/** Number of recorded values */
+		uint64 NumValues = 0;
+
+		/** Largest recorded value */
+		double Max = 0.0;
+	};
+}
@@ -0,0 +1,71 @@
+﻿/**
+ * @file AudioProfilerStatistics.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerStatistics.h"
+
+namespace BachelorAudio::AudioProfiler {
+	const TCHAR* LexToString(const EAudioProfilerStatistic InStatistic) {
+		switch(InStatistic) {
+		case EAudioProfilerStatistic::AudioDelta: return TEXT("Audio Delta (ms)");
+		case EAudioProfilerStatistic::FrameDelta: return TEXT("Frame Delta (ms)");
+		case EAudioProfilerStatistic::CPUUsage: return TEXT("CPU Usage (%)");
+		case EAudioProfilerStatistic::MemoryUsage: return TEXT("Memory Usage (MB)");
+		case EAudioProfilerStatistic::CallbackPeriod: return TEXT("Callback Period Max (ms)");
+		case EAudioProfilerStatistic::NodeRenderTime: return TEXT("Node Render Time (ms)");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	void FAudioProfilerStatistics::Add(const TArray<FAudioProfilerTimestampModel>& InTimestamps) {
+		for(const FAudioProfilerTimestampModel& timestamp : InTimestamps) Add(timestamp);
+	}
+
+	void FAudioProfilerStatistics::Add(const FAudioProfilerTimestampModel& InTimestamp) {
+		auto record = [this](const EAudioProfilerStatistic InStatistic, const double InValue) {
+			Histograms[static_cast<int32>(InStatistic)].Record(InValue);
+		};
+
+		record(EAudioProfilerStatistic::AudioDelta, InTimestamp.CurrentAudioDelta * 1000.0);
+		record(EAudioProfilerStatistic::FrameDelta, InTimestamp.CurrentDelta * 1000.0);
+		record(EAudioProfilerStatistic::CPUUsage, InTimestamp.CPUUsage);
+		record(EAudioProfilerStatistic::MemoryUsage, InTimestamp.MemoryUsageMB);
+		if(InTimestamp.CallbackCount > 0) {
+			record(EAudioProfilerStatistic::CallbackPeriod, InTimestamp.CallbackPeriodMaxMs);
+		}
+		if(InTimestamp.NodeCosts.Num() > 0) {
+			double renderTimeMs = 0.0;
+			for(const auto& nodeCost : InTimestamp.NodeCosts) renderTimeMs += nodeCost.RenderTimeMs;
+			record(EAudioProfilerStatistic::NodeRenderTime, renderTimeMs);
+		}
+	}
+
+	const FAudioProfilerHistogram& FAudioProfilerStatistics::Get(const EAudioProfilerStatistic InStatistic) const {
+		return Histograms[static_cast<int32>(InStatistic)];
+	}
+
+	FString FAudioProfilerStatistics::BuildMDSummary() const {
+		TStringBuilder<2048> md;
+		for(int32 i = 0; i < static_cast<int32>(EAudioProfilerStatistic::Num); ++i) {
+			const FAudioProfilerHistogram& histogram = Histograms[i];
+			if(histogram.GetNumValues() == 0) continue;
+
+			if(md.Len() == 0) {
+				md.Append(TEXT("\n## Summary\n"));
+				md.Append(TEXT("| Metric | p50 | p90 | p99 | p99.9 | Max | Samples |\n"));
+				md.Append(TEXT("| --- | --- | --- | --- | --- | --- | --- |\n"));
+			}
+			md.Appendf(TEXT("| %s | %f | %f | %f | %f | %f | %llu |\n"),
+				LexToString(static_cast<EAudioProfilerStatistic>(i)),
+				histogram.GetPercentile(0.5),
+				histogram.GetPercentile(0.9),
+				histogram.GetPercentile(0.99),
+				histogram.GetPercentile(0.999),
+				histogram.GetMax(),
+				histogram.GetNumValues()
+				);
+		}
+		return FString(md.ToView());
+	}
+}
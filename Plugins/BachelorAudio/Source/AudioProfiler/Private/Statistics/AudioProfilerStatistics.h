@@ -0,0 +1,83 @@
+﻿/**
+ * @file AudioProfilerStatistics.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioProfilerHistogram.h"
+#include "Models/AudioProfilerTimestampModel.h"
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @enum EAudioProfilerStatistic
+	 * @brief Metrics summarized over a whole session
+	 */
+	enum class EAudioProfilerStatistic : uint8 {
+		/** Audio device delta time in ms */
+		AudioDelta,
+
+		/** Game frame delta time in ms */
+		FrameDelta,
+
+		/** Process CPU usage in percent */
+		CPUUsage,
+
+		/** Used physical memory in MB */
+		MemoryUsage,
+
+		/** Longest time between two callbacks of the main submix of each interval in ms */
+		CallbackPeriod,
+
+		/** Render time of all MetaSound node classes of each interval in ms */
+		NodeRenderTime,
+
+		Num
+	};
+
+	/**
+	 * @brief Returns the display name of a statistic.
+	 * @param InStatistic The statistic.
+	 * @return Name with unit used in the report.
+	 */
+	const TCHAR* LexToString(const EAudioProfilerStatistic InStatistic);
+
+	/**
+	 * @class FAudioProfilerStatistics
+	 * @brief Streaming percentiles of the metrics of a session
+	 * @details Every metric is counted into a FAudioProfilerHistogram, so the summary of an
+	 * hour-long soak test takes as much memory as the one of a short session.
+	 */
+	class FAudioProfilerStatistics {
+	public:
+		/**
+		 * Counts the metrics of timestamps. Metrics a timestamp did not capture are skipped.
+		 * @param InTimestamps Timestamps to count.
+		 */
+		void Add(const TArray<FAudioProfilerTimestampModel>& InTimestamps);
+
+		/**
+		 * Counts the metrics of a timestamp. Metrics the timestamp did not capture are skipped.
+		 * @param InTimestamp Timestamp to count.
+		 */
+		void Add(const FAudioProfilerTimestampModel& InTimestamp);
+
+		/**
+		 * @param InStatistic The statistic.
+		 * @return Histogram of the statistic.
+		 */
+		const FAudioProfilerHistogram& Get(const EAudioProfilerStatistic InStatistic) const;
+
+		/**
+		 * Builds the summary table of the Markdown report.
+		 * Lists p50, p90, p99, p99.9 and max of every statistic with values.
+		 * @return Markdown section, empty if nothing was counted.
+		 */
+		FString BuildMDSummary() const;
+
+	private:
+		/** One histogram per statistic */
+		FAudioProfilerHistogram Histograms[static_cast<int32>(EAudioProfilerStatistic::Num)];
+	};
+}
@@ -0,0 +1,74 @@
+﻿/**
+ * @file AudioProfilerAudioRing.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerAudioRing.h"
+
+#include "Audio.h"
+#include "Misc/FileHelper.h"
+
+namespace BachelorAudio::AudioProfiler {
+	FAudioProfilerAudioRing::FAudioProfilerAudioRing(const float InSeconds, const int32 InSampleRate)
+	: NumFrames(static_cast<uint64>(FMath::Max(FMath::CeilToInt64(InSeconds * InSampleRate), 1ll))),
+	  SampleRate(InSampleRate) {
+		Samples.SetNumZeroed(static_cast<int64>(NumFrames) * NumChannels);
+	}
+
+	void FAudioProfilerAudioRing::OnNewSubmixBuffer(
+		const USoundSubmix* OwningSubmix,
+		float* AudioData,
+		int32 NumSamples,
+		int32 InNumChannels,
+		const int32 InSampleRate,
+		double AudioClock
+		) {
+		if(AudioData == nullptr || InNumChannels <= 0 || InSampleRate != SampleRate) return;
+
+		const uint64 firstFrame = NumWrittenFrames.load(std::memory_order_relaxed);
+		const int32 numFrames = NumSamples / InNumChannels;
+		const int32 rightChannel = InNumChannels > 1 ? 1 : 0;
+		for(int32 frame = 0; frame < numFrames; ++frame) {
+			float* target = &Samples[static_cast<int64>((firstFrame + frame) % NumFrames) * NumChannels];
+			const float* source = &AudioData[frame * InNumChannels];
+			target[0] = source[0];
+			target[1] = source[rightChannel];
+		}
+		NumWrittenFrames.store(firstFrame + numFrames, std::memory_order_release);
+		NumBufferFrames.store(numFrames, std::memory_order_relaxed);
+	}
+
+	void FAudioProfilerAudioRing::Snapshot(TArray<float>& OutSamples) const {
+		const uint64 endFrame = NumWrittenFrames.load(std::memory_order_acquire);
+		const uint64 beginFrame = endFrame > NumFrames ? endFrame - NumFrames : 0;
+
+		OutSamples.SetNumUninitialized(static_cast<int64>(endFrame - beginFrame) * NumChannels);
+		for(uint64 frame = beginFrame; frame < endFrame; ++frame) {
+			const float* source = &Samples[static_cast<int64>(frame % NumFrames) * NumChannels];
+			float* target = &OutSamples[static_cast<int64>(frame - beginFrame) * NumChannels];
+			target[0] = source[0];
+			target[1] = source[1];
+		}
+
+		// Frames the render thread published or is writing meanwhile replaced the oldest ones of the copy
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64 writingFrame = NumWrittenFrames.load(std::memory_order_relaxed) + NumBufferFrames.load(std::memory_order_relaxed);
+		const uint64 validFrame = writingFrame > NumFrames ? writingFrame - NumFrames : 0;
+		if(validFrame > beginFrame) {
+			const uint64 overwrittenFrames = FMath::Min(validFrame - beginFrame, endFrame - beginFrame);
+			OutSamples.RemoveAt(0, static_cast<int64>(overwrittenFrames) * NumChannels);
+		}
+	}
+
+	bool FAudioProfilerAudioRing::WriteWaveFile(const TArray<float>& InSamples, const int32 InSampleRate, const FString& InFilePath) {
+		TArray<int16> pcm;
+		pcm.SetNumUninitialized(InSamples.Num());
+		for(int32 i = 0; i < InSamples.Num(); ++i) {
+			pcm[i] = static_cast<int16>(FMath::Clamp(InSamples[i], -1.f, 1.f) * 32767.f);
+		}
+
+		TArray<uint8> wave;
+		SerializeWaveFile(wave, reinterpret_cast<const uint8*>(pcm.GetData()), pcm.NumBytes(), NumChannels, InSampleRate);
+		return FFileHelper::SaveArrayToFile(wave, *InFilePath);
+	}
+}
@@ -0,0 +1,81 @@
+﻿/**
+ * @file AudioProfilerAudioRing.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioDevice.h"
+#include <atomic>
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @class FAudioProfilerAudioRing
+	 * @brief Keeps the last seconds of the main submix output
+	 * @details Listens to the main submix and overwrites the oldest frames of a ring allocated
+	 * once, so it never allocates on the audio render thread. Only the front left and right
+	 * channels are kept, mono output is duplicated. Snapshots are taken from any thread without
+	 * stopping the render thread, frames it overwrote meanwhile are left out.
+	 */
+	class FAudioProfilerAudioRing final : public ISubmixBufferListener {
+	public:
+		/** Channels kept per frame */
+		static constexpr int32 NumChannels = 2;
+
+		/**
+		 * @param InSeconds Seconds of audio the ring keeps.
+		 * @param InSampleRate Sample rate of the device, the ring ignores buffers of another rate.
+		 */
+		FAudioProfilerAudioRing(const float InSeconds, const int32 InSampleRate);
+
+		FAudioProfilerAudioRing(const FAudioProfilerAudioRing&) = delete;
+		FAudioProfilerAudioRing& operator=(const FAudioProfilerAudioRing&) = delete;
+
+		//~ Begin ISubmixBufferListener
+		virtual void OnNewSubmixBuffer(
+			const USoundSubmix* OwningSubmix,
+			float* AudioData,
+			int32 NumSamples,
+			int32 InNumChannels,
+			const int32 InSampleRate,
+			double AudioClock
+			) override;
+		//~ End ISubmixBufferListener
+
+		/**
+		 * Copies the kept audio, oldest frame first.
+		 * @param OutSamples Receives interleaved stereo samples.
+		 */
+		void Snapshot(TArray<float>& OutSamples) const;
+
+		/**
+		 * Writes interleaved stereo samples as 16 bit wave file.
+		 * Any thread, does not touch the ring.
+		 * @param InSamples Samples of a snapshot.
+		 * @param InSampleRate Sample rate of the snapshot.
+		 * @param InFilePath Path of the wave file.
+		 * @return Whether the file was written.
+		 */
+		static bool WriteWaveFile(const TArray<float>& InSamples, const int32 InSampleRate, const FString& InFilePath);
+
+		/** @return Sample rate of the kept audio */
+		int32 GetSampleRate() const { return SampleRate; }
+
+	private:
+		/** Interleaved stereo frames, allocated once */
+		TArray<float> Samples;
+
+		/** Frames the ring holds */
+		uint64 NumFrames;
+
+		/** Sample rate of the kept audio */
+		int32 SampleRate;
+
+		/** Frames written since the ring was created, published after the frames */
+		std::atomic<uint64> NumWrittenFrames{0};
+
+		/** Frames of the last buffer, a snapshot leaves out as many frames the render thread may be writing */
+		std::atomic<uint64> NumBufferFrames{0};
+	};
+}
@@ -0,0 +1,85 @@
+﻿/**
+ * @file AudioProfilerBookmarkQueue.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerBookmarkQueue.h"
+
+namespace BachelorAudio::AudioProfiler {
+	FAudioProfilerBookmarkQueue::FAudioProfilerBookmarkQueue(const uint32 InCapacity) {
+		const uint32 numSlots = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+		Slots = MakeUnique<FSlot[]>(numSlots);
+		IndexMask = numSlots - 1;
+		for(uint32 i = 0; i < numSlots; ++i) {
+			Slots[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	uint32 FAudioProfilerBookmarkQueue::InternName(const FString& InName) {
+		{
+			FReadScopeLock readLock(NamesLock);
+			if(const uint32* nameId = NameIds.Find(InName)) return *nameId;
+		}
+
+		FWriteScopeLock writeLock(NamesLock);
+		// Another thread may have added the name between both locks
+		if(const uint32* nameId = NameIds.Find(InName)) return *nameId;
+		const uint32 nameId = static_cast<uint32>(Names.Add(InName));
+		NameIds.Add(InName, nameId);
+		return nameId;
+	}
+
+	FString FAudioProfilerBookmarkQueue::GetName(const uint32 InNameId) const {
+		FReadScopeLock readLock(NamesLock);
+		return Names.IsValidIndex(static_cast<int32>(InNameId)) ? Names[static_cast<int32>(InNameId)] : FString();
+	}
+
+	bool FAudioProfilerBookmarkQueue::Enqueue(const uint32 InNameId, const double InTime) {
+		uint64 position = EnqueuePos.load(std::memory_order_relaxed);
+		FSlot* slot;
+		for(;;) {
+			slot = &Slots[position & IndexMask];
+			const uint64 sequence = slot->Sequence.load(std::memory_order_acquire);
+			const int64 difference = static_cast<int64>(sequence - position);
+			if(difference == 0) {
+				// The slot is free for this position, claim it unless another producer was faster
+				if(EnqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+			} else if(difference < 0) {
+				// The slot still holds the bookmark of the previous round, the queue is full
+				NumDropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			} else {
+				position = EnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->Bookmark.NameId = InNameId;
+		slot->Bookmark.Time = InTime;
+		slot->Sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool FAudioProfilerBookmarkQueue::Peek(FAudioProfilerBookmark& OutBookmark) const {
+		const FSlot& slot = Slots[DequeuePos & IndexMask];
+		if(slot.Sequence.load(std::memory_order_acquire) != DequeuePos + 1) return false;
+		OutBookmark = slot.Bookmark;
+		return true;
+	}
+
+	bool FAudioProfilerBookmarkQueue::Dequeue(FAudioProfilerBookmark& OutBookmark) {
+		if(!Peek(OutBookmark)) return false;
+		// Hand the slot to the producer of the next round
+		Slots[DequeuePos & IndexMask].Sequence.store(DequeuePos + IndexMask + 1, std::memory_order_release);
+		++DequeuePos;
+		return true;
+	}
+
+	void FAudioProfilerBookmarkQueue::Empty() {
+		FAudioProfilerBookmark bookmark;
+		while(Dequeue(bookmark)) {}
+	}
+
+	int64 FAudioProfilerBookmarkQueue::GetNumDropped() const {
+		return NumDropped.load(std::memory_order_relaxed);
+	}
+}
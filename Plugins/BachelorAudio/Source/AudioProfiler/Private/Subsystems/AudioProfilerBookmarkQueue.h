@@ -0,0 +1,122 @@
+﻿/**
+ * @file AudioProfilerBookmarkQueue.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @struct FAudioProfilerBookmark
+	 * @brief A queued bookmark
+	 */
+	struct FAudioProfilerBookmark {
+		/** Id of the interned bookmark name */
+		uint32 NameId = 0;
+
+		/** Platform time the bookmark was added at in seconds */
+		double Time = 0.0;
+	};
+
+	/**
+	 * @class FAudioProfilerBookmarkQueue
+	 * @brief Bounded lock-free queue of bookmarks with many producers and one consumer
+	 * @details Any thread, including the audio render thread, may add bookmarks. Slots are
+	 * preallocated and names are interned once, so adding a known name neither locks
+	 * exclusively nor allocates. Only the game thread takes bookmarks out.
+	 * If the queue is full, new bookmarks are dropped and counted.
+	 */
+	class FAudioProfilerBookmarkQueue final {
+	public:
+		/**
+		 * @param InCapacity Minimum number of bookmarks the queue holds, rounded up to a power of two.
+		 */
+		explicit FAudioProfilerBookmarkQueue(const uint32 InCapacity);
+
+		FAudioProfilerBookmarkQueue(const FAudioProfilerBookmarkQueue&) = delete;
+		FAudioProfilerBookmarkQueue& operator=(const FAudioProfilerBookmarkQueue&) = delete;
+
+		/**
+		 * Returns the id of a name, adds it if new. Any thread.
+		 * Known names only take a shared lock, only new names allocate.
+		 * @param InName Bookmark name.
+		 * @return Id of the name.
+		 */
+		uint32 InternName(const FString& InName);
+
+		/**
+		 * Returns an interned name. Any thread.
+		 * @param InNameId Id returned by InternName.
+		 * @return Copy of the name, empty for unknown ids.
+		 */
+		FString GetName(const uint32 InNameId) const;
+
+		/**
+		 * Adds a bookmark, never locks or allocates. Any thread.
+		 * @param InNameId Id returned by InternName.
+		 * @param InTime Platform time of the bookmark in seconds.
+		 * @return False if the queue was full and the bookmark was dropped.
+		 */
+		bool Enqueue(const uint32 InNameId, const double InTime);
+
+		/**
+		 * Returns the oldest bookmark without taking it out. Consumer only.
+		 * @param OutBookmark Receives the bookmark.
+		 * @return False if the queue is empty.
+		 */
+		bool Peek(FAudioProfilerBookmark& OutBookmark) const;
+
+		/**
+		 * Takes the oldest bookmark out of the queue. Consumer only.
+		 * @param OutBookmark Receives the bookmark.
+		 * @return False if the queue is empty.
+		 */
+		bool Dequeue(FAudioProfilerBookmark& OutBookmark);
+
+		/** Takes every queued bookmark out of the queue. Consumer only. */
+		void Empty();
+
+		/** @return Number of bookmarks dropped because the queue was full */
+		int64 GetNumDropped() const;
+
+	private:
+		/**
+		 * @struct FSlot
+		 * @brief A bookmark and the turn it belongs to
+		 * @details Sequence equals the enqueue position the slot waits for while free and
+		 * that position plus one once the bookmark is written.
+		 */
+		struct FSlot {
+			std::atomic<uint64> Sequence{0};
+			FAudioProfilerBookmark Bookmark;
+		};
+
+		/** Preallocated slots */
+		TUniquePtr<FSlot[]> Slots;
+
+		/** Number of slots minus one */
+		uint64 IndexMask;
+
+		/** Next position producers claim */
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePos{0};
+
+		/** Next position the consumer reads */
+		alignas(PLATFORM_CACHE_LINE_SIZE) uint64 DequeuePos = 0;
+
+		/** Bookmarks dropped because the queue was full */
+		std::atomic<int64> NumDropped{0};
+
+		/** Guards the interned names */
+		mutable FRWLock NamesLock;
+
+		/** Interned names in id order */
+		TArray<FString> Names;
+
+		/** Ids of the interned names */
+		TMap<FString, uint32> NameIds;
+	};
+}
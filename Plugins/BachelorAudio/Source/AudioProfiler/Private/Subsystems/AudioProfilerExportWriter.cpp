@@ -0,0 +1,160 @@
+﻿/**
+ * @file AudioProfilerExportWriter.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerExportWriter.h"
+
+#include "AudioProfilerOutputAnalyzer.h"
+#include "HAL/FileManager.h"
+
+namespace BachelorAudio::AudioProfiler {
+	namespace {
+		/** Bytes copied at once from the Markdown part file into the report */
+		constexpr int64 ReportCopyChunkSize = 64 * 1024;
+	}
+
+	FAudioProfilerExportWriter::FAudioProfilerExportWriter(const FString& InCSVFilePath, const FString& InMDFilePath)
+	: CSVFilePath(InCSVFilePath),
+	  MDFilePath(InMDFilePath),
+	  MDPartFilePath(InMDFilePath + TEXT(".part")) {}
+
+	bool FAudioProfilerExportWriter::Open() {
+		if(bHasFailed) return false;
+		if(CSVArchive.IsValid()) return true;
+
+		CSVArchive.Reset(IFileManager::Get().CreateFileWriter(*CSVFilePath));
+		MDPartArchive.Reset(IFileManager::Get().CreateFileWriter(*MDPartFilePath));
+		bHasFailed = !CSVArchive.IsValid() || !MDPartArchive.IsValid();
+		return !bHasFailed;
+	}
+
+	void FAudioProfilerExportWriter::Append(const TArray<FAudioProfilerTimestampModel>& InTimestamps) {
+		if(InTimestamps.Num() == 0 || !Open()) return;
+
+		TStringBuilder<4096> csv;
+		TStringBuilder<4096> md;
+
+		// Node cost columns follow the node classes of the first record, every record holds all classes
+		if(!bHasCSVHeader) {
+			csv.Append(TEXT(
+				"Timestamp,AudioDeltaTime,AudioTime,DeltaTime,Framerate,CPUUsage,MemoryUsage,MasterVolume,Headroom,ActiveSoundCount,"
+				"CallbackPeriodP50Ms,CallbackPeriodP99Ms,CallbackPeriodMaxMs,BufferLengthMs,CallbackCount,LateCallbackCount,"
+				"OutputRmsDb,OutputTruePeakDb,OutputLoudnessLUFS"
+				));
+			for(int32 band = 0; band < InTimestamps[0].OutputSpectrumDb.Num() && band < NumSpectrumBands; ++band) {
+				csv.Appendf(TEXT(",Spectrum%dHzDb"), SpectrumBandEdgesHz[band]);
+			}
+			for(const auto& nodeCost : InTimestamps[0].NodeCosts) {
+				csv.Appendf(TEXT(",%sRenderTimeMs,%sNsPerSample"), *nodeCost.NodeClassName, *nodeCost.NodeClassName);
+			}
+			csv.Append(TEXT(",ActiveSoundNames\n"));
+
+			md.Append(TEXT("\n## Profiling Data\n"));
+			md.Append(TEXT("| Timestamp | AudioDeltaTime | AudioTime | DeltaTime | Framerate | CPUUsage | MemoryUsage | MasterVolume | Headroom | ActiveSoundCount | CallbackPeriodP99Ms | LateCallbacks | TruePeakDb | LoudnessLUFS | ActiveBookmarks |\n"));
+			md.Append(TEXT("| --- | --- | --- | --- | --- | --- | --- | --- | --- | --- | --- | --- | --- | --- | --- |\n"));
+			bHasCSVHeader = true;
+		}
+
+		for(const auto& timestamp : InTimestamps) {
+			csv.Appendf(TEXT("%f,%f,%f,%f,%f,%f,%f,%f,%f,%d,%f,%f,%f,%f,%d,%d,%f,%f,%f,"),
+				timestamp.Timestamp,
+				timestamp.CurrentAudioDelta,
+				timestamp.CurrentAudioTime,
+				timestamp.CurrentDelta,
+				timestamp.Framerate,
+				timestamp.CPUUsage,
+				timestamp.MemoryUsageMB,
+				timestamp.MasterVolumeLin,
+				timestamp.Headroom,
+				timestamp.ActiveSoundCount,
+				timestamp.CallbackPeriodP50Ms,
+				timestamp.CallbackPeriodP99Ms,
+				timestamp.CallbackPeriodMaxMs,
+				timestamp.BufferLengthMs,
+				timestamp.CallbackCount,
+				timestamp.LateCallbackCount,
+				timestamp.OutputRmsDb,
+				timestamp.OutputTruePeakDb,
+				timestamp.OutputLoudnessLUFS
+				);
+			for(const float bandDb : timestamp.OutputSpectrumDb) {
+				csv.Appendf(TEXT("%f,"), bandDb);
+			}
+			for(const auto& nodeCost : timestamp.NodeCosts) {
+				csv.Appendf(TEXT("%f,%f,"), nodeCost.RenderTimeMs, nodeCost.NanosecondsPerSample);
+			}
+			for(int32 i = 0; i < timestamp.ActiveSounds.Num(); ++i) {
+				if(i > 0) csv.AppendChar(TEXT(';'));
+				csv.Append(timestamp.ActiveSounds[i].ActiveSoundName);
+			}
+			csv.AppendChar(TEXT('\n'));
+
+			md.Appendf(TEXT("| %f | %f | %f | %f | %f | %f | %f | %f | %f | %d | %f | %d | %f | %f |"),
+				timestamp.Timestamp,
+				timestamp.CurrentAudioDelta,
+				timestamp.CurrentAudioTime,
+				timestamp.CurrentDelta,
+				timestamp.Framerate,
+				timestamp.CPUUsage,
+				timestamp.MemoryUsageMB,
+				timestamp.MasterVolumeLin,
+				timestamp.Headroom,
+				timestamp.ActiveSoundCount,
+				timestamp.CallbackPeriodP99Ms,
+				timestamp.LateCallbackCount,
+				timestamp.OutputTruePeakDb,
+				timestamp.OutputLoudnessLUFS
+				);
+			if(timestamp.ActiveBookmarks.Num() == 0) {
+				md.AppendChar(TEXT('\n'));
+				continue;
+			}
+			for(int32 i = 0; i < timestamp.ActiveBookmarks.Num(); ++i) {
+				if(i == 0) md.Appendf(TEXT(" %s |\n"), *timestamp.ActiveBookmarks[i]);
+				else md.Appendf(TEXT("|  |  |  |  |  |  |  |  |  |  |  |  |  |  | %s |\n"), *timestamp.ActiveBookmarks[i]);
+			}
+		}
+
+		WriteChunk(*CSVArchive, csv.ToView());
+		WriteChunk(*MDPartArchive, md.ToView());
+		bHasFailed = CSVArchive->IsError() || MDPartArchive->IsError();
+	}
+
+	bool FAudioProfilerExportWriter::Finalize(const FString& InMDHeader) {
+		IFileManager& fileManager = IFileManager::Get();
+
+		bool bSucceeded = !bHasFailed && CSVArchive.IsValid();
+		if(CSVArchive.IsValid()) bSucceeded &= CSVArchive->Close();
+		if(MDPartArchive.IsValid()) bSucceeded &= MDPartArchive->Close();
+		CSVArchive.Reset();
+		MDPartArchive.Reset();
+
+		const TUniquePtr<FArchive> report(fileManager.CreateFileWriter(*MDFilePath));
+		if(!report.IsValid()) return false;
+		WriteChunk(*report, InMDHeader);
+
+		if(const TUniquePtr<FArchive> part(fileManager.CreateFileReader(*MDPartFilePath)); part.IsValid()) {
+			TArray<uint8> buffer;
+			buffer.SetNumUninitialized(ReportCopyChunkSize);
+			const int64 size = part->TotalSize();
+			for(int64 offset = 0; offset < size; offset += ReportCopyChunkSize) {
+				const int64 count = FMath::Min(ReportCopyChunkSize, size - offset);
+				part->Serialize(buffer.GetData(), count);
+				report->Serialize(buffer.GetData(), count);
+			}
+			bSucceeded &= !part->IsError();
+		}
+		fileManager.Delete(*MDPartFilePath, false, false, true);
+
+		WriteChunk(*report, TEXT("\n"));
+		bSucceeded &= report->Close();
+		return bSucceeded;
+	}
+
+	void FAudioProfilerExportWriter::WriteChunk(FArchive& Archive, const FStringView InChunk) {
+		if(InChunk.IsEmpty()) return;
+		const FTCHARToUTF8 utf8(InChunk.GetData(), InChunk.Len());
+		Archive.Serialize(const_cast<ANSICHAR*>(utf8.Get()), utf8.Length());
+	}
+}
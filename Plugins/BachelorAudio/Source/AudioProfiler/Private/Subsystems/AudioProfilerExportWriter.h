@@ -0,0 +1,82 @@
+﻿/**
+ * @file AudioProfilerExportWriter.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/AudioProfilerTimestampModel.h"
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @class FAudioProfilerExportWriter
+	 * @brief Writes profiling records to the CSV and Markdown export in chunks
+	 * @details Every append is formatted with a string builder and written as one chunk per file,
+	 * so a long session never exists as one string. Markdown rows go to a part file first,
+	 * because the report header is only complete when all records are written.
+	 * Runs on the calling thread, the capture converter calls it from a background task.
+	 */
+	class FAudioProfilerExportWriter final {
+	public:
+		/**
+		 * @param InCSVFilePath Path of the CSV file, replaced if it exists.
+		 * @param InMDFilePath Path of the Markdown report, replaced if it exists.
+		 */
+		FAudioProfilerExportWriter(const FString& InCSVFilePath, const FString& InMDFilePath);
+
+		FAudioProfilerExportWriter(const FAudioProfilerExportWriter&) = delete;
+		FAudioProfilerExportWriter& operator=(const FAudioProfilerExportWriter&) = delete;
+
+		/**
+		 * Appends records to both files.
+		 * @param InTimestamps Records in capture order, the CSV columns follow the first record ever appended.
+		 */
+		void Append(const TArray<FAudioProfilerTimestampModel>& InTimestamps);
+
+		/**
+		 * Writes the report with its header and closes both files, nothing may be appended afterwards.
+		 * @param InMDHeader Header put in front of the Markdown rows.
+		 * @return Whether both files were written completely.
+		 */
+		bool Finalize(const FString& InMDHeader);
+
+		/** @return Path of the CSV file */
+		const FString& GetCSVFilePath() const { return CSVFilePath; }
+
+		/** @return Path of the Markdown report */
+		const FString& GetMDFilePath() const { return MDFilePath; }
+
+	private:
+		/** Opens both files with the first append */
+		bool Open();
+
+		/**
+		 * Converts a chunk to UTF-8 and appends it to a file.
+		 * @param Archive File to append to.
+		 * @param InChunk Formatted text.
+		 */
+		static void WriteChunk(FArchive& Archive, const FStringView InChunk);
+
+		/** Path of the CSV file */
+		FString CSVFilePath;
+
+		/** Path of the Markdown report */
+		FString MDFilePath;
+
+		/** Path of the Markdown rows written before the header is known */
+		FString MDPartFilePath;
+
+		/** Open CSV file */
+		TUniquePtr<FArchive> CSVArchive;
+
+		/** Open Markdown part file */
+		TUniquePtr<FArchive> MDPartArchive;
+
+		/** Whether the CSV column header was written */
+		bool bHasCSVHeader = false;
+
+		/** Whether opening or writing failed */
+		bool bHasFailed = false;
+	};
+}
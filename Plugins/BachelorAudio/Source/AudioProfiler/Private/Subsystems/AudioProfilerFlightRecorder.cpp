@@ -0,0 +1,96 @@
+﻿/**
+ * @file AudioProfilerFlightRecorder.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerFlightRecorder.h"
+
+#include "Capture/AudioProfilerCaptureWriter.h"
+
+namespace BachelorAudio::AudioProfiler {
+	const TCHAR* LexToString(const EAudioProfilerTrigger InTrigger) {
+		switch(InTrigger) {
+		case EAudioProfilerTrigger::LateCallback: return TEXT("LateCallback");
+		case EAudioProfilerTrigger::FrameSpike: return TEXT("FrameSpike");
+		case EAudioProfilerTrigger::HeadroomBreach: return TEXT("HeadroomBreach");
+		default: return TEXT("None");
+		}
+	}
+
+	FAudioProfilerFlightRecorder::FAudioProfilerFlightRecorder(const FAudioProfilerFlightRecorderSettings& InSettings)
+	: Settings(InSettings) {
+		const int32 numRecords = FMath::Max(
+			FMath::CeilToInt32(InSettings.WindowSeconds / FMath::Max(InSettings.IntervalSeconds, UE_KINDA_SMALL_NUMBER)),
+			1);
+		Records.SetNumZeroed(numRecords + 1);
+		Bookmarks.SetNumZeroed(FMath::Max(InSettings.BookmarkCapacity, 1));
+	}
+
+	EAudioProfilerTrigger FAudioProfilerFlightRecorder::Add(const FAudioProfilerSampleRecord& InRecord) {
+		if(NumRecords < Records.Num()) {
+			Records[(FirstRecord + NumRecords++) % Records.Num()] = InRecord;
+		} else {
+			Records[FirstRecord] = InRecord;
+			FirstRecord = (FirstRecord + 1) % Records.Num();
+		}
+
+		if(InRecord.Timestamp < RearmTime) return EAudioProfilerTrigger::None;
+		const EAudioProfilerTrigger trigger = Evaluate(InRecord);
+		if(trigger != EAudioProfilerTrigger::None) RearmTime = InRecord.Timestamp + Settings.WindowSeconds;
+		return trigger;
+	}
+
+	void FAudioProfilerFlightRecorder::AddBookmark(const FAudioProfilerBookmark& InBookmark) {
+		if(NumBookmarks < Bookmarks.Num()) {
+			Bookmarks[(FirstBookmark + NumBookmarks++) % Bookmarks.Num()] = InBookmark;
+		} else {
+			Bookmarks[FirstBookmark] = InBookmark;
+			FirstBookmark = (FirstBookmark + 1) % Bookmarks.Num();
+		}
+	}
+
+	int32 FAudioProfilerFlightRecorder::Dump(FAudioProfilerCaptureWriter& InWriter, const FAudioProfilerBookmarkQueue& InBookmarks) const {
+		if(NumRecords < 2) return 0;
+
+		InWriter.SetBaseline(GetRecord(0));
+		int32 bookmark = 0;
+		for(int32 i = 1; i < NumRecords; ++i) {
+			const FAudioProfilerSampleRecord& record = GetRecord(i);
+			InWriter.Add(record);
+
+			// Bookmarks before the baseline belong to no dumped record
+			const bool bIsLast = i == NumRecords - 1;
+			for(; bookmark < NumBookmarks; ++bookmark) {
+				const FAudioProfilerBookmark& entry = Bookmarks[(FirstBookmark + bookmark) % Bookmarks.Num()];
+				if(entry.Time > record.Timestamp && !bIsLast) break;
+				if(entry.Time > GetRecord(0).Timestamp) InWriter.AddBookmark(InBookmarks, entry.NameId, entry.Time);
+			}
+		}
+		return NumRecords - 1;
+	}
+
+	void FAudioProfilerFlightRecorder::Reset() {
+		FirstRecord = 0;
+		NumRecords = 0;
+		FirstBookmark = 0;
+		NumBookmarks = 0;
+		RearmTime = 0.0;
+	}
+
+	const FAudioProfilerSampleRecord& FAudioProfilerFlightRecorder::GetRecord(const int32 InIndex) const {
+		return Records[(FirstRecord + InIndex) % Records.Num()];
+	}
+
+	EAudioProfilerTrigger FAudioProfilerFlightRecorder::Evaluate(const FAudioProfilerSampleRecord& InRecord) const {
+		if(InRecord.bHasRenderTiming && Settings.bTriggerOnLateCallback && InRecord.RenderTiming.NumLateCallbacks > 0) {
+			return EAudioProfilerTrigger::LateCallback;
+		}
+		if(InRecord.bHasOutputAnalysis && InRecord.OutputAnalysis.TruePeakDb >= Settings.PeakThresholdDb) {
+			return EAudioProfilerTrigger::HeadroomBreach;
+		}
+		if(Settings.FrameSpikeThresholdMs > 0.f && InRecord.CurrentDelta * 1000.f >= Settings.FrameSpikeThresholdMs) {
+			return EAudioProfilerTrigger::FrameSpike;
+		}
+		return EAudioProfilerTrigger::None;
+	}
+}
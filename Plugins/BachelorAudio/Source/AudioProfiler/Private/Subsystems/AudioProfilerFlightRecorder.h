@@ -0,0 +1,145 @@
+﻿/**
+ * @file AudioProfilerFlightRecorder.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioProfilerBookmarkQueue.h"
+#include "AudioProfilerSampler.h"
+
+namespace BachelorAudio::AudioProfiler {
+	class FAudioProfilerCaptureWriter;
+
+	/**
+	 * @enum EAudioProfilerTrigger
+	 * @brief Reason a flight recorder dump was triggered by a record
+	 */
+	enum class EAudioProfilerTrigger : uint8 {
+		None,
+		LateCallback,
+		FrameSpike,
+		HeadroomBreach
+	};
+
+	/**
+	 * @param InTrigger Trigger to name.
+	 * @return Name of the trigger, used as dump reason.
+	 */
+	const TCHAR* LexToString(const EAudioProfilerTrigger InTrigger);
+
+	/**
+	 * @struct FAudioProfilerFlightRecorderSettings
+	 * @brief Window and triggers of a flight recorder
+	 */
+	struct FAudioProfilerFlightRecorderSettings {
+		/** Seconds of records the recorder keeps */
+		float WindowSeconds = 30.f;
+
+		/** Seconds between two records */
+		float IntervalSeconds = 0.1f;
+
+		/** Whether a record with late callbacks triggers a dump */
+		bool bTriggerOnLateCallback = true;
+
+		/** Game frame time in ms that triggers a dump, 0 disables the trigger */
+		float FrameSpikeThresholdMs = 0.f;
+
+		/** Output true peak in dBTP that triggers a dump */
+		float PeakThresholdDb = 0.f;
+
+		/** Bookmarks the recorder keeps */
+		int32 BookmarkCapacity = 256;
+	};
+
+	/**
+	 * @class FAudioProfilerFlightRecorder
+	 * @brief Keeps the records and bookmarks of the last seconds in fixed rings
+	 * @details The rings are allocated once, adding overwrites the oldest entries, so the
+	 * recorder may run for a whole game session. Every added record is checked against the
+	 * triggers. A trigger fires at most once per window, so consecutive dumps do not overlap.
+	 * Game thread only.
+	 */
+	class FAudioProfilerFlightRecorder final {
+	public:
+		/**
+		 * @param InSettings Window and triggers of the recorder.
+		 */
+		explicit FAudioProfilerFlightRecorder(const FAudioProfilerFlightRecorderSettings& InSettings);
+
+		FAudioProfilerFlightRecorder(const FAudioProfilerFlightRecorder&) = delete;
+		FAudioProfilerFlightRecorder& operator=(const FAudioProfilerFlightRecorder&) = delete;
+
+		/**
+		 * Adds a record, overwrites the oldest one if the window is full.
+		 * @param InRecord Record taken by the sampler thread.
+		 * @return The trigger the record fired, None if it fired none or the last trigger is within the window.
+		 */
+		EAudioProfilerTrigger Add(const FAudioProfilerSampleRecord& InRecord);
+
+		/**
+		 * Adds a bookmark, overwrites the oldest one if the ring is full.
+		 * @param InBookmark Bookmark taken out of the bookmark queue.
+		 */
+		void AddBookmark(const FAudioProfilerBookmark& InBookmark);
+
+		/**
+		 * Adds the kept records and bookmarks to a capture, oldest first.
+		 * The oldest record is the node cost baseline of the capture and is not added itself.
+		 * Each bookmark goes to the first record taken after it.
+		 * @param InWriter Writer of the dump, created without records.
+		 * @param InBookmarks Queue the bookmark names were interned in.
+		 * @return Number of added records.
+		 */
+		int32 Dump(FAudioProfilerCaptureWriter& InWriter, const FAudioProfilerBookmarkQueue& InBookmarks) const;
+
+		/** Forgets every record and bookmark and rearms the triggers, keeps the memory */
+		void Reset();
+
+		/** @return Number of kept records */
+		int32 Num() const { return NumRecords; }
+
+		/** @return Number of records the recorder keeps at most */
+		int32 GetCapacity() const { return Records.Num(); }
+
+		/**
+		 * Returns a kept record.
+		 * @param InIndex Index of the record, 0 is the oldest.
+		 * @return The record.
+		 */
+		const FAudioProfilerSampleRecord& GetRecord(const int32 InIndex) const;
+
+	private:
+		/**
+		 * Checks a record against the triggers.
+		 * @param InRecord Record to check.
+		 * @return The first trigger the record fires.
+		 */
+		EAudioProfilerTrigger Evaluate(const FAudioProfilerSampleRecord& InRecord) const;
+
+		/** Window and triggers */
+		FAudioProfilerFlightRecorderSettings Settings;
+
+		/** Ring of the kept records, one more than the window for the node cost baseline */
+		TArray<FAudioProfilerSampleRecord> Records;
+
+		/** Index of the oldest record */
+		int32 FirstRecord = 0;
+
+		/** Number of kept records */
+		int32 NumRecords = 0;
+
+		/** Ring of the kept bookmarks */
+		TArray<FAudioProfilerBookmark> Bookmarks;
+
+		/** Index of the oldest bookmark */
+		int32 FirstBookmark = 0;
+
+		/** Number of kept bookmarks */
+		int32 NumBookmarks = 0;
+
+		/** Platform time before which no trigger fires again */
+		double RearmTime = 0.0;
+	};
+}
@@ -0,0 +1,270 @@
+﻿/**
+ * @file AudioProfilerOutputAnalyzer.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerOutputAnalyzer.h"
+
+#include "DSP/FFTAlgorithm.h"
+
+namespace BachelorAudio::AudioProfiler {
+	namespace {
+		/** Number of 100 ms blocks of the short-term loudness window */
+		constexpr int32 NumLoudnessBlocks = 30;
+
+		/**
+		 * Returns the BS.1770 weight of a channel in the channel order of the audio mixer.
+		 * @param InChannel Index of the channel.
+		 * @param InNumChannels Channels of the buffer.
+		 * @return 0 for the LFE, 1.41 for surround channels, 1 otherwise.
+		 */
+		float GetChannelWeight(const int32 InChannel, const int32 InNumChannels) {
+			if(InNumChannels <= 3) return 1.f;
+			if(InNumChannels == 4) return InChannel < 2 ? 1.f : 1.41f;
+			if(InChannel == 3) return 0.f;
+			return InChannel < 3 ? 1.f : 1.41f;
+		}
+
+		/**
+		 * Converts a power to dB.
+		 * @param InPower Power, linear.
+		 * @return Level in dB, at least MinLevelDb.
+		 */
+		float PowerToDb(const double InPower) {
+			return InPower > 0.0 ? FMath::Max(static_cast<float>(10.0 * FMath::LogX(10.0, InPower)), MinLevelDb) : MinLevelDb;
+		}
+	}
+
+	FAudioProfilerOutputAnalyzer::FAudioProfilerOutputAnalyzer(const uint32 InCapacity)
+	// One slot of the ring always stays empty
+	: Slots(FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 1) + 1)) {
+		Audio::FFFTSettings settings;
+		settings.Log2Size = FFTSizeLog2;
+		settings.bArrays128BitAligned = false;
+		settings.bEnableHardwareAcceleration = true;
+		if(Audio::FFFTFactory::AreFFTSettingsSupported(settings)) FFT = Audio::FFFTFactory::NewFFTAlgorithm(settings);
+
+		Frames.SetNumZeroed(FFTSize);
+		Window.SetNumUninitialized(FFTSize);
+		double sumWindowSquares = 0.0;
+		for(int32 i = 0; i < FFTSize; ++i) {
+			Window[i] = 0.5f - 0.5f * FMath::Cos(2.f * PI * i / (FFTSize - 1));
+			sumWindowSquares += Window[i] * Window[i];
+		}
+		if(!FFT.IsValid()) return;
+
+		FFTInput.SetNumZeroed(FFT->NumInputFloats());
+		FFTOutput.SetNumZeroed(FFT->NumOutputFloats());
+
+		// One-sided power of a full scale sine sums to FFTSize * sumWindowSquares / 4 without scaling
+		double scale = 4.0 / (FFTSize * sumWindowSquares);
+		switch(FFT->ForwardScaling()) {
+		case Audio::EFFTScaling::MultipliedByFFTSize: scale /= static_cast<double>(FFTSize) * FFTSize; break;
+		case Audio::EFFTScaling::MultipliedBySqrtFFTSize: scale /= FFTSize; break;
+		case Audio::EFFTScaling::DividedByFFTSize: scale *= static_cast<double>(FFTSize) * FFTSize; break;
+		case Audio::EFFTScaling::DividedBySqrtFFTSize: scale *= FFTSize; break;
+		default: break;
+		}
+		PowerScale = static_cast<float>(scale);
+	}
+
+	// Defined here, where the FFT type is complete
+	FAudioProfilerOutputAnalyzer::~FAudioProfilerOutputAnalyzer() = default;
+
+	void FAudioProfilerOutputAnalyzer::OnNewSubmixBuffer(
+		const USoundSubmix* OwningSubmix,
+		float* AudioData,
+		int32 NumSamples,
+		int32 NumChannels,
+		const int32 InSampleRate,
+		double AudioClock
+		) {
+		if(AudioData == nullptr || NumChannels <= 0) return;
+		AddBuffer(AudioData, NumSamples / NumChannels, NumChannels, InSampleRate);
+	}
+
+	void FAudioProfilerOutputAnalyzer::AddBuffer(
+		const float* InAudioData,
+		const int32 InNumFrames,
+		const int32 InNumChannels,
+		const int32 InSampleRate
+		) {
+		if(InSampleRate <= 0 || InNumChannels <= 0) return;
+
+		// A gap between two sessions must not ring through the filters
+		if(bRestartRequested.exchange(false, std::memory_order_acquire) || InSampleRate != SampleRate) {
+			SetSampleRate(InSampleRate);
+			for(FChannelState& channel : Channels) channel = FChannelState();
+			NumBlockFrames = 0;
+			BlockPower = 0.0;
+			NextBlock = 0;
+			NumBlocks = 0;
+			WindowPower = 0.0;
+			NumFrames = 0;
+		}
+
+		FBufferAnalysis analysis;
+		const int32 numFilteredChannels = FMath::Min(InNumChannels, MaxChannels);
+		for(int32 frame = 0; frame < InNumFrames; ++frame) {
+			const float* samples = &InAudioData[frame * InNumChannels];
+			float mono = 0.f;
+			double framePower = 0.0;
+			for(int32 channel = 0; channel < InNumChannels; ++channel) {
+				const float sample = samples[channel];
+				analysis.SumSquares += sample * sample;
+				mono += sample;
+				if(channel >= numFilteredChannels) continue;
+
+				// Catmull-Rom through the last samples estimates the peaks between p1 and p2
+				FChannelState& state = Channels[channel];
+				const float p0 = state.History[0];
+				const float p1 = state.History[1];
+				const float p2 = state.History[2];
+				const float p3 = sample;
+				float peak = FMath::Abs(p3);
+				for(const float t : { 0.25f, 0.5f, 0.75f }) {
+					const float value = 0.5f * (2.f * p1
+						+ (p2 - p0) * t
+						+ (2.f * p0 - 5.f * p1 + 4.f * p2 - p3) * t * t
+						+ (3.f * (p1 - p2) + p3 - p0) * t * t * t);
+					peak = FMath::Max(peak, FMath::Abs(value));
+				}
+				analysis.TruePeakLin = FMath::Max(analysis.TruePeakLin, peak);
+				state.History[0] = p1;
+				state.History[1] = p2;
+				state.History[2] = p3;
+
+				// Both K-weighting stages in direct form II transposed
+				const float shelf = ShelfFilter.B0 * sample + state.Shelf[0];
+				state.Shelf[0] = ShelfFilter.B1 * sample - ShelfFilter.A1 * shelf + state.Shelf[1];
+				state.Shelf[1] = ShelfFilter.B2 * sample - ShelfFilter.A2 * shelf;
+				const float weighted = HighPassFilter.B0 * shelf + state.HighPass[0];
+				state.HighPass[0] = HighPassFilter.B1 * shelf - HighPassFilter.A1 * weighted + state.HighPass[1];
+				state.HighPass[1] = HighPassFilter.B2 * shelf - HighPassFilter.A2 * weighted;
+				framePower += GetChannelWeight(channel, InNumChannels) * weighted * weighted;
+			}
+
+			if(FFT.IsValid()) {
+				Frames[NumFrames++] = mono / InNumChannels;
+				if(NumFrames == FFTSize) {
+					AnalyzeSpectrum(analysis);
+					NumFrames = 0;
+				}
+			}
+
+			BlockPower += framePower;
+			if(++NumBlockFrames == BlockFrames) {
+				BlockPowers[NextBlock] = BlockPower / BlockFrames;
+				NextBlock = (NextBlock + 1) % NumLoudnessBlocks;
+				NumBlocks = FMath::Min(NumBlocks + 1, NumLoudnessBlocks);
+				// Summed again instead of updated, so rounding errors do not pile up over a long session
+				WindowPower = 0.0;
+				for(int32 block = 0; block < NumBlocks; ++block) WindowPower += BlockPowers[block];
+				NumBlockFrames = 0;
+				BlockPower = 0.0;
+			}
+		}
+
+		analysis.NumSamples = static_cast<int64>(InNumFrames) * InNumChannels;
+		analysis.ShortTermLufs = NumBlocks > 0 && WindowPower > 0.0
+			? FMath::Max(-0.691f + PowerToDb(WindowPower / NumBlocks), MinLevelDb)
+			: MinLevelDb;
+		if(!Slots.Enqueue(analysis)) NumDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool FAudioProfilerOutputAnalyzer::Summarize(FAudioProfilerOutputAnalysis& OutAnalysis) {
+		double sumSquares = 0.0;
+		int64 numSamples = 0;
+		float truePeakLin = 0.f;
+		float bandPower[NumSpectrumBands] = {};
+		int32 numSpectra = 0;
+		bool bHasBuffers = false;
+
+		OutAnalysis.ShortTermLufs = MinLevelDb;
+		FBufferAnalysis analysis;
+		while(Slots.Dequeue(analysis)) {
+			bHasBuffers = true;
+			sumSquares += analysis.SumSquares;
+			numSamples += analysis.NumSamples;
+			truePeakLin = FMath::Max(truePeakLin, analysis.TruePeakLin);
+			for(int32 band = 0; band < NumSpectrumBands; ++band) bandPower[band] += analysis.BandPower[band];
+			numSpectra += analysis.NumSpectra;
+			// The window already spans 3 seconds, the last value is the loudness at the end of the interval
+			OutAnalysis.ShortTermLufs = analysis.ShortTermLufs;
+		}
+
+		OutAnalysis.RmsDb = numSamples > 0 ? PowerToDb(sumSquares / numSamples) : MinLevelDb;
+		OutAnalysis.TruePeakDb = PowerToDb(static_cast<double>(truePeakLin) * truePeakLin);
+		for(int32 band = 0; band < NumSpectrumBands; ++band) {
+			OutAnalysis.SpectrumDb[band] = numSpectra > 0 ? PowerToDb(bandPower[band] / numSpectra) : MinLevelDb;
+		}
+		return bHasBuffers;
+	}
+
+	void FAudioProfilerOutputAnalyzer::Reset() {
+		FBufferAnalysis analysis;
+		while(Slots.Dequeue(analysis)) {}
+		NumDropped.store(0, std::memory_order_relaxed);
+		bRestartRequested.store(true, std::memory_order_release);
+	}
+
+	int64 FAudioProfilerOutputAnalyzer::GetNumDropped() const {
+		return NumDropped.load(std::memory_order_relaxed);
+	}
+
+	void FAudioProfilerOutputAnalyzer::SetSampleRate(const int32 InSampleRate) {
+		SampleRate = InSampleRate;
+		BlockFrames = FMath::Max(InSampleRate / 10, 1);
+
+		// K-weighting of ITU-R BS.1770 for any sample rate, first a high shelf then a high pass
+		{
+			constexpr double frequency = 1681.974450955533;
+			constexpr double gainDb = 3.999843853973347;
+			constexpr double q = 0.7071752369554196;
+			const double k = FMath::Tan(PI * frequency / InSampleRate);
+			const double vh = FMath::Pow(10.0, gainDb / 20.0);
+			const double vb = FMath::Pow(vh, 0.4996667741545416);
+			const double a0 = 1.0 + k / q + k * k;
+			ShelfFilter.B0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+			ShelfFilter.B1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+			ShelfFilter.B2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+			ShelfFilter.A1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+			ShelfFilter.A2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+		}
+		{
+			constexpr double frequency = 38.13547087602444;
+			constexpr double q = 0.5003270373238773;
+			const double k = FMath::Tan(PI * frequency / InSampleRate);
+			const double a0 = 1.0 + k / q + k * k;
+			HighPassFilter.B0 = 1.f;
+			HighPassFilter.B1 = -2.f;
+			HighPassFilter.B2 = 1.f;
+			HighPassFilter.A1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+			HighPassFilter.A2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+		}
+
+		const int32 numBins = FFTSize / 2 + 1;
+		for(int32 band = 0; band < NumSpectrumBands; ++band) {
+			const int32 bin = FMath::CeilToInt32(static_cast<double>(SpectrumBandEdgesHz[band]) * FFTSize / InSampleRate);
+			BandBins[band] = FMath::Clamp(bin, band > 0 ? BandBins[band - 1] : 1, numBins);
+		}
+		BandBins[NumSpectrumBands] = numBins;
+	}
+
+	void FAudioProfilerOutputAnalyzer::AnalyzeSpectrum(FBufferAnalysis& InOutAnalysis) {
+		for(int32 i = 0; i < FFTSize; ++i) FFTInput[i] = Frames[i] * Window[i];
+		FFT->ForwardRealToComplex(FFTInput.GetData(), FFTOutput.GetData());
+
+		// Output holds interleaved real and imaginary parts of the bins up to Nyquist
+		for(int32 band = 0; band < NumSpectrumBands; ++band) {
+			float power = 0.f;
+			for(int32 bin = BandBins[band]; bin < BandBins[band + 1]; ++bin) {
+				const float real = FFTOutput[2 * bin];
+				const float imaginary = FFTOutput[2 * bin + 1];
+				power += real * real + imaginary * imaginary;
+			}
+			InOutAnalysis.BandPower[band] += power * PowerScale;
+		}
+		++InOutAnalysis.NumSpectra;
+	}
+}
@@ -0,0 +1,229 @@
+﻿/**
+ * @file AudioProfilerOutputAnalyzer.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioDevice.h"
+#include "Containers/CircularQueue.h"
+#include <atomic>
+
+namespace Audio {
+	class IFFTAlgorithm;
+}
+
+namespace BachelorAudio::AudioProfiler {
+	/** Number of coarse spectrum bands */
+	constexpr int32 NumSpectrumBands = 8;
+
+	/** Lower edges of the spectrum bands in Hz, the last band reaches up to Nyquist */
+	constexpr int32 SpectrumBandEdgesHz[NumSpectrumBands] = { 20, 125, 250, 500, 1000, 2000, 4000, 8000 };
+
+	/** Level reported for silence in dB, keeps the exports free of infinities */
+	constexpr float MinLevelDb = -120.f;
+
+	/**
+	 * @struct FAudioProfilerOutputAnalysis
+	 * @brief Levels of the main submix output within one capture interval
+	 */
+	struct FAudioProfilerOutputAnalysis {
+		/** RMS level of all channels in dBFS */
+		float RmsDb;
+
+		/** Highest inter-sample peak of all channels in dBTP */
+		float TruePeakDb;
+
+		/** Short-term loudness over the last 3 seconds in LUFS */
+		float ShortTermLufs;
+
+		/** Mean level of every spectrum band in dBFS */
+		float SpectrumDb[NumSpectrumBands];
+	};
+
+	/**
+	 * @class FAudioProfilerOutputAnalyzer
+	 * @brief Measures level, true peak, loudness and a coarse spectrum of the main submix output
+	 * @details Listens to the main submix, so it runs on the audio render thread once per
+	 * rendered buffer. Filter states, the loudness window and the FFT are allocated once, a
+	 * buffer only runs arithmetic. Loudness follows the K-weighting and 3 second window of
+	 * ITU-R BS.1770, true peak is approximated by 4x cubic interpolation between samples.
+	 * Every buffer goes into a preallocated lock-free slot, which the sampler thread summarizes
+	 * once per capture interval, like the render timer.
+	 */
+	class FAudioProfilerOutputAnalyzer final : public ISubmixBufferListener {
+	public:
+		/** Channels with filter states, further channels are ignored */
+		static constexpr int32 MaxChannels = 8;
+
+		/** Log2 of the FFT size */
+		static constexpr int32 FFTSizeLog2 = 10;
+
+		/** Frames per FFT, consecutive FFTs do not overlap */
+		static constexpr int32 FFTSize = 1 << FFTSizeLog2;
+
+		/**
+		 * @param InCapacity Minimum number of buffers the slots hold, rounded up to a power of two.
+		 */
+		explicit FAudioProfilerOutputAnalyzer(const uint32 InCapacity);
+		virtual ~FAudioProfilerOutputAnalyzer() override;
+
+		FAudioProfilerOutputAnalyzer(const FAudioProfilerOutputAnalyzer&) = delete;
+		FAudioProfilerOutputAnalyzer& operator=(const FAudioProfilerOutputAnalyzer&) = delete;
+
+		//~ Begin ISubmixBufferListener
+		virtual void OnNewSubmixBuffer(
+			const USoundSubmix* OwningSubmix,
+			float* AudioData,
+			int32 NumSamples,
+			int32 NumChannels,
+			const int32 InSampleRate,
+			double AudioClock
+			) override;
+		//~ End ISubmixBufferListener
+
+		/**
+		 * Analyzes a rendered buffer. Render thread only.
+		 * @param InAudioData Interleaved samples of the buffer.
+		 * @param InNumFrames Frames of the buffer.
+		 * @param InNumChannels Channels of the buffer.
+		 * @param InSampleRate Sample rate of the buffer.
+		 */
+		void AddBuffer(const float* InAudioData, const int32 InNumFrames, const int32 InNumChannels, const int32 InSampleRate);
+
+		/**
+		 * Summarizes and removes every buffer analyzed since the last call. Sampler thread only.
+		 * @param OutAnalysis Receives the summary, silence if no buffer was rendered.
+		 * @return Whether any buffer was analyzed.
+		 */
+		bool Summarize(FAudioProfilerOutputAnalysis& OutAnalysis);
+
+		/**
+		 * Discards every analyzed buffer and clears the filters and the loudness window with the next buffer.
+		 * Call while no sampler thread summarizes, e.g. before a session starts.
+		 */
+		void Reset();
+
+		/** @return Number of buffers dropped because the slots were full */
+		int64 GetNumDropped() const;
+
+	private:
+		/**
+		 * @struct FBiquad
+		 * @brief Coefficients of a biquad filter, normalized to a0
+		 */
+		struct FBiquad {
+			float B0 = 1.f;
+			float B1 = 0.f;
+			float B2 = 0.f;
+			float A1 = 0.f;
+			float A2 = 0.f;
+		};
+
+		/**
+		 * @struct FChannelState
+		 * @brief Filter and interpolation history of one channel
+		 */
+		struct FChannelState {
+			/** Direct form II transposed states of both K-weighting stages */
+			float Shelf[2] = {};
+			float HighPass[2] = {};
+
+			/** Last three samples, oldest first, for the inter-sample peak */
+			float History[3] = {};
+		};
+
+		/**
+		 * @struct FBufferAnalysis
+		 * @brief Analysis of one rendered buffer
+		 */
+		struct FBufferAnalysis {
+			/** Sum of the squared samples of all channels */
+			double SumSquares = 0.0;
+
+			/** Number of summed samples */
+			int64 NumSamples = 0;
+
+			/** Highest inter-sample peak, linear */
+			float TruePeakLin = 0.f;
+
+			/** Short-term loudness at the end of the buffer in LUFS */
+			float ShortTermLufs = MinLevelDb;
+
+			/** Summed power of every band over all FFTs completed in the buffer */
+			float BandPower[NumSpectrumBands] = {};
+
+			/** Number of FFTs completed in the buffer */
+			int32 NumSpectra = 0;
+		};
+
+		/**
+		 * Computes the K-weighting filters and the band bins for a sample rate. Render thread only.
+		 * @param InSampleRate New sample rate.
+		 */
+		void SetSampleRate(const int32 InSampleRate);
+
+		/**
+		 * Transforms the collected mono frames and adds the band powers. Render thread only.
+		 * @param InOutAnalysis Analysis of the current buffer.
+		 */
+		void AnalyzeSpectrum(FBufferAnalysis& InOutAnalysis);
+
+		/** Single producer single consumer slots of analyzed buffers */
+		TCircularQueue<FBufferAnalysis> Slots;
+
+		/** Buffers dropped because the slots were full */
+		std::atomic<int64> NumDropped{0};
+
+		/** Set by Reset(), the render thread clears its state when it sees it */
+		std::atomic<bool> bRestartRequested{false};
+
+		/** Sample rate the filters are computed for. Render thread only. */
+		int32 SampleRate = 0;
+
+		/** K-weighting stages. Render thread only. */
+		FBiquad ShelfFilter;
+		FBiquad HighPassFilter;
+
+		/** Per channel states. Render thread only. */
+		FChannelState Channels[MaxChannels];
+
+		/** Frames per 100 ms loudness block */
+		int32 BlockFrames = 0;
+
+		/** Frames summed into the current loudness block */
+		int32 NumBlockFrames = 0;
+
+		/** Weighted mean square of the current loudness block */
+		double BlockPower = 0.0;
+
+		/** Mean squares of the last 30 blocks, the 3 second short-term window */
+		double BlockPowers[30] = {};
+
+		/** Next block to overwrite and number of filled blocks */
+		int32 NextBlock = 0;
+		int32 NumBlocks = 0;
+
+		/** Sum of the filled block powers */
+		double WindowPower = 0.0;
+
+		/** FFT of the mono downmix, allocated once */
+		TUniquePtr<Audio::IFFTAlgorithm> FFT;
+
+		/** Hann window, collected frames, windowed input and complex output of the FFT */
+		TArray<float> Window;
+		TArray<float> Frames;
+		TArray<float> FFTInput;
+		TArray<float> FFTOutput;
+
+		/** Number of collected frames */
+		int32 NumFrames = 0;
+
+		/** First bin of every band and one past the last */
+		int32 BandBins[NumSpectrumBands + 1] = {};
+
+		/** Scales bin power so a full scale sine reads 0 dBFS */
+		float PowerScale = 1.f;
+	};
+}
@@ -0,0 +1,102 @@
+﻿/**
+ * @file AudioProfilerRenderTimer.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerRenderTimer.h"
+
+#include "Algo/Sort.h"
+
+namespace BachelorAudio::AudioProfiler {
+	namespace {
+		/**
+		 * Returns a percentile of sorted values by nearest rank.
+		 * @param InSorted Values in ascending order, not empty.
+		 * @param InPercentile Percentile between 0 and 1.
+		 * @return The value at the percentile.
+		 */
+		uint64 GetPercentile(const TArray<uint64>& InSorted, const double InPercentile) {
+			const int32 rank = FMath::CeilToInt32(InPercentile * InSorted.Num());
+			return InSorted[FMath::Clamp(rank - 1, 0, InSorted.Num() - 1)];
+		}
+	}
+
+	FAudioProfilerRenderTimer::FAudioProfilerRenderTimer(const int32 InNumQueuedBuffers, const uint32 InCapacity)
+	: NumQueuedBuffers(FMath::Max(InNumQueuedBuffers, 1)),
+	  // One slot of the ring always stays empty
+	  Slots(FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 1) + 1)) {
+		Periods.Reserve(FMath::Max<uint32>(InCapacity, 1));
+	}
+
+	void FAudioProfilerRenderTimer::OnNewSubmixBuffer(
+		const USoundSubmix* OwningSubmix,
+		float* AudioData,
+		int32 NumSamples,
+		int32 NumChannels,
+		const int32 SampleRate,
+		double AudioClock
+		) {
+		if(NumChannels <= 0) return;
+		AddBuffer(FPlatformTime::Cycles64(), NumSamples / NumChannels, SampleRate);
+	}
+
+	void FAudioProfilerRenderTimer::AddBuffer(const uint64 InCycles, const int32 InNumFrames, const int32 InSampleRate) {
+		// A gap between two sessions is no late callback
+		if(bRestartRequested.exchange(false, std::memory_order_acquire)) LastCycles = 0;
+		const uint64 lastCycles = LastCycles;
+		LastCycles = InCycles;
+		if(InSampleRate <= 0) return;
+
+		FBufferTiming timing;
+		timing.BufferCycles = static_cast<uint64>(
+			static_cast<double>(InNumFrames) / InSampleRate / FPlatformTime::GetSecondsPerCycle64());
+		const int64 maxLeadCycles = static_cast<int64>(timing.BufferCycles) * (NumQueuedBuffers - 1);
+
+		// The first buffer only starts the clock, the device begins with a full queue
+		if(lastCycles == 0) {
+			LeadCycles = maxLeadCycles;
+			return;
+		}
+
+		// Playback consumed the period, the callback added one buffer
+		timing.PeriodCycles = InCycles - lastCycles;
+		LeadCycles += static_cast<int64>(timing.BufferCycles) - static_cast<int64>(timing.PeriodCycles);
+		timing.bIsLate = LeadCycles < 0;
+		LeadCycles = FMath::Clamp<int64>(LeadCycles, 0, maxLeadCycles);
+
+		if(!Slots.Enqueue(timing)) NumDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void FAudioProfilerRenderTimer::Summarize(FAudioProfilerRenderTiming& OutTiming) {
+		FMemory::Memzero(OutTiming);
+		Periods.Reset();
+
+		uint64 bufferCycles = 0;
+		FBufferTiming timing;
+		while(Slots.Dequeue(timing)) {
+			Periods.Add(timing.PeriodCycles);
+			bufferCycles = timing.BufferCycles;
+			OutTiming.NumLateCallbacks += timing.bIsLate ? 1 : 0;
+		}
+		if(Periods.Num() == 0) return;
+
+		Algo::Sort(Periods);
+		const double msPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+		OutTiming.PeriodP50Ms = static_cast<float>(GetPercentile(Periods, 0.5) * msPerCycle);
+		OutTiming.PeriodP99Ms = static_cast<float>(GetPercentile(Periods, 0.99) * msPerCycle);
+		OutTiming.PeriodMaxMs = static_cast<float>(Periods.Last() * msPerCycle);
+		OutTiming.BufferLengthMs = static_cast<float>(bufferCycles * msPerCycle);
+		OutTiming.NumCallbacks = Periods.Num();
+	}
+
+	void FAudioProfilerRenderTimer::Reset() {
+		FBufferTiming timing;
+		while(Slots.Dequeue(timing)) {}
+		NumDropped.store(0, std::memory_order_relaxed);
+		bRestartRequested.store(true, std::memory_order_release);
+	}
+
+	int64 FAudioProfilerRenderTimer::GetNumDropped() const {
+		return NumDropped.load(std::memory_order_relaxed);
+	}
+}
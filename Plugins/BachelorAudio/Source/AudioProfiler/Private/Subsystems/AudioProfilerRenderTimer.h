@@ -0,0 +1,131 @@
+﻿/**
+ * @file AudioProfilerRenderTimer.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioDevice.h"
+#include "Containers/CircularQueue.h"
+#include <atomic>
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @struct FAudioProfilerRenderTiming
+	 * @brief Callback periods of the main submix within one capture interval
+	 */
+	struct FAudioProfilerRenderTiming {
+		/** Median time between two callbacks in ms */
+		float PeriodP50Ms;
+
+		/** 99th percentile of the time between two callbacks in ms */
+		float PeriodP99Ms;
+
+		/** Longest time between two callbacks in ms */
+		float PeriodMaxMs;
+
+		/** Audio length of one buffer in ms, the expected callback period */
+		float BufferLengthMs;
+
+		/** Number of timed callbacks */
+		int32 NumBuffers;
+
+		/** Number of callbacks later than the modelled device queue allows, an estimate */
+		int32 NumLateCallbacks;
+	};
+
+	/**
+	 * @class FAudioProfilerRenderTimer
+	 * @brief Times the callback period of the main submix
+	 * @details Listens to the main submix, so it is called on the audio render thread once per
+	 * mixed buffer. It measures the time between two callbacks, not how long a buffer took to
+	 * render. The period is compared with the audio length of the buffer against a modelled queue
+	 * of the output device, a callback that falls behind by more than that queue counts as late.
+	 * Late callbacks are an estimate, the platform does not report actual underruns.
+	 * Every buffer goes into a preallocated lock-free slot, which the sampler thread summarizes
+	 * once per capture interval. If the sampler does not read in time, buffers are dropped and counted.
+	 */
+	class FAudioProfilerRenderTimer final : public ISubmixBufferListener {
+	public:
+		/**
+		 * @param InNumQueuedBuffers Buffers the device queues ahead of playback, at least one.
+		 * @param InCapacity Minimum number of buffers the slots hold, rounded up to a power of two.
+		 */
+		FAudioProfilerRenderTimer(const int32 InNumQueuedBuffers, const uint32 InCapacity);
+
+		FAudioProfilerRenderTimer(const FAudioProfilerRenderTimer&) = delete;
+		FAudioProfilerRenderTimer& operator=(const FAudioProfilerRenderTimer&) = delete;
+
+		//~ Begin ISubmixBufferListener
+		virtual void OnNewSubmixBuffer(
+			const USoundSubmix* OwningSubmix,
+			float* AudioData,
+			int32 NumSamples,
+			int32 NumChannels,
+			const int32 SampleRate,
+			double AudioClock
+			) override;
+		//~ End ISubmixBufferListener
+
+		/**
+		 * Times a callback. Render thread only.
+		 * @param InCycles Cycle counter of the callback.
+		 * @param InNumFrames Frames of the buffer.
+		 * @param InSampleRate Sample rate of the buffer.
+		 */
+		void AddBuffer(const uint64 InCycles, const int32 InNumFrames, const int32 InSampleRate);
+
+		/**
+		 * Summarizes and removes every buffer timed since the last call. Sampler thread only.
+		 * @param OutTiming Receives the summary, zero if no callback was timed.
+		 */
+		void Summarize(FAudioProfilerRenderTiming& OutTiming);
+
+		/**
+		 * Discards every timed buffer and restarts the clock with the next buffer.
+		 * Call while no sampler thread summarizes, e.g. before a session starts.
+		 */
+		void Reset();
+
+		/** @return Number of buffers dropped because the slots were full */
+		int64 GetNumDropped() const;
+
+	private:
+		/**
+		 * @struct FBufferTiming
+		 * @brief Timing of one callback
+		 */
+		struct FBufferTiming {
+			/** Cycles since the previous callback */
+			uint64 PeriodCycles = 0;
+
+			/** Cycles of audio in the buffer */
+			uint64 BufferCycles = 0;
+
+			/** Whether the modelled device queue ran out of audio before the callback */
+			bool bIsLate = false;
+		};
+
+		/** Buffers the device queues ahead of playback */
+		int32 NumQueuedBuffers;
+
+		/** Single producer single consumer slots of timed buffers */
+		TCircularQueue<FBufferTiming> Slots;
+
+		/** Buffers dropped because the slots were full */
+		std::atomic<int64> NumDropped{0};
+
+		/** Set by Reset(), the render thread restarts its clock when it sees it */
+		std::atomic<bool> bRestartRequested{false};
+
+		/** Cycle counter of the previous buffer, zero before the first. Render thread only. */
+		uint64 LastCycles = 0;
+
+		/** Queued audio ahead of playback in cycles. Render thread only. */
+		int64 LeadCycles = 0;
+
+		/** Periods of the current summary, reused to avoid allocations. Sampler thread only. */
+		TArray<uint64> Periods;
+	};
+}
@@ -0,0 +1,176 @@
+﻿/**
+ * @file AudioProfilerSampler.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerSampler.h"
+
+#include "AudioDevice.h"
+#include "AudioThread.h"
+#include "Trace/AudioProfilerTrace.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+namespace BachelorAudio::AudioProfiler {
+	namespace {
+		/** Longest time WaitUntil yields instead of sleeping, bounds the busy waiting per sample */
+		constexpr double MaxYieldSeconds = 0.0002;
+
+		/** Time between two reads of the memory stats, they walk the process memory map on some platforms */
+		constexpr double MemoryStatsIntervalSeconds = 0.25;
+	}
+
+	FAudioProfilerSampler::FAudioProfilerSampler(
+		FAudioDevice* InAudioDevice,
+		const double InIntervalSeconds,
+		const uint32 InCapacity,
+		const bool bInCaptureNodeTotals,
+		FAudioProfilerRenderTimer* InRenderTimer,
+		FAudioProfilerOutputAnalyzer* InOutputAnalyzer
+		)
+	: AudioDevice(InAudioDevice),
+	  IntervalSeconds(InIntervalSeconds),
+	  DeviceCounters(MakeShared<FAudioProfilerDeviceCounters, ESPMode::ThreadSafe>()),
+	  bCaptureNodeTotals(bInCaptureNodeTotals),
+	  RenderTimer(InRenderTimer),
+	  OutputAnalyzer(InOutputAnalyzer),
+	  // One slot of the ring always stays empty
+	  Ring(FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 1) + 1)) {}
+
+	FAudioProfilerSampler::~FAudioProfilerSampler() {
+		Shutdown();
+	}
+
+	bool FAudioProfilerSampler::Start() {
+		if(Thread != nullptr) return true;
+		bStopRequested.store(false, std::memory_order_relaxed);
+		Thread = FRunnableThread::Create(this, TEXT("AudioProfilerSampler"), 0, TPri_BelowNormal);
+		return Thread != nullptr;
+	}
+
+	void FAudioProfilerSampler::Shutdown() {
+		if(Thread == nullptr) return;
+		// Kill calls Stop and waits for Run to return
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	bool FAudioProfilerSampler::TryDequeue(FAudioProfilerSampleRecord& OutRecord) {
+		return Ring.Dequeue(OutRecord);
+	}
+
+	int64 FAudioProfilerSampler::GetNumDropped() const {
+		return NumDropped.load(std::memory_order_relaxed);
+	}
+
+	void FAudioProfilerSampler::UpdateDeviceCounters() {
+		if(AudioDevice == nullptr) return;
+		if(DeviceCounters->bIsUpdatePending.exchange(true, std::memory_order_acquire)) return;
+		// The device flushes its audio thread commands before it is destroyed, the counters are kept alive by the command
+		FAudioThread::RunCommandOnAudioThread([audioDevice = AudioDevice, counters = DeviceCounters]() {
+			counters->DeviceDeltaTime.store(audioDevice->GetDeviceDeltaTime(), std::memory_order_relaxed);
+			counters->AudioTime.store(static_cast<float>(audioDevice->GetAudioTime()), std::memory_order_relaxed);
+			counters->PrimaryVolume.store(audioDevice->GetPrimaryVolume(), std::memory_order_relaxed);
+			counters->Headroom.store(audioDevice->GetPlatformAudioHeadroom(), std::memory_order_relaxed);
+			counters->ActiveSoundCount.store(audioDevice->GetNumActiveSources(), std::memory_order_relaxed);
+			counters->FreeSourcesCount.store(audioDevice->GetNumFreeSources(), std::memory_order_relaxed);
+			counters->bIsUpdatePending.store(false, std::memory_order_release);
+		});
+	}
+
+	void FAudioProfilerSampler::Sample(
+		FAudioDevice* InAudioDevice,
+		const FAudioProfilerDeviceCounters& InDeviceCounters,
+		const float InMemoryUsageMB,
+		const bool bInCaptureNodeTotals,
+		FAudioProfilerSampleRecord& OutRecord
+		) {
+		FMemory::Memzero(OutRecord);
+		OutRecord.Timestamp = FPlatformTime::Seconds();
+		OutRecord.CurrentDelta = FApp::GetDeltaTime();
+		OutRecord.CPUUsage = FPlatformTime::GetCPUTime().CPUTimePct;
+		OutRecord.MemoryUsageMB = InMemoryUsageMB;
+
+		// Every device value comes from the copy made on the audio thread, the device is never read here
+		if(InAudioDevice != nullptr) {
+			OutRecord.bHasAudioDevice = true;
+			OutRecord.CurrentAudioDelta = InDeviceCounters.DeviceDeltaTime.load(std::memory_order_relaxed);
+			OutRecord.CurrentAudioTime = InDeviceCounters.AudioTime.load(std::memory_order_relaxed);
+			OutRecord.MasterVolumeLin = InDeviceCounters.PrimaryVolume.load(std::memory_order_relaxed);
+			OutRecord.Headroom = InDeviceCounters.Headroom.load(std::memory_order_relaxed);
+			OutRecord.ActiveSoundCount = InDeviceCounters.ActiveSoundCount.load(std::memory_order_relaxed);
+			OutRecord.FreeSourcesCount = InDeviceCounters.FreeSourcesCount.load(std::memory_order_relaxed);
+		}
+
+		if(bInCaptureNodeTotals) {
+			using namespace BachelorMetasound;
+			OutRecord.bHasNodeTotals = true;
+			for(int32 i = 0; i < static_cast<int32>(ENodeRenderClass::Num); ++i) {
+				OutRecord.NodeTotals[i] = FNodeRenderStats::GetSnapshot(static_cast<ENodeRenderClass>(i));
+			}
+		}
+	}
+
+	uint32 FAudioProfilerSampler::Run() {
+		double nextSampleSeconds = FPlatformTime::Seconds();
+		double nextMemoryStatsSeconds = nextSampleSeconds;
+		float memoryUsageMB = 0.f;
+		FAudioProfilerSampleRecord record;
+		// Node totals of the last traced record, node costs are traced as the difference
+		BachelorMetasound::FNodeRenderStatsSnapshot tracedTotals[static_cast<int32>(BachelorMetasound::ENodeRenderClass::Num)];
+		bool bHasTracedTotals = false;
+		bool bWasTracing = false;
+		while(!bStopRequested.load(std::memory_order_relaxed)) {
+			// The copy arrives while the sampler waits, so the next record shows it
+			UpdateDeviceCounters();
+			if(FPlatformTime::Seconds() >= nextMemoryStatsSeconds) {
+				memoryUsageMB = FPlatformMemory::GetStats().UsedPhysical / 1024.0f / 1024.0f;
+				nextMemoryStatsSeconds = FPlatformTime::Seconds() + MemoryStatsIntervalSeconds;
+			}
+			Sample(AudioDevice, *DeviceCounters, memoryUsageMB, bCaptureNodeTotals, record);
+			if(RenderTimer != nullptr) {
+				record.bHasRenderTiming = true;
+				RenderTimer->Summarize(record.RenderTiming);
+			}
+			if(OutputAnalyzer != nullptr) {
+				record.bHasOutputAnalysis = OutputAnalyzer->Summarize(record.OutputAnalysis);
+			}
+			if(!Ring.Enqueue(record)) NumDropped.fetch_add(1, std::memory_order_relaxed);
+
+			if(Trace::IsEnabled()) {
+				// Node costs refer to the classes by id, the names are sent whenever the channel gets enabled
+				if(!bWasTracing && bCaptureNodeTotals) Trace::OutputNodeClasses();
+				Trace::OutputRecord(record);
+				if(bHasTracedTotals) Trace::OutputNodeCosts(record, tracedTotals);
+				FMemory::Memcpy(tracedTotals, record.NodeTotals, sizeof(tracedTotals));
+				bHasTracedTotals = record.bHasNodeTotals;
+				bWasTracing = true;
+			} else {
+				bHasTracedTotals = false;
+				bWasTracing = false;
+			}
+
+			// A late sample moves the schedule instead of sampling in a burst to catch up
+			nextSampleSeconds = FMath::Max(nextSampleSeconds + IntervalSeconds, FPlatformTime::Seconds());
+			WaitUntil(nextSampleSeconds);
+		}
+		return 0;
+	}
+
+	void FAudioProfilerSampler::Stop() {
+		bStopRequested.store(true, std::memory_order_relaxed);
+	}
+
+	void FAudioProfilerSampler::WaitUntil(const double InSeconds) const {
+		for(;;) {
+			if(bStopRequested.load(std::memory_order_relaxed)) return;
+			const double remaining = InSeconds - FPlatformTime::Seconds();
+			if(remaining <= 0.0) return;
+			// OS sleeps overshoot by up to a scheduler tick, but yielding spins a core when nothing else runs.
+			// Only the last MaxYieldSeconds are yielded away, a late sample is timestamped anyway.
+			if(remaining > MaxYieldSeconds) FPlatformProcess::SleepNoStats(static_cast<float>(FMath::Min(remaining - MaxYieldSeconds, 0.05)));
+			else FPlatformProcess::YieldThread();
+		}
+	}
+}
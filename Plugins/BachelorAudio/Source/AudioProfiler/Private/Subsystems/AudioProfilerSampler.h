@@ -0,0 +1,231 @@
+﻿/**
+ * @file AudioProfilerSampler.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioProfilerOutputAnalyzer.h"
+#include "AudioProfilerRenderTimer.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/Runnable.h"
+#include "NodeRenderStats.h"
+#include <atomic>
+
+class FAudioDevice;
+class FRunnableThread;
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @struct FAudioProfilerSampleRecord
+	 * @brief Fixed size record of one sample taken by the sampler thread
+	 * @details Holds only plain values, so it is copied into the ring without allocations.
+	 * Node costs are stored as totals since engine start, the game thread turns them into
+	 * the cost of one interval while draining.
+	 */
+	struct FAudioProfilerSampleRecord {
+		/** Platform time the sample was taken at in seconds */
+		double Timestamp;
+
+		/** Audio device delta time, copied on the audio thread at most one interval before */
+		float CurrentAudioDelta;
+
+		/** Audio device time, copied on the audio thread at most one interval before */
+		float CurrentAudioTime;
+
+		/** Delta time of the last game frame */
+		float CurrentDelta;
+
+		/** Process CPU usage in percent */
+		float CPUUsage;
+
+		/** Used physical memory in MB, read every MemoryStatsIntervalSeconds */
+		float MemoryUsageMB;
+
+		/** Primary volume of the audio device, copied on the audio thread at most one interval before */
+		float MasterVolumeLin;
+
+		/** Platform headroom of the audio device, copied on the audio thread at most one interval before */
+		float Headroom;
+
+		/** Number of active sources, copied on the audio thread at most one interval before */
+		int32 ActiveSoundCount;
+
+		/** Number of free sources, copied on the audio thread at most one interval before */
+		int32 FreeSourcesCount;
+
+		/** Whether an audio device was sampled, otherwise only time, CPU and memory are valid */
+		bool bHasAudioDevice;
+
+		/** Whether NodeTotals were read */
+		bool bHasNodeTotals;
+
+		/** Whether RenderTiming was summarized */
+		bool bHasRenderTiming;
+
+		/** Whether OutputAnalysis was summarized */
+		bool bHasOutputAnalysis;
+
+		/** Render timing of the buffers since the previous record */
+		FAudioProfilerRenderTiming RenderTiming;
+
+		/** Levels of the output rendered since the previous record */
+		FAudioProfilerOutputAnalysis OutputAnalysis;
+
+		/** Render cost totals per MetaSound node class */
+		BachelorMetasound::FNodeRenderStatsSnapshot NodeTotals[static_cast<int32>(BachelorMetasound::ENodeRenderClass::Num)];
+	};
+
+	static_assert(std::is_trivially_copyable_v<FAudioProfilerSampleRecord>, "Sample records are copied as plain memory");
+
+	/**
+	 * @struct FAudioProfilerDeviceCounters
+	 * @brief Device values copied on the audio thread for the sampler thread
+	 * @details The device writes these values on the audio thread and the source counts walk source
+	 * arrays only the audio thread may touch, so the sampler reads the last copy instead of calling
+	 * the device getters itself. Every sample requests the next copy.
+	 */
+	struct FAudioProfilerDeviceCounters {
+		/** Audio device delta time */
+		std::atomic<float> DeviceDeltaTime{0.f};
+
+		/** Audio device time */
+		std::atomic<float> AudioTime{0.f};
+
+		/** Primary volume of the audio device */
+		std::atomic<float> PrimaryVolume{0.f};
+
+		/** Platform headroom of the audio device */
+		std::atomic<float> Headroom{0.f};
+
+		/** Number of active sources */
+		std::atomic<int32> ActiveSoundCount{0};
+
+		/** Number of free sources */
+		std::atomic<int32> FreeSourcesCount{0};
+
+		/** Set while a copy is queued, so a stalled audio thread does not pile up commands */
+		std::atomic<bool> bIsUpdatePending{false};
+	};
+
+	/**
+	 * @class FAudioProfilerSampler
+	 * @brief Samples audio and system metrics on a dedicated low priority thread
+	 * @details Writes one FAudioProfilerSampleRecord per interval into a preallocated lock-free
+	 * ring. The sampler thread is the only producer and the game thread the only consumer, so
+	 * neither side takes a lock and the interval is not bound to the frame rate.
+	 * If the game thread does not drain in time, new records are dropped and counted.
+	 */
+	class FAudioProfilerSampler final : public FRunnable {
+	public:
+		/**
+		 * @param InAudioDevice Device to sample, may be null. Must outlive the sampler.
+		 * @param InIntervalSeconds Time between two samples.
+		 * @param InCapacity Minimum number of records the ring holds, rounded up to a power of two.
+		 * @param bInCaptureNodeTotals Whether the render cost totals of the MetaSound node classes are read.
+		 * @param InRenderTimer Render timer summarized into every record, may be null. Must outlive the sampler.
+		 * @param InOutputAnalyzer Output analyzer summarized into every record, may be null. Must outlive the sampler.
+		 */
+		FAudioProfilerSampler(
+			FAudioDevice* InAudioDevice,
+			const double InIntervalSeconds,
+			const uint32 InCapacity,
+			const bool bInCaptureNodeTotals,
+			FAudioProfilerRenderTimer* InRenderTimer = nullptr,
+			FAudioProfilerOutputAnalyzer* InOutputAnalyzer = nullptr
+			);
+
+		/** Stops and joins the sampler thread */
+		virtual ~FAudioProfilerSampler() override;
+
+		FAudioProfilerSampler(const FAudioProfilerSampler&) = delete;
+		FAudioProfilerSampler& operator=(const FAudioProfilerSampler&) = delete;
+
+		/**
+		 * Starts the sampler thread.
+		 * @return False if the thread could not be created.
+		 */
+		bool Start();
+
+		/**
+		 * Stops and joins the sampler thread.
+		 * Records already in the ring stay readable, no record is added afterwards.
+		 */
+		void Shutdown();
+
+		/**
+		 * Takes the oldest record out of the ring. Game thread only.
+		 * @param OutRecord Receives the record.
+		 * @return False if the ring is empty.
+		 */
+		bool TryDequeue(FAudioProfilerSampleRecord& OutRecord);
+
+		/** @return Number of records dropped because the ring was full */
+		int64 GetNumDropped() const;
+
+		/**
+		 * Takes one sample on the calling thread.
+		 * @param InAudioDevice Device to sample, may be null.
+		 * @param InDeviceCounters Values of the device copied on the audio thread.
+		 * @param InMemoryUsageMB Used physical memory in MB, read less often than the other values.
+		 * @param bInCaptureNodeTotals Whether the node render cost totals are read.
+		 * @param OutRecord Receives the sample.
+		 */
+		static void Sample(
+			FAudioDevice* InAudioDevice,
+			const FAudioProfilerDeviceCounters& InDeviceCounters,
+			const float InMemoryUsageMB,
+			const bool bInCaptureNodeTotals,
+			FAudioProfilerSampleRecord& OutRecord
+			);
+
+		//~ Begin FRunnable
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+		//~ End FRunnable
+
+	private:
+		/**
+		 * Sends a command copying the device values on the audio thread, unless the previous one is still queued.
+		 * Sampler thread only. Records show the last copy.
+		 */
+		void UpdateDeviceCounters();
+
+		/**
+		 * Waits until the given platform time, sleeps for long waits and yields only for the last moments.
+		 * @param InSeconds Platform time to wait for.
+		 */
+		void WaitUntil(const double InSeconds) const;
+
+		/** Device to sample */
+		FAudioDevice* AudioDevice;
+
+		/** Time between two samples */
+		double IntervalSeconds;
+
+		/** Written by audio thread commands, shared so a command still queued after shutdown stays valid */
+		TSharedRef<FAudioProfilerDeviceCounters, ESPMode::ThreadSafe> DeviceCounters;
+
+		/** Whether node render cost totals are read */
+		bool bCaptureNodeTotals;
+
+		/** Render timer summarized into every record, the sampler thread is its only consumer */
+		FAudioProfilerRenderTimer* RenderTimer;
+
+		/** Output analyzer summarized into every record, the sampler thread is its only consumer */
+		FAudioProfilerOutputAnalyzer* OutputAnalyzer;
+
+		/** Single producer single consumer ring of sampled records */
+		TCircularQueue<FAudioProfilerSampleRecord> Ring;
+
+		/** Set by Stop() to end the sampling loop */
+		std::atomic<bool> bStopRequested{false};
+
+		/** Records dropped because the ring was full */
+		std::atomic<int64> NumDropped{0};
+
+		/** The sampler thread, null until started */
+		FRunnableThread* Thread = nullptr;
+	};
+}
@@ -3,12 +3,41 @@
 #include "Subsystems/AudioProfilerSubsystem.h"
 
 #include "AudioMixerBlueprintLibrary.h"
+#include "AudioProfilerAudioRing.h"
+#include "AudioProfilerBookmarkQueue.h"
+#include "AudioProfilerFlightRecorder.h"
 #include "AudioProfilerModule.h"
+#include "AudioProfilerOutputAnalyzer.h"
+#include "AudioProfilerRenderTimer.h"
+#include "AudioProfilerSampler.h"
+#include "Async/Async.h"
+#include "Capture/AudioProfilerCaptureConverter.h"
+#include "Capture/AudioProfilerCaptureWriter.h"
+#include "NodeRenderStats.h"
+#include "Trace/AudioProfilerTrace.h"
 #include "Models/AudioProfilerDeveloperModel.h"
 
+namespace {
+	/** Shortest time between two drains of the sampler ring on the game thread */
+	constexpr float MinDrainIntervalSeconds = 0.1f;
+
+	/** Number of drains the game thread may miss before the sampler drops records */
+	constexpr double RingSlackDrains = 4.0;
+
+	/** Upper bound of records in the sampler ring */
+	constexpr uint32 MaxRingCapacity = 1u << 16;
+
+	/** Callbacks the render timer holds between two samples, seconds of audio at small buffer sizes */
+	constexpr uint32 RenderTimerCapacity = 4096;
+
+	/** Bookmarks the queue holds between two drains */
+	constexpr uint32 BookmarkQueueCapacity = 1024;
+
+}
+
 UAudioProfilerSubsystem::UAudioProfilerSubsystem()
-: bIsProfiling(false),
-  LastBookMarksNum(0),
+: ProfilingBookmarks(MakeUnique<BachelorAudio::AudioProfiler::FAudioProfilerBookmarkQueue>(BookmarkQueueCapacity)),
+  bIsProfiling(false),
   AudioDevice(nullptr) {
 	const UAudioProfilerDeveloperSettings* settings = GetDefault<UAudioProfilerDeveloperSettings>();
 
@@ -20,6 +49,13 @@ UAudioProfilerSubsystem::UAudioProfilerSubsystem()
 			  : settings->OutputDirectory;
 
 	ProfilingData.AudioProfilerSettings.Interval = settings->ProfilingInterval;
+	ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost = settings->bCaptureNodeRenderCost;
+	ProfilingData.AudioProfilerSettings.FlightRecorderSeconds = settings->FlightRecorderSeconds;
+	ProfilingData.AudioProfilerSettings.FlightRecorderInterval = settings->FlightRecorderInterval;
+	ProfilingData.AudioProfilerSettings.bFlightRecorderAudio = settings->bFlightRecorderAudio;
+	ProfilingData.AudioProfilerSettings.bDumpOnLateCallback = settings->bDumpOnLateCallback;
+	ProfilingData.AudioProfilerSettings.FrameSpikeThresholdMs = settings->FrameSpikeThresholdMs;
+	ProfilingData.AudioProfilerSettings.PeakThresholdDb = settings->PeakThresholdDb;
 
 	if(ProfilingData.AudioProfilerSettings.DebugMode == EAudioProfilerDebuggingType::NoDebugging) return;
 
@@ -63,8 +99,8 @@ UAudioProfilerSubsystem::UAudioProfilerSubsystem()
 }
 
 UAudioProfilerSubsystem::UAudioProfilerSubsystem(const FObjectInitializer& ObjectInitializer)
-: bIsProfiling(false),
-  LastBookMarksNum(0),
+: ProfilingBookmarks(MakeUnique<BachelorAudio::AudioProfiler::FAudioProfilerBookmarkQueue>(BookmarkQueueCapacity)),
+  bIsProfiling(false),
   AudioDevice(nullptr) {
 	const UAudioProfilerDeveloperSettings* settings = GetDefault<UAudioProfilerDeveloperSettings>();
 
@@ -76,6 +112,13 @@ UAudioProfilerSubsystem::UAudioProfilerSubsystem(const FObjectInitializer& Objec
 			  : settings->OutputDirectory;
 
 	ProfilingData.AudioProfilerSettings.Interval = settings->ProfilingInterval;
+	ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost = settings->bCaptureNodeRenderCost;
+	ProfilingData.AudioProfilerSettings.FlightRecorderSeconds = settings->FlightRecorderSeconds;
+	ProfilingData.AudioProfilerSettings.FlightRecorderInterval = settings->FlightRecorderInterval;
+	ProfilingData.AudioProfilerSettings.bFlightRecorderAudio = settings->bFlightRecorderAudio;
+	ProfilingData.AudioProfilerSettings.bDumpOnLateCallback = settings->bDumpOnLateCallback;
+	ProfilingData.AudioProfilerSettings.FrameSpikeThresholdMs = settings->FrameSpikeThresholdMs;
+	ProfilingData.AudioProfilerSettings.PeakThresholdDb = settings->PeakThresholdDb;
 
 	if(ProfilingData.AudioProfilerSettings.DebugMode == EAudioProfilerDebuggingType::NoDebugging) return;
 
@@ -125,7 +168,6 @@ UAudioProfilerSubsystem::~UAudioProfilerSubsystem() {
 		Log,
 		TEXT("UAudioProfilingSubsystem destructed")
 		);
-	ProfilingBookmarks.Empty();
 }
 
 void UAudioProfilerSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
@@ -154,12 +196,11 @@ void UAudioProfilerSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
 void UAudioProfilerSubsystem::Deinitialize() {
 	Super::Deinitialize();
 
-	ProfilingBookmarks.Empty();
-
 	if(ProfilingData.AudioProfilerSettings.ProfilingMode == EAudioProfilerProfilingType::NoProfiling)
 		return;
 
 	StopProfiling();
+	StopFlightRecorder();
 
 	Super::Deinitialize();
 
@@ -194,11 +235,10 @@ void UAudioProfilerSubsystem::StartProfiling(
 	float ExpectedDurationSeconds,
 	const UWorld* WorldContext
 ) {
-	ProfilingData.AudioProfilerData.Empty();
 	if(ProfilingData.AudioProfilerSettings.ProfilingMode == EAudioProfilerProfilingType::NoProfiling)
 		return;
 
-	if(bIsProfiling) {
+	if(bIsProfiling || bIsRecording) {
 		UE_CLOG(
 			ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
 			LogAudioProfiler,
@@ -208,6 +248,9 @@ void UAudioProfilerSubsystem::StartProfiling(
 		return;
 	}
 
+	// Bookmarks added between two sessions belong to none
+	ProfilingBookmarks->Empty();
+
 	ProfilingData.AudioProfilerSettings.CurrentSessionName = InSessionName.IsEmpty()
 		? BuildSessionString("AudioProfilingSession")
 		: BuildSessionString(InSessionName);
@@ -220,19 +263,6 @@ void UAudioProfilerSubsystem::StartProfiling(
 		? GetWorld()
 		: WorldContext;
 
-	AudioDevice = World->GetAudioDevice().GetAudioDevice();
-	if(AudioDevice != nullptr) {
-		ProfilingData.AudioProfilerHeader.SampleRate = AudioDevice->GetSampleRate();
-		ProfilingData.AudioProfilerHeader.MaxChannels = AudioDevice->GetMaxChannels();
-		ProfilingData.AudioProfilerHeader.MaxSources = AudioDevice->GetMaxSources();
-	}
-
-	ProfilingTimerDelegate = FTimerDelegate::CreateUObject(this, &UAudioProfilerSubsystem::CaptureProfilingData);
-	
-	ProfilingData.AudioProfilerHeader.Date = FDateTime::Now();
-	ProfilingData.AudioProfilerHeader.WorldName = World->GetName();
-
-	
 	if(World == nullptr) {
 		UE_CLOG(
 			ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Error,
@@ -243,19 +273,32 @@ void UAudioProfilerSubsystem::StartProfiling(
 		return;
 	}
 
-	World->GetTimerManager().SetTimer(
-		ProfilingTimerHandle,
-		ProfilingTimerDelegate,
-		ProfilingData.AudioProfilerSettings.Interval,
-		true
-	);
+	BindAudioDevice(World);
+
+	// Created before the sampler, so the node cost baseline precedes the first record
+	const float interval = ProfilingData.AudioProfilerSettings.Interval;
+	const uint32 expectedRecords = static_cast<uint32>(FMath::Clamp(
+		FMath::CeilToDouble(ExpectedDurationSeconds / interval),
+		1.0,
+		static_cast<double>(MAX_int32)
+		));
+	CaptureWriter = MakeShared<BachelorAudio::AudioProfiler::FAudioProfilerCaptureWriter, ESPMode::ThreadSafe>(
+		BuildSessionPath(TEXT(".apcap")),
+		ProfilingData.AudioProfilerHeader,
+		interval,
+		ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost,
+		expectedRecords
+		);
 
+	if(!StartSampler(World, interval)) {
+		CaptureWriter.Reset();
+		return;
+	}
 
 	UAudioMixerBlueprintLibrary::StartRecordingOutput(
 		World,
 		ExpectedDurationSeconds
 		);
-	UAudioMixerBlueprintLibrary::StartAnalyzingOutput(World);
 	
 	UE_CLOG(
 		ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Log,
@@ -280,104 +323,452 @@ void UAudioProfilerSubsystem::StopProfiling(const UWorld* WorldContext) {
 	? GetWorld()
 	: WorldContext;
 
-	if(World == nullptr) return;
+	// The sampler is joined first, so the last drain sees every record and the audio device is no longer read
+	StopSampler(World);
 
-	World->GetTimerManager().ClearTimer(ProfilingTimerHandle);
+	// Without a world, e.g. when stopped from Deinitialize, only the wave recording is lost, the capture is still finalized
+	if(World != nullptr) {
+		UAudioMixerBlueprintLibrary::StopRecordingOutput(
+			World,
+			EAudioRecordingExportType::WavFile,
+			ProfilingData.AudioProfilerSettings.CurrentSessionName,
+			ProfilingData.AudioProfilerSettings.OutputPath
+			);
+	}
 
-	//UAudioMixerBlueprintLibrary::StopAnalyzingOutput(World);
-	UAudioMixerBlueprintLibrary::StopRecordingOutput(
-		World,
-		EAudioRecordingExportType::WavFile,
-		ProfilingData.AudioProfilerSettings.CurrentSessionName,
-		ProfilingData.AudioProfilerSettings.OutputPath
+	FinishExport();
+
+	ProfilingBookmarks->Empty();
+	UE_CLOG(
+		ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Log,
+		LogAudioProfiler,
+		Log,
+		TEXT("Profiling stopped")
+		);
+}
+
+void UAudioProfilerSubsystem::StartFlightRecorder(const UWorld* WorldContext) {
+	if(ProfilingData.AudioProfilerSettings.ProfilingMode == EAudioProfilerProfilingType::NoProfiling)
+		return;
+
+	if(bIsProfiling || bIsRecording) {
+		UE_CLOG(
+			ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
+			LogAudioProfiler,
+			Log,
+			TEXT("Profiler is already capturing")
+			);
+		return;
+	}
+
+	const UWorld* World = !WorldContext
+		? GetWorld()
+		: WorldContext;
+
+	if(World == nullptr) {
+		UE_CLOG(
+			ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Error,
+			LogAudioProfiler,
+			Error,
+			TEXT("Can not record without world")
+			);
+		return;
+	}
+
+	ProfilingBookmarks->Empty();
+	BindAudioDevice(World);
+
+	// The rings are allocated once, a restarted recorder forgets the last window but keeps the memory
+	const FAudioProfilerDeveloperModel& settings = ProfilingData.AudioProfilerSettings;
+	if(FlightRecorder.IsValid()) {
+		FlightRecorder->Reset();
+	} else {
+		BachelorAudio::AudioProfiler::FAudioProfilerFlightRecorderSettings recorderSettings;
+		recorderSettings.WindowSeconds = settings.FlightRecorderSeconds;
+		recorderSettings.IntervalSeconds = settings.FlightRecorderInterval;
+		recorderSettings.bTriggerOnLateCallback = settings.bDumpOnLateCallback;
+		recorderSettings.FrameSpikeThresholdMs = settings.FrameSpikeThresholdMs;
+		recorderSettings.PeakThresholdDb = settings.PeakThresholdDb;
+		FlightRecorder = MakeUnique<BachelorAudio::AudioProfiler::FAudioProfilerFlightRecorder>(recorderSettings);
+	}
+
+	if(settings.bFlightRecorderAudio && AudioDevice != nullptr) {
+		const int32 sampleRate = static_cast<int32>(AudioDevice->GetSampleRate());
+		if(!AudioRing.IsValid() || AudioRing->GetSampleRate() != sampleRate) {
+			AudioRing = MakeUnique<BachelorAudio::AudioProfiler::FAudioProfilerAudioRing>(settings.FlightRecorderSeconds, sampleRate);
+		}
+		AudioDevice->RegisterSubmixBufferListener(AudioRing.Get());
+	}
+
+	if(!StartSampler(World, settings.FlightRecorderInterval)) {
+		if(AudioDevice != nullptr && AudioRing.IsValid()) AudioDevice->UnregisterSubmixBufferListener(AudioRing.Get());
+		return;
+	}
+
+	UE_CLOG(
+		ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Log,
+		LogAudioProfiler,
+		Log,
+		TEXT("Flight recorder started with...\nWindow: %fs\nInterval: %fs"),
+		settings.FlightRecorderSeconds,
+		settings.FlightRecorderInterval
 		);
 
-	ExportProfilingData();
+	bIsRecording = true;
+}
+
+void UAudioProfilerSubsystem::StopFlightRecorder(const UWorld* WorldContext) {
+	if(!bIsRecording) return;
+
+	const UWorld* World = !WorldContext
+		? GetWorld()
+		: WorldContext;
 
-	ProfilingBookmarks.Empty();
+	// Still recording while the last records are drained, a trigger among them dumps
+	StopSampler(World);
+	if(AudioDevice != nullptr && AudioRing.IsValid()) AudioDevice->UnregisterSubmixBufferListener(AudioRing.Get());
+
+	bIsRecording = false;
+	ProfilingBookmarks->Empty();
 	UE_CLOG(
 		ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Log,
 		LogAudioProfiler,
 		Log,
-		TEXT("Profiling stopped")
+		TEXT("Flight recorder stopped")
 		);
 }
 
+void UAudioProfilerSubsystem::DumpFlightRecorder(const FString& InReason) {
+	if(!bIsRecording || !FlightRecorder.IsValid()) {
+		UE_CLOG(
+			ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
+			LogAudioProfiler,
+			Warning,
+			TEXT("Flight recorder is not running, nothing to dump")
+			);
+		return;
+	}
+
+	// Every dump is a session of its own
+	const FString reason = FPaths::MakeValidFileName(InReason.IsEmpty() ? FString(TEXT("Manual")) : InReason);
+	ProfilingData.AudioProfilerSettings.CurrentSessionName = BuildSessionString(FString::Printf(TEXT("FlightRecorder_%s"), *reason));
+	FAudioProfilerHeaderModel header = ProfilingData.AudioProfilerHeader;
+	header.SessionName = ProfilingData.AudioProfilerSettings.CurrentSessionName;
+	header.Date = FDateTime::Now();
+
+	const FString capturePath = BuildSessionPath(TEXT(".apcap"));
+	const TSharedRef<BachelorAudio::AudioProfiler::FAudioProfilerCaptureWriter, ESPMode::ThreadSafe> writer
+		= MakeShared<BachelorAudio::AudioProfiler::FAudioProfilerCaptureWriter, ESPMode::ThreadSafe>(
+			capturePath,
+			header,
+			ProfilingData.AudioProfilerSettings.FlightRecorderInterval,
+			ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost,
+			static_cast<uint32>(FlightRecorder->GetCapacity())
+			);
+	if(FlightRecorder->Dump(*writer, *ProfilingBookmarks) == 0) {
+		UE_CLOG(
+			ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
+			LogAudioProfiler,
+			Warning,
+			TEXT("Flight recorder holds no records yet")
+			);
+		OnFlightRecorderDumped.Broadcast(reason, false, FString(), FString());
+		return;
+	}
+	CaptureActiveSounds(*writer);
+
+	// Copied now, the render thread keeps overwriting the ring while the files are written
+	TArray<float> samples;
+	FString wavePath;
+	int32 sampleRate = 0;
+	if(AudioRing.IsValid() && ProfilingData.AudioProfilerSettings.bFlightRecorderAudio) {
+		AudioRing->Snapshot(samples);
+		sampleRate = AudioRing->GetSampleRate();
+		wavePath = BuildSessionPath(TEXT(".wav"));
+	}
+
+	TWeakObjectPtr<UAudioProfilerSubsystem> weakThis(this);
+	writer->Finalize([weakThis, reason, capturePath, wavePath, sampleRate, samples = MoveTemp(samples)](const bool bCaptureWritten) {
+		const bool bWaveWritten = !wavePath.IsEmpty()
+			&& BachelorAudio::AudioProfiler::FAudioProfilerAudioRing::WriteWaveFile(samples, sampleRate, wavePath);
+
+		AsyncTask(ENamedThreads::GameThread, [weakThis, reason, capturePath, wavePath, bCaptureWritten, bWaveWritten]() {
+			UE_LOG(LogAudioProfiler, Log, TEXT("Flight recorder dumped to %s (%s)"), *capturePath, *reason);
+			UE_CLOG(!bCaptureWritten, LogAudioProfiler, Error, TEXT("Dump %s is incomplete"), *capturePath);
+			UE_CLOG(!wavePath.IsEmpty() && !bWaveWritten, LogAudioProfiler, Error, TEXT("Can not write %s"), *wavePath);
+			UAudioProfilerSubsystem* subsystem = weakThis.Get();
+			if(subsystem == nullptr) return;
+			subsystem->OnFlightRecorderDumped.Broadcast(reason, bCaptureWritten, capturePath, bWaveWritten ? wavePath : FString());
+		});
+	});
+}
+
 void UAudioProfilerSubsystem::AddBookmark(const FString& InName) {
 	if(ProfilingData.AudioProfilerSettings.ProfilingMode < EAudioProfilerProfilingType::ProfilingSounds)
 		return;
 	
-	double timestamp = FPlatformTime::Seconds();
-	ProfilingBookmarks.Add(timestamp, InName);
+	AddBookmarkById(ProfilingBookmarks->InternName(InName));
+}
+
+uint32 UAudioProfilerSubsystem::RegisterBookmarkName(const FString& InName) {
+	return ProfilingBookmarks->InternName(InName);
+}
+
+void UAudioProfilerSubsystem::AddBookmarkById(const uint32 InNameId) {
+	if(ProfilingData.AudioProfilerSettings.ProfilingMode < EAudioProfilerProfilingType::ProfilingSounds)
+		return;
+
+	ProfilingBookmarks->Enqueue(InNameId, FPlatformTime::Seconds());
 }
 
 const FAudioProfilerModel& UAudioProfilerSubsystem::GetProfilingData() const {
 	return ProfilingData;
 }
 
-void UAudioProfilerSubsystem::CaptureProfilingData() {
-	UE_LOG(LogAudioProfiler, Warning, TEXT("Timestamp capture"));
-	FAudioProfilerTimestampModel timestamp;
-	if(ProfilingBookmarks.Num() != LastBookMarksNum) {
-		for(const auto& bookmark : ProfilingBookmarks) {
-			timestamp.ActiveBookmarks.Add(FString::Printf(TEXT("%s: %f"), *bookmark.Value, bookmark.Key));
-			ProfilingBookmarks.Remove(bookmark.Key);
+void UAudioProfilerSubsystem::DrainProfilingData() {
+	if(!Sampler.IsValid()) return;
+	if(bIsRecording) {
+		DrainFlightRecorder();
+		return;
+	}
+	if(!CaptureWriter.IsValid()) return;
+
+	bool bHasDrained = false;
+	BachelorAudio::AudioProfiler::FAudioProfilerSampleRecord record;
+	BachelorAudio::AudioProfiler::FAudioProfilerBookmark bookmark;
+	while(Sampler->TryDequeue(record)) {
+		CaptureWriter->Add(record);
+		bHasDrained = true;
+
+		// A bookmark belongs to the first record taken after it, later ones wait for the next drain
+		while(ProfilingBookmarks->Peek(bookmark) && bookmark.Time <= record.Timestamp) {
+			ProfilingBookmarks->Dequeue(bookmark);
+			CaptureWriter->AddBookmark(*ProfilingBookmarks, bookmark.NameId, bookmark.Time);
+			// The writer caches the names, the lock of the queue names is only taken for the trace
+			if(BachelorAudio::AudioProfiler::Trace::IsEnabled()) {
+				BachelorAudio::AudioProfiler::Trace::OutputBookmark(ProfilingBookmarks->GetName(bookmark.NameId), bookmark.Time);
+			}
 		}
-		LastBookMarksNum = ProfilingBookmarks.Num();
 	}
-	
-	if(AudioDevice != nullptr) {
-		TArray<FActiveSound*> activeSounds;
-		for(const auto& sound : AudioDevice->GetActiveSounds()) {
-			activeSounds.Add(sound);
+
+	// The sampler is joined when profiling stops, bookmarks after its last record go to that record
+	if(!bIsProfiling && CaptureWriter->GetNumRecords() > 0) {
+		while(ProfilingBookmarks->Dequeue(bookmark)) {
+			CaptureWriter->AddBookmark(*ProfilingBookmarks, bookmark.NameId, bookmark.Time);
+			if(BachelorAudio::AudioProfiler::Trace::IsEnabled()) {
+				BachelorAudio::AudioProfiler::Trace::OutputBookmark(ProfilingBookmarks->GetName(bookmark.NameId), bookmark.Time);
+			}
 		}
-	
-		timestamp.Timestamp = FPlatformTime::Seconds();
-		timestamp.CurrentAudioDelta = AudioDevice->GetDeviceDeltaTime();
-		timestamp.CurrentAudioTime = AudioDevice->GetAudioTime();
-		timestamp.CurrentDelta = FApp::GetDeltaTime();
-		timestamp.Framerate = FMath::Clamp(1 / timestamp.CurrentDelta, 0.f, 1000.f);
-		timestamp.CPUUsage = FPlatformTime::GetCPUTime().CPUTimePct;
-		timestamp.MemoryUsageMB = FPlatformMemory::GetStats().UsedPhysical / 1024.0f / 1024.0f;
-		timestamp.MasterVolumeLin =  AudioDevice->GetPrimaryVolume();
-		timestamp.Headroom =  AudioDevice->GetPlatformAudioHeadroom();
-		timestamp.ActiveSoundCount = AudioDevice->GetNumActiveSources();
-		timestamp.FreeSourcesCount = AudioDevice->GetNumFreeSources();
-
-		FAudioProfilerSoundModel activeSound;
-		for(const auto& sound : activeSounds) {
-			activeSound.ActiveSoundName = sound->GetSound()->GetName();
-			activeSound.ActiveSoundVolume = sound->GetVolume();
-			for(const auto& value: activeSound.ActiveSoundValues) {
-				activeSound.ActiveSoundValues.Add(value);
+	}
+
+	// Active sound names are game thread data, they go to the last drained record
+	if(bHasDrained) CaptureActiveSounds(*CaptureWriter);
+}
+
+void UAudioProfilerSubsystem::DrainFlightRecorder() {
+	using namespace BachelorAudio::AudioProfiler;
+
+	EAudioProfilerTrigger trigger = EAudioProfilerTrigger::None;
+	FAudioProfilerSampleRecord record;
+	FAudioProfilerBookmark bookmark;
+	while(Sampler->TryDequeue(record)) {
+		while(ProfilingBookmarks->Peek(bookmark) && bookmark.Time <= record.Timestamp) {
+			ProfilingBookmarks->Dequeue(bookmark);
+			FlightRecorder->AddBookmark(bookmark);
+			// The recorder keeps name ids, the name is only looked up for the trace
+			if(BachelorAudio::AudioProfiler::Trace::IsEnabled()) {
+				BachelorAudio::AudioProfiler::Trace::OutputBookmark(ProfilingBookmarks->GetName(bookmark.NameId), bookmark.Time);
 			}
-			timestamp.ActiveSounds.Add(activeSound);
 		}
+
+		const EAudioProfilerTrigger fired = FlightRecorder->Add(record);
+		if(trigger == EAudioProfilerTrigger::None) trigger = fired;
 	}
-	
-	UE_LOG(LogAudioProfiler, Warning, TEXT("Timestamp added"));
 
-	ProfilingData.AudioProfilerData.Add(timestamp);
+	// Dumped after the drain, so the records around the trigger are part of the window
+	if(trigger != EAudioProfilerTrigger::None) DumpFlightRecorder(LexToString(trigger));
 }
 
-void UAudioProfilerSubsystem::ExportProfilingData() const {
-	if(ProfilingData.AudioProfilerData.Num() == 0) {
-		UE_LOG(LogAudioProfiler, Warning, TEXT("Profiling data is empty"));
-		return;
+void UAudioProfilerSubsystem::BindAudioDevice(const UWorld* World) {
+	AudioDevice = World->GetAudioDevice().GetAudioDevice();
+	if(AudioDevice != nullptr) {
+		ProfilingData.AudioProfilerHeader.SampleRate = AudioDevice->GetSampleRate();
+		ProfilingData.AudioProfilerHeader.MaxChannels = AudioDevice->GetMaxChannels();
+		ProfilingData.AudioProfilerHeader.MaxSources = AudioDevice->GetMaxSources();
+		ProfilingData.AudioProfilerHeader.BufferLength = AudioDevice->GetBufferLength();
+		ProfilingData.AudioProfilerHeader.NumBuffers = AudioDevice->GetNumBuffers();
+	}
+
+	ProfilingData.AudioProfilerHeader.Date = FDateTime::Now();
+	ProfilingData.AudioProfilerHeader.WorldName = World->GetName();
+}
+
+bool UAudioProfilerSubsystem::StartSampler(const UWorld* World, const float InInterval) {
+	ProfilingTimerDelegate = FTimerDelegate::CreateUObject(this, &UAudioProfilerSubsystem::DrainProfilingData);
+
+	if(ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost) {
+		bWasNodeRenderStatsEnabled = BachelorMetasound::FNodeRenderStats::IsEnabled();
+		BachelorMetasound::FNodeRenderStats::SetEnabled(true);
+	}
+
+	// Sampling runs on its own thread, so intervals below the frame time work and cost no frame time.
+	// The game thread only drains the ring, at least every MinDrainIntervalSeconds.
+	const float drainInterval = FMath::Max(InInterval, MinDrainIntervalSeconds);
+	const uint32 ringCapacity = static_cast<uint32>(FMath::Clamp(
+		FMath::CeilToDouble(drainInterval / InInterval * RingSlackDrains),
+		1.0,
+		static_cast<double>(MaxRingCapacity)
+		));
+
+	// The main submix listener is called on the audio render thread after every rendered buffer
+	if(AudioDevice != nullptr) {
+		if(!RenderTimer.IsValid()) {
+			RenderTimer = MakeUnique<BachelorAudio::AudioProfiler::FAudioProfilerRenderTimer>(
+				ProfilingData.AudioProfilerHeader.NumBuffers,
+				RenderTimerCapacity
+				);
+		}
+		RenderTimer->Reset();
+		AudioDevice->RegisterSubmixBufferListener(RenderTimer.Get());
+
+		// Replaces the analyzer of the audio mixer, whose results can not be read per interval
+		if(!OutputAnalyzer.IsValid()) {
+			OutputAnalyzer = MakeUnique<BachelorAudio::AudioProfiler::FAudioProfilerOutputAnalyzer>(RenderTimerCapacity);
+		}
+		OutputAnalyzer->Reset();
+		AudioDevice->RegisterSubmixBufferListener(OutputAnalyzer.Get());
+	}
+
+	Sampler = MakeUnique<BachelorAudio::AudioProfiler::FAudioProfilerSampler>(
+		AudioDevice,
+		InInterval,
+		ringCapacity,
+		ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost,
+		AudioDevice != nullptr ? RenderTimer.Get() : nullptr,
+		AudioDevice != nullptr ? OutputAnalyzer.Get() : nullptr
+		);
+	if(!Sampler->Start()) {
+		UE_CLOG(
+			ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Error,
+			LogAudioProfiler,
+			Error,
+			TEXT("Can not start the sampler thread")
+			);
+		if(AudioDevice != nullptr) {
+			AudioDevice->UnregisterSubmixBufferListener(RenderTimer.Get());
+			AudioDevice->UnregisterSubmixBufferListener(OutputAnalyzer.Get());
+		}
+		if(ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost) {
+			BachelorMetasound::FNodeRenderStats::SetEnabled(bWasNodeRenderStatsEnabled);
+		}
+		Sampler.Reset();
+		return false;
 	}
 
-	const FString& CSVFilePath = BuildSessionPath(TEXT(".csv"));
-	const FString& MDFilePath = BuildSessionPath(TEXT(".md"));
-	FString CSVContent = BuildCSVContent();
-	FFileHelper::SaveStringToFile(CSVContent, *CSVFilePath);
+	World->GetTimerManager().SetTimer(
+		ProfilingTimerHandle,
+		ProfilingTimerDelegate,
+		drainInterval,
+		true
+	);
+	return true;
+}
+
+void UAudioProfilerSubsystem::StopSampler(const UWorld* World) {
+	if(AudioDevice != nullptr && RenderTimer.IsValid()) {
+		AudioDevice->UnregisterSubmixBufferListener(RenderTimer.Get());
+		UE_CLOG(
+			RenderTimer->GetNumDropped() > 0 && ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
+			LogAudioProfiler,
+			Warning,
+			TEXT("Render timer dropped %lld buffers, the sampler read too slowly"),
+			RenderTimer->GetNumDropped()
+			);
+	}
+	if(AudioDevice != nullptr && OutputAnalyzer.IsValid()) {
+		AudioDevice->UnregisterSubmixBufferListener(OutputAnalyzer.Get());
+		UE_CLOG(
+			OutputAnalyzer->GetNumDropped() > 0 && ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
+			LogAudioProfiler,
+			Warning,
+			TEXT("Output analyzer dropped %lld buffers, the sampler read too slowly"),
+			OutputAnalyzer->GetNumDropped()
+			);
+	}
 
-	UE_LOG(LogAudioProfiler, Error, TEXT("Data written to %s"), *CSVFilePath);
+	if(Sampler.IsValid()) {
+		Sampler->Shutdown();
+		DrainProfilingData();
+		UE_CLOG(
+			Sampler->GetNumDropped() > 0 && ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
+			LogAudioProfiler,
+			Warning,
+			TEXT("Sampler dropped %lld records, the game thread drained too slowly"),
+			Sampler->GetNumDropped()
+			);
+		UE_CLOG(
+			ProfilingBookmarks->GetNumDropped() > 0 && ProfilingData.AudioProfilerSettings.DebugMode >= EAudioProfilerDebuggingType::Warning,
+			LogAudioProfiler,
+			Warning,
+			TEXT("Dropped %lld bookmarks, too many were added between two drains"),
+			ProfilingBookmarks->GetNumDropped()
+			);
+		Sampler.Reset();
+	}
 
-	FString MDHeader = BuildMDHeader(CSVFilePath);
-	FString MDContent = BuildMDContent(MDHeader);
-	FFileHelper::SaveStringToFile(MDContent, *MDFilePath);
+	// Restored independent of the world, the stats are process wide
+	if(ProfilingData.AudioProfilerSettings.bCaptureNodeRenderCost) {
+		BachelorMetasound::FNodeRenderStats::SetEnabled(bWasNodeRenderStatsEnabled);
+	}
 
-	UE_LOG(LogAudioProfiler, Error, TEXT("Report written to %s"), *CSVFilePath);
+	if(World != nullptr) World->GetTimerManager().ClearTimer(ProfilingTimerHandle);
+}
+
+void UAudioProfilerSubsystem::CaptureActiveSounds(BachelorAudio::AudioProfiler::FAudioProfilerCaptureWriter& InWriter) const {
+	if(AudioDevice == nullptr) return;
+
+	// Bound by reference, the list is read in place. Names are interned per sound object by the writer.
+	const TArray<FActiveSound*>& activeSounds = AudioDevice->GetActiveSounds();
+	for(const FActiveSound* sound : activeSounds) {
+		InWriter.AddSound(sound->GetSound(), sound->GetVolume());
+	}
+}
+
+void UAudioProfilerSubsystem::FinishExport() {
+	if(!CaptureWriter.IsValid()) return;
+
+	if(CaptureWriter->GetNumRecords() == 0) {
+		UE_LOG(LogAudioProfiler, Warning, TEXT("Profiling data is empty"));
+		CaptureWriter.Reset();
+		OnExportCompleted.Broadcast(false, FString(), FString(), FString());
+		return;
+	}
+
+	const FString capturePath = CaptureWriter->GetFilePath();
+	const FString csvFilePath = BuildSessionPath(TEXT(".csv"));
+	const FString mdFilePath = BuildSessionPath(TEXT(".md"));
+	TWeakObjectPtr<UAudioProfilerSubsystem> weakThis(this);
+	CaptureWriter->Finalize([weakThis, capturePath, csvFilePath, mdFilePath](const bool bCaptureWritten) {
+		// Still on the writer task, the reports are converted from the capture off the game thread.
+		// The records stay in the capture only, so memory does not grow with the session length.
+		const bool bSucceeded = bCaptureWritten && BachelorAudio::AudioProfiler::FAudioProfilerCaptureConverter::Convert(
+			capturePath,
+			csvFilePath,
+			mdFilePath
+			);
+
+		AsyncTask(ENamedThreads::GameThread, [weakThis, capturePath, csvFilePath, mdFilePath, bSucceeded]() {
+			UE_LOG(LogAudioProfiler, Log, TEXT("Data written to %s"), *csvFilePath);
+			UE_LOG(LogAudioProfiler, Log, TEXT("Report written to %s"), *mdFilePath);
+			UE_CLOG(!bSucceeded, LogAudioProfiler, Error, TEXT("Export of %s is incomplete"), *csvFilePath);
+			UAudioProfilerSubsystem* subsystem = weakThis.Get();
+			if(subsystem == nullptr) return;
+			subsystem->OnExportCompleted.Broadcast(bSucceeded, csvFilePath, mdFilePath, capturePath);
+		});
+	});
+
+	// The pending writer tasks keep the writer alive until the file is closed
+	CaptureWriter.Reset();
 }
 
 FString UAudioProfilerSubsystem::BuildSessionString(const FString& InSessionName) {
@@ -405,79 +796,3 @@ FString UAudioProfilerSubsystem::BuildSessionPath(
 
 	return filepath;
 }
-
-FString UAudioProfilerSubsystem::BuildCSVContent() const {
-	FString CSVContent = TEXT(
-		"Timestamp,AudioDeltaTime,AudioTime,DeltaTime,Framerate,CPUUsage,MemoryUsage,MasterVolume,Headroom,ActiveSoundCount,ActiveSoundNames\n"
-		);
-	for(const auto& data : ProfilingData.AudioProfilerData) {
-		FString ActiveSoundNamesStr;
-		for(const auto& sound : data.ActiveSounds) {
-			ActiveSoundNamesStr += sound.ActiveSoundName + TEXT(";");
-		}
-		ActiveSoundNamesStr.RemoveFromEnd(TEXT(";"));
-		CSVContent += FString::Printf(TEXT("%f,%f,%f,%f,%f,%f,%f,%f,%f,%d,%s\n"),
-			data.Timestamp,
-			data.CurrentAudioDelta,
-			data.CurrentAudioTime,
-			data.CurrentDelta,
-			data.Framerate,
-			data.CPUUsage,
-			data.MemoryUsageMB,
-			data.MasterVolumeLin,
-			data.Headroom,
-			data.ActiveSoundCount,
-			*ActiveSoundNamesStr
-		);
-	}
-	return CSVContent;
-}
-
-FString UAudioProfilerSubsystem::BuildMDHeader(const FString& CSVFilepath) const {
-	FString MDHeader = FString::Printf(TEXT("# %s\n\n"), *ProfilingData.AudioProfilerHeader.SessionName);
-	MDHeader += FString::Printf(TEXT("**Tester:** Markus Schramm\t **Date:** %s\n**Time:** %s\t\t**World:** %s\n"),
-		*ProfilingData.AudioProfilerHeader.Date.ToFormattedString(TEXT("%d.%m.%Y")),
-		*ProfilingData.AudioProfilerHeader.Date.ToFormattedString(TEXT("%H:%M:%S")),
-		*ProfilingData.AudioProfilerHeader.WorldName
-		);
-	MDHeader += FString::Printf(TEXT("**CSV Path:**\t%s\n"), *CSVFilepath);
-	MDHeader += FString::Printf(TEXT("**Sample Rate:**\t%d\n"), ProfilingData.AudioProfilerHeader.SampleRate);
-	MDHeader += FString::Printf(TEXT("**Max Channels:**\t%d\n"), ProfilingData.AudioProfilerHeader.MaxChannels);
-	MDHeader += FString::Printf(TEXT("**Max Sources:**\t%d\n"), ProfilingData.AudioProfilerHeader.MaxSources);
-	MDHeader += FString::Printf(TEXT("**Audio Buffer Length:**\t%d\n"), ProfilingData.AudioProfilerHeader.BufferLength);
-	MDHeader += FString::Printf(TEXT("**Num Audio Buffers:**\t%d\n"), ProfilingData.AudioProfilerHeader.NumBuffers);
-	MDHeader += FString::Printf(TEXT("**Num Source Workers:**\t%d\n"), ProfilingData.AudioProfilerHeader.NumSourceWorkers);
-	FString CSVFooter = TEXT("\n------------------\n\n**Profiling start**");
-	return MDHeader;
-}
-
-FString UAudioProfilerSubsystem::BuildMDContent(const FString& MDHeader) const {
-	FString MDContent = MDHeader;
-	MDContent += TEXT("\n## Profiling Data\n");
-	MDContent += TEXT("| Timestamp | AudioDeltaTime | AudioTime | DeltaTime | Framerate | CPUUsage | MemoryUsage | MasterVolume | Headroom | ActiveSoundCount | ActiveBookmarks |\n");
-	MDContent += TEXT("| --- | --- | --- | --- | --- | --- | --- | --- | --- | --- | --- |\n");
-	for(const auto& timestamp : ProfilingData.AudioProfilerData) {
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.Timestamp);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.CurrentAudioDelta);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.CurrentAudioTime);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.CurrentDelta);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.Framerate);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.CPUUsage);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.MemoryUsageMB);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.MasterVolumeLin);
-		MDContent += FString::Printf(TEXT("| %f "), timestamp.Headroom);
-		MDContent += FString::Printf(TEXT("| %d |"), timestamp.ActiveSoundCount);
-		if(timestamp.ActiveBookmarks.Num() > 0) {
-			int i = 0;
-			for(const auto& bookmark : timestamp.ActiveBookmarks) {
-				if(i == 0) 
-					MDContent += FString::Printf(TEXT("| %s |\n"), *bookmark);
-				else 
-					MDContent += FString::Printf(TEXT("|  |  |  |  |  |  |  |  |  |  | %s |\n"), *bookmark);
-			}
-		} else 
-			MDContent += TEXT("\n");
-	}
-	MDContent += TEXT("\n");
-	return MDContent;
-}
\ No newline at end of file
@@ -0,0 +1,143 @@
+﻿/**
+ * @file AudioProfilerCapture.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the binary capture of the audio profiler.
+ */
+
+#include "Capture/AudioProfilerCaptureConverter.h"
+#include "Capture/AudioProfilerCaptureReader.h"
+#include "Capture/AudioProfilerCaptureWriter.h"
+#include "Subsystems/AudioProfilerSampler.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
+
+using namespace BachelorAudio::AudioProfiler;
+
+namespace {
+    /** More than one chunk, the last one partially filled */
+    constexpr int32 NumTestRecords = Capture::RecordsPerChunk + 476;
+
+    /** Builds a deterministic record */
+    FAudioProfilerSampleRecord MakeRecord(const int32 InIndex) {
+        FAudioProfilerSampleRecord Record;
+        FMemory::Memzero(Record);
+        Record.Timestamp = 1000.0 + InIndex * 0.0005;
+        Record.CurrentDelta = 1.f / 60.f;
+        Record.CPUUsage = static_cast<float>(InIndex % 100);
+        Record.Headroom = 0.5f;
+        Record.ActiveSoundCount = InIndex % 7;
+        Record.FreeSourcesCount = 32 - InIndex % 7;
+        Record.bHasAudioDevice = true;
+        return Record;
+    }
+
+    /** Writes a capture of NumTestRecords records and waits until it is closed */
+    bool WriteTestCapture(const FString& InFilePath) {
+        FAudioProfilerHeaderModel Header;
+        Header.SessionName = TEXT("CaptureTest");
+        Header.WorldName = TEXT("TestWorld");
+        Header.SampleRate = 48000;
+
+        std::atomic<int32> Result{-1};
+        {
+            const TSharedRef<FAudioProfilerCaptureWriter, ESPMode::ThreadSafe> Writer
+                = MakeShared<FAudioProfilerCaptureWriter, ESPMode::ThreadSafe>(InFilePath, Header, 0.0005, false);
+            for (int32 i = 0; i < NumTestRecords; ++i) {
+                Writer->Add(MakeRecord(i));
+                if (i % 100 == 0) Writer->AddSound(FString::Printf(TEXT("Sound%d"), i % 3), 0.25f);
+                if (i == 10) Writer->AddBookmark(TEXT("Start"), 1000.004);
+            }
+            Writer->Finalize([&Result](const bool bSucceeded) { Result = bSucceeded ? 1 : 0; });
+        }
+
+        const double TimeoutSeconds = FPlatformTime::Seconds() + 10.0;
+        while (Result < 0 && FPlatformTime::Seconds() < TimeoutSeconds) FPlatformProcess::Sleep(0.01f);
+        return Result == 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerCaptureRoundTripTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerCapture.000_RoundTripTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerCaptureRoundTripTest::RunTest(const FString& Parameters) {
+    const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AudioProfilerTests"), TEXT("RoundTrip.apcap"));
+    if (!TestTrue(TEXT("Capture should be written"), WriteTestCapture(FilePath))) return false;
+
+    FAudioProfilerCaptureReader Reader;
+    if (!TestTrue(TEXT("Capture should open"), Reader.Open(FilePath))) return false;
+    TestEqual(TEXT("Header should count every record"), Reader.GetHeader().NumRecords, static_cast<uint32>(NumTestRecords));
+    TestEqual(TEXT("Records should be split into two chunks"), Reader.GetNumChunks(), 2);
+    TestEqual(TEXT("Session name should be interned"), Reader.GetHeaderModel().SessionName, FString(TEXT("CaptureTest")));
+
+    TArray<FAudioProfilerTimestampModel> Timestamps;
+    for (int32 i = 0; i < Reader.GetNumChunks(); ++i) {
+        TestTrue(TEXT("Chunk should decode"), Reader.ReadChunk(i, Timestamps));
+    }
+    if (!TestEqual(TEXT("Every record should be decoded"), Timestamps.Num(), NumTestRecords)) return false;
+
+    bool bIsEqual = true;
+    for (int32 i = 0; i < NumTestRecords; ++i) {
+        const FAudioProfilerSampleRecord Record = MakeRecord(i);
+        bIsEqual &= FMath::IsNearlyEqual(Timestamps[i].Timestamp, Record.Timestamp, 1.0e-6);
+        bIsEqual &= Timestamps[i].CPUUsage == Record.CPUUsage;
+        bIsEqual &= Timestamps[i].Headroom == Record.Headroom;
+        bIsEqual &= Timestamps[i].ActiveSoundCount == Record.ActiveSoundCount;
+        bIsEqual &= Timestamps[i].FreeSourcesCount == Record.FreeSourcesCount;
+        bIsEqual &= Timestamps[i].ActiveSounds.Num() == (i % 100 == 0 ? 1 : 0);
+    }
+    TestTrue(TEXT("Decoded records should equal the written ones"), bIsEqual);
+    TestEqual(TEXT("Sound names should be resolved"), Timestamps[200].ActiveSounds[0].ActiveSoundName, FString(TEXT("Sound2")));
+    TestEqual(TEXT("Bookmark should belong to its record"), Timestamps[10].ActiveBookmarks.Num(), 1);
+
+    IFileManager::Get().Delete(*FilePath);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerCaptureConvertTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerCapture.005_ConvertTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerCaptureConvertTest::RunTest(const FString& Parameters) {
+    const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AudioProfilerTests"));
+    const FString FilePath = FPaths::Combine(Directory, TEXT("Convert.apcap"));
+    const FString CSVFilePath = FPaths::Combine(Directory, TEXT("Convert.csv"));
+    const FString MDFilePath = FPaths::Combine(Directory, TEXT("Convert.md"));
+    if (!TestTrue(TEXT("Capture should be written"), WriteTestCapture(FilePath))) return false;
+
+    TestTrue(TEXT("Conversion should succeed"), FAudioProfilerCaptureConverter::Convert(FilePath, CSVFilePath, MDFilePath));
+
+    TArray<FString> CSVLines;
+    TestTrue(TEXT("CSV file should exist"), FFileHelper::LoadFileToStringArray(CSVLines, *CSVFilePath));
+    TestEqual(TEXT("CSV should hold the header and one line per record"), CSVLines.Num(), NumTestRecords + 1);
+
+    FString MDContent;
+    TestTrue(TEXT("Report should exist"), FFileHelper::LoadFileToString(MDContent, *MDFilePath));
+    TestTrue(TEXT("Report should start with the session name"), MDContent.StartsWith(TEXT("# CaptureTest")));
+    TestTrue(TEXT("Report should hold the bookmark"), MDContent.Contains(TEXT("Start: ")));
+
+    FAudioProfilerCaptureReader Reader;
+    TestFalse(TEXT("A missing capture should not open"), Reader.Open(Directory / TEXT("Missing.apcap")));
+
+    IFileManager::Get().Delete(*FilePath);
+    IFileManager::Get().Delete(*CSVFilePath);
+    IFileManager::Get().Delete(*MDFilePath);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
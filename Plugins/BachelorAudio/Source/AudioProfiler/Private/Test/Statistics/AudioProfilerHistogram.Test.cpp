@@ -0,0 +1,90 @@
+﻿/**
+ * @file AudioProfilerHistogram.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the streaming statistics of the audio profiler.
+ */
+
+#include "Statistics/AudioProfilerHistogram.h"
+#include "Statistics/AudioProfilerStatistics.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorAudio::AudioProfiler;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerHistogramPercentileTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerHistogram.000_PercentileTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerHistogramPercentileTest::RunTest(const FString& Parameters) {
+    FAudioProfilerHistogram Histogram;
+    TestEqual(TEXT("An empty histogram should report zero"), Histogram.GetPercentile(0.5), 0.0);
+
+    const SIZE_T AllocatedSize = sizeof(Histogram);
+    // 0.01 to 1000.00 in steps of 0.01
+    for (int32 i = 1; i <= 100000; ++i) Histogram.Record(i * 0.01);
+
+    auto IsWithinError = [](const double InValue, const double InExpected) {
+        return FMath::Abs(InValue - InExpected) <= InExpected / 128.0;
+    };
+    TestEqual(TEXT("Every value should be counted"), Histogram.GetNumValues(), static_cast<uint64>(100000));
+    TestTrue(TEXT("p50 should be within the relative error"), IsWithinError(Histogram.GetPercentile(0.5), 500.0));
+    TestTrue(TEXT("p90 should be within the relative error"), IsWithinError(Histogram.GetPercentile(0.9), 900.0));
+    TestTrue(TEXT("p99 should be within the relative error"), IsWithinError(Histogram.GetPercentile(0.99), 990.0));
+    TestTrue(TEXT("p99.9 should be within the relative error"), IsWithinError(Histogram.GetPercentile(0.999), 999.0));
+    TestEqual(TEXT("Max should be exact"), Histogram.GetMax(), 1000.0);
+    TestTrue(TEXT("Percentiles should never exceed the max"), Histogram.GetPercentile(1.0) <= Histogram.GetMax());
+    TestEqual(TEXT("Memory should not grow with the values"), sizeof(Histogram), AllocatedSize);
+
+    // Out of range values are clamped, the max stays exact
+    Histogram.Record(-5.0);
+    Histogram.Record(FAudioProfilerHistogram::MaxValue * 2.0);
+    TestEqual(TEXT("Large values should keep their max"), Histogram.GetMax(), FAudioProfilerHistogram::MaxValue * 2.0);
+
+    FAudioProfilerHistogram Other;
+    Other.Record(2.0);
+    Other.Merge(Histogram);
+    TestEqual(TEXT("Merge should add the values"), Other.GetNumValues(), Histogram.GetNumValues() + 1);
+
+    Histogram.Reset();
+    TestEqual(TEXT("Reset should remove every value"), Histogram.GetNumValues(), static_cast<uint64>(0));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerStatisticsSummaryTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerHistogram.005_SummaryTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerStatisticsSummaryTest::RunTest(const FString& Parameters) {
+    FAudioProfilerStatistics Statistics;
+    TestTrue(TEXT("An empty session should have no summary"), Statistics.BuildMDSummary().IsEmpty());
+
+    FAudioProfilerTimestampModel Timestamp;
+    Timestamp.CurrentDelta = 1.f / 60.f;
+    Timestamp.CPUUsage = 12.5f;
+    for (int32 i = 0; i < 1000; ++i) Statistics.Add(Timestamp);
+
+    TestEqual(TEXT("Frame delta should be counted in ms"),
+        Statistics.Get(EAudioProfilerStatistic::FrameDelta).GetMax(), 1000.0 / 60.0, 1.0e-3);
+    TestEqual(TEXT("Callback period should be skipped without timed callbacks"),
+        Statistics.Get(EAudioProfilerStatistic::CallbackPeriod).GetNumValues(), static_cast<uint64>(0));
+
+    const FString Summary = Statistics.BuildMDSummary();
+    TestTrue(TEXT("Summary should list the percentiles"), Summary.Contains(TEXT("| p50 | p90 | p99 | p99.9 | Max |")));
+    TestTrue(TEXT("Summary should list counted metrics"), Summary.Contains(TEXT("CPU Usage (%)")));
+    TestFalse(TEXT("Summary should skip metrics without values"), Summary.Contains(TEXT("Node Render Time")));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
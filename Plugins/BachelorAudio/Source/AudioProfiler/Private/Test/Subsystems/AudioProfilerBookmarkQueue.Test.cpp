@@ -0,0 +1,89 @@
+﻿/**
+ * @file AudioProfilerBookmarkQueue.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the bookmark queue of the audio profiler.
+ */
+
+#include "Subsystems/AudioProfilerBookmarkQueue.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorAudio::AudioProfiler;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerBookmarkQueueProducersTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerBookmarkQueue.000_ProducersTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerBookmarkQueueProducersTest::RunTest(const FString& Parameters) {
+    constexpr int32 NumProducers = 4;
+    constexpr int32 NumPerProducer = 200;
+    FAudioProfilerBookmarkQueue Queue(NumProducers * NumPerProducer);
+
+    TArray<uint32> NameIds;
+    for (int32 i = 0; i < NumProducers; ++i) {
+        NameIds.Add(Queue.InternName(FString::Printf(TEXT("Producer%d"), i)));
+    }
+    TestEqual(TEXT("A known name should keep its id"), Queue.InternName(TEXT("Producer1")), NameIds[1]);
+
+    // The time carries the sequence number of each producer
+    ParallelFor(NumProducers, [&Queue, &NameIds](const int32 Producer) {
+        for (int32 i = 0; i < NumPerProducer; ++i) Queue.Enqueue(NameIds[Producer], static_cast<double>(i));
+    });
+
+    int32 NumBookmarks = 0;
+    bool bIsOrdered = true;
+    TArray<double> LastTimes;
+    LastTimes.Init(-1.0, NumProducers);
+    FAudioProfilerBookmark Bookmark;
+    while (Queue.Dequeue(Bookmark)) {
+        const int32 Producer = NameIds.IndexOfByKey(Bookmark.NameId);
+        if (!TestTrue(TEXT("Bookmark should carry a known name"), Producer != INDEX_NONE)) return false;
+        bIsOrdered &= Bookmark.Time > LastTimes[Producer];
+        LastTimes[Producer] = Bookmark.Time;
+        ++NumBookmarks;
+    }
+
+    TestEqual(TEXT("Every bookmark should arrive"), NumBookmarks, NumProducers * NumPerProducer);
+    TestTrue(TEXT("Bookmarks of one producer should keep their order"), bIsOrdered);
+    TestEqual(TEXT("No bookmark should be dropped"), Queue.GetNumDropped(), 0ll);
+    TestEqual(TEXT("Names should resolve"), Queue.GetName(NameIds[2]), FString(TEXT("Producer2")));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerBookmarkQueueOverflowTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerBookmarkQueue.005_OverflowTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerBookmarkQueueOverflowTest::RunTest(const FString& Parameters) {
+    FAudioProfilerBookmarkQueue Queue(8);
+    const uint32 NameId = Queue.InternName(TEXT("Overflow"));
+
+    for (int32 i = 0; i < 10; ++i) Queue.Enqueue(NameId, 1.0 + i * 0.1);
+    TestEqual(TEXT("Bookmarks beyond the capacity should be counted as dropped"), Queue.GetNumDropped(), 2ll);
+
+    FAudioProfilerBookmark Bookmark;
+    TestTrue(TEXT("Peek should see the oldest bookmark"), Queue.Peek(Bookmark));
+    TestEqual(TEXT("Peek should keep full precision"), Bookmark.Time, 1.0);
+    TestTrue(TEXT("Dequeue should return the peeked bookmark"), Queue.Dequeue(Bookmark) && Bookmark.Time == 1.0);
+
+    // A freed slot takes the next bookmark
+    TestTrue(TEXT("A freed slot should be reused"), Queue.Enqueue(NameId, 2.0));
+    Queue.Empty();
+    TestFalse(TEXT("An emptied queue should hold nothing"), Queue.Peek(Bookmark));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,73 @@
+﻿/**
+ * @file AudioProfilerExportWriter.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the streaming export of the audio profiler.
+ */
+
+#include "Subsystems/AudioProfilerExportWriter.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+using namespace BachelorAudio::AudioProfiler;
+
+namespace {
+    /** Builds a timestamp with one node cost, one sound and optional bookmarks */
+    FAudioProfilerTimestampModel MakeTimestamp(const double InTimestamp, const int32 InNumBookmarks = 0) {
+        FAudioProfilerTimestampModel Timestamp;
+        Timestamp.Timestamp = InTimestamp;
+        Timestamp.ActiveSoundCount = 1;
+        Timestamp.ActiveSounds.AddDefaulted_GetRef().ActiveSoundName = TEXT("TestSound");
+        Timestamp.NodeCosts.AddDefaulted_GetRef().NodeClassName = TEXT("Volume");
+        for (int32 i = 0; i < InNumBookmarks; ++i) {
+            Timestamp.ActiveBookmarks.Add(FString::Printf(TEXT("Bookmark%d"), i));
+        }
+        return Timestamp;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerExportWriterStreamTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerExportWriter.000_StreamTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerExportWriterStreamTest::RunTest(const FString& Parameters) {
+    const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AudioProfilerTests"));
+    const FString CSVFilePath = FPaths::Combine(Directory, TEXT("ExportWriterTest.csv"));
+    const FString MDFilePath = FPaths::Combine(Directory, TEXT("ExportWriterTest.md"));
+
+    FAudioProfilerExportWriter Writer(CSVFilePath, MDFilePath);
+
+    // Two chunks, the second one with bookmarks
+    Writer.Append({ MakeTimestamp(1.0), MakeTimestamp(2.0) });
+    Writer.Append({ MakeTimestamp(3.0, 2) });
+    TestTrue(TEXT("Export should succeed"), Writer.Finalize(TEXT("# ExportWriterTest\n")));
+
+    TArray<FString> CSVLines;
+    TestTrue(TEXT("CSV file should exist"), FFileHelper::LoadFileToStringArray(CSVLines, *CSVFilePath));
+    TestEqual(TEXT("CSV should hold the header and one line per timestamp"), CSVLines.Num(), 4);
+    if (CSVLines.Num() == 4) {
+        TestTrue(TEXT("CSV header should hold the node cost columns"), CSVLines[0].Contains(TEXT("VolumeRenderTimeMs")));
+        TestTrue(TEXT("CSV rows should hold the sound names"), CSVLines[3].EndsWith(TEXT("TestSound")));
+    }
+
+    FString MDContent;
+    TestTrue(TEXT("Report should exist"), FFileHelper::LoadFileToString(MDContent, *MDFilePath));
+    TestTrue(TEXT("Report should start with its header"), MDContent.StartsWith(TEXT("# ExportWriterTest")));
+    TestTrue(TEXT("Report should hold the bookmarks"), MDContent.Contains(TEXT("Bookmark1")));
+    TestFalse(TEXT("Part file should be removed"), IFileManager::Get().FileExists(*(MDFilePath + TEXT(".part"))));
+
+    IFileManager::Get().Delete(*CSVFilePath);
+    IFileManager::Get().Delete(*MDFilePath);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,94 @@
+﻿/**
+ * @file AudioProfilerFlightRecorder.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the flight recorder of the audio profiler.
+ */
+
+#include "Subsystems/AudioProfilerFlightRecorder.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorAudio::AudioProfiler;
+
+namespace {
+    /** @return A quiet record without render timing at the given time */
+    FAudioProfilerSampleRecord MakeRecord(const double InTimestamp) {
+        FAudioProfilerSampleRecord Record;
+        FMemory::Memzero(Record);
+        Record.Timestamp = InTimestamp;
+        Record.CurrentDelta = 1.f / 60.f;
+        return Record;
+    }
+
+    /** @return Settings of a one second window sampled every 100 ms */
+    FAudioProfilerFlightRecorderSettings MakeSettings() {
+        FAudioProfilerFlightRecorderSettings Settings;
+        Settings.WindowSeconds = 1.f;
+        Settings.IntervalSeconds = 0.1f;
+        Settings.FrameSpikeThresholdMs = 50.f;
+        Settings.PeakThresholdDb = -1.f;
+        return Settings;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerFlightRecorderWindowTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerFlightRecorder.000_WindowTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerFlightRecorderWindowTest::RunTest(const FString& Parameters) {
+    FAudioProfilerFlightRecorder Recorder(MakeSettings());
+
+    // Ten records fill the window, one more is kept as node cost baseline
+    TestEqual(TEXT("Capacity should be the window and the baseline"), Recorder.GetCapacity(), 11);
+
+    for (int32 i = 0; i < 25; ++i) {
+        Recorder.Add(MakeRecord(i * 0.1));
+    }
+    TestEqual(TEXT("The window should not grow"), Recorder.Num(), 11);
+    TestTrue(TEXT("The oldest record should be overwritten"), FMath::IsNearlyEqual(Recorder.GetRecord(0).Timestamp, 1.4));
+    TestTrue(TEXT("The newest record should be kept"), FMath::IsNearlyEqual(Recorder.GetRecord(10).Timestamp, 2.4));
+
+    Recorder.Reset();
+    TestEqual(TEXT("Reset should forget every record"), Recorder.Num(), 0);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerFlightRecorderTriggerTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerFlightRecorder.005_TriggerTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerFlightRecorderTriggerTest::RunTest(const FString& Parameters) {
+    FAudioProfilerFlightRecorder Recorder(MakeSettings());
+
+    TestTrue(TEXT("A quiet record should fire no trigger"), Recorder.Add(MakeRecord(0.0)) == EAudioProfilerTrigger::None);
+
+    FAudioProfilerSampleRecord LateCallback = MakeRecord(0.1);
+    LateCallback.bHasRenderTiming = true;
+    LateCallback.RenderTiming.NumLateCallbacks = 1;
+    TestTrue(TEXT("A late callback should fire"), Recorder.Add(LateCallback) == EAudioProfilerTrigger::LateCallback);
+
+    FAudioProfilerSampleRecord Spike = MakeRecord(0.2);
+    Spike.CurrentDelta = 0.1f;
+    TestTrue(TEXT("Triggers within the window should not fire again"), Recorder.Add(Spike) == EAudioProfilerTrigger::None);
+
+    Spike.Timestamp = 1.2;
+    TestTrue(TEXT("A frame spike after the window should fire"), Recorder.Add(Spike) == EAudioProfilerTrigger::FrameSpike);
+
+    FAudioProfilerSampleRecord Peak = MakeRecord(2.3);
+    Peak.bHasOutputAnalysis = true;
+    Peak.OutputAnalysis.TruePeakDb = -0.5f;
+    TestTrue(TEXT("A peak above -1 dBFS should fire"), Recorder.Add(Peak) == EAudioProfilerTrigger::HeadroomBreach);
+    return true;
+}
+
+#endif
@@ -0,0 +1,95 @@
+﻿/**
+ * @file AudioProfilerOutputAnalyzer.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the output analyzer of the audio profiler.
+ */
+
+#include "Subsystems/AudioProfilerOutputAnalyzer.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorAudio::AudioProfiler;
+
+namespace {
+    constexpr int32 TestSampleRate = 48000;
+
+    constexpr int32 TestNumFrames = 480;
+
+    constexpr int32 TestNumChannels = 2;
+
+    /**
+     * Renders seconds of a stereo sine in buffers of TestNumFrames.
+     * @param InAnalyzer Analyzer receiving the buffers.
+     * @param InFrequency Frequency of the sine in Hz.
+     * @param InAmplitude Amplitude of the sine, linear.
+     * @param InSeconds Seconds to render.
+     */
+    void RenderSine(FAudioProfilerOutputAnalyzer& InAnalyzer, const float InFrequency, const float InAmplitude, const float InSeconds) {
+        TArray<float> Buffer;
+        Buffer.SetNumUninitialized(TestNumFrames * TestNumChannels);
+        const int32 NumBuffers = FMath::CeilToInt32(InSeconds * TestSampleRate / TestNumFrames);
+        int64 Frame = 0;
+        for (int32 i = 0; i < NumBuffers; ++i) {
+            for (int32 j = 0; j < TestNumFrames; ++j, ++Frame) {
+                const float Sample = InAmplitude * FMath::Sin(2.0 * PI * InFrequency * Frame / TestSampleRate);
+                Buffer[j * TestNumChannels] = Sample;
+                Buffer[j * TestNumChannels + 1] = Sample;
+            }
+            InAnalyzer.AddBuffer(Buffer.GetData(), TestNumFrames, TestNumChannels, TestSampleRate);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerOutputAnalyzerSineTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerOutputAnalyzer.000_SineTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerOutputAnalyzerSineTest::RunTest(const FString& Parameters) {
+    FAudioProfilerOutputAnalyzer Analyzer(1024);
+
+    // Long enough to fill the 3 second loudness window
+    RenderSine(Analyzer, 997.f, 1.f, 4.f);
+
+    FAudioProfilerOutputAnalysis Analysis;
+    TestTrue(TEXT("Rendered buffers should be summarized"), Analyzer.Summarize(Analysis));
+    TestEqual(TEXT("RMS of a full scale sine should be -3 dBFS"), Analysis.RmsDb, -3.01f, 0.05f);
+    TestEqual(TEXT("True peak of a full scale sine should be 0 dBTP"), Analysis.TruePeakDb, 0.f, 0.1f);
+    // BS.1770 calibrates a full scale 997 Hz sine in both front channels to 0 LUFS
+    TestEqual(TEXT("Loudness of a stereo full scale sine should be 0 LUFS"), Analysis.ShortTermLufs, 0.f, 0.2f);
+    TestTrue(TEXT("The sine should fall into the 500 Hz band"), Analysis.SpectrumDb[3] > Analysis.SpectrumDb[1] + 40.f);
+
+    TestFalse(TEXT("A summary should remove its buffers"), Analyzer.Summarize(Analysis));
+    TestEqual(TEXT("No buffers should read as silence"), Analysis.RmsDb, MinLevelDb);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerOutputAnalyzerSilenceTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerOutputAnalyzer.005_SilenceTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerOutputAnalyzerSilenceTest::RunTest(const FString& Parameters) {
+    FAudioProfilerOutputAnalyzer Analyzer(1024);
+    RenderSine(Analyzer, 997.f, 0.f, 1.f);
+
+    FAudioProfilerOutputAnalysis Analysis;
+    Analyzer.Summarize(Analysis);
+    TestEqual(TEXT("Silence should have the lowest level"), Analysis.RmsDb, MinLevelDb);
+    TestEqual(TEXT("Silence should have the lowest peak"), Analysis.TruePeakDb, MinLevelDb);
+    TestEqual(TEXT("Silence should have the lowest loudness"), Analysis.ShortTermLufs, MinLevelDb);
+    for (int32 Band = 0; Band < NumSpectrumBands; ++Band) {
+        TestEqual(TEXT("Silent bands should have the lowest level"), Analysis.SpectrumDb[Band], MinLevelDb);
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,98 @@
+﻿/**
+ * @file AudioProfilerRenderTimer.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the render timer of the audio profiler.
+ */
+
+#include "Subsystems/AudioProfilerRenderTimer.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorAudio::AudioProfiler;
+
+namespace {
+    constexpr int32 TestSampleRate = 48000;
+
+    /** 480 frames are 10 ms of audio */
+    constexpr int32 TestNumFrames = 480;
+
+    /** @return Cycles of the given milliseconds */
+    uint64 MillisecondsToCycles(const double InMilliseconds) {
+        return static_cast<uint64>(InMilliseconds / 1000.0 / FPlatformTime::GetSecondsPerCycle64());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerRenderTimerSummaryTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerRenderTimer.000_SummaryTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerRenderTimerSummaryTest::RunTest(const FString& Parameters) {
+    // Two queued buffers leave 10 ms of slack
+    FAudioProfilerRenderTimer Timer(2, 256);
+
+    uint64 Cycles = MillisecondsToCycles(1000.0);
+    Timer.AddBuffer(Cycles, TestNumFrames, TestSampleRate);
+    for (int32 i = 0; i < 100; ++i) {
+        Cycles += MillisecondsToCycles(10.0);
+        Timer.AddBuffer(Cycles, TestNumFrames, TestSampleRate);
+    }
+    // 15 ms late uses up the slack and starves the device
+    Cycles += MillisecondsToCycles(25.0);
+    Timer.AddBuffer(Cycles, TestNumFrames, TestSampleRate);
+
+    FAudioProfilerRenderTiming Timing;
+    Timer.Summarize(Timing);
+    TestEqual(TEXT("The first buffer should only start the clock"), Timing.NumCallbacks, 101);
+    TestEqual(TEXT("The late buffer should be a late callback"), Timing.NumLateCallbacks, 1);
+    TestTrue(TEXT("Median should be the buffer length"), FMath::IsNearlyEqual(Timing.PeriodP50Ms, 10.f, 0.01f));
+    TestTrue(TEXT("Max should be the late buffer"), FMath::IsNearlyEqual(Timing.PeriodMaxMs, 25.f, 0.01f));
+    TestTrue(TEXT("Buffer length should be the audio length of a buffer"), FMath::IsNearlyEqual(Timing.BufferLengthMs, 10.f, 0.01f));
+
+    Timer.Summarize(Timing);
+    TestEqual(TEXT("A summary should remove its buffers"), Timing.NumCallbacks, 0);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerRenderTimerSlackTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerRenderTimer.005_SlackTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerRenderTimerSlackTest::RunTest(const FString& Parameters) {
+    // Three queued buffers absorb a single render 15 ms late
+    FAudioProfilerRenderTimer Timer(3, 256);
+
+    uint64 Cycles = MillisecondsToCycles(1000.0);
+    Timer.AddBuffer(Cycles, TestNumFrames, TestSampleRate);
+    Cycles += MillisecondsToCycles(25.0);
+    Timer.AddBuffer(Cycles, TestNumFrames, TestSampleRate);
+
+    FAudioProfilerRenderTiming Timing;
+    Timer.Summarize(Timing);
+    TestEqual(TEXT("Queued buffers should absorb a late callback"), Timing.NumLateCallbacks, 0);
+
+    // The gap between two sessions is no late callback
+    Timer.Reset();
+    Cycles += MillisecondsToCycles(5000.0);
+    Timer.AddBuffer(Cycles, TestNumFrames, TestSampleRate);
+    Cycles += MillisecondsToCycles(10.0);
+    Timer.AddBuffer(Cycles, TestNumFrames, TestSampleRate);
+
+    Timer.Summarize(Timing);
+    TestEqual(TEXT("Reset should restart the clock"), Timing.NumCallbacks, 1);
+    TestEqual(TEXT("Reset should not count the gap as late callback"), Timing.NumLateCallbacks, 0);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,75 @@
+﻿/**
+ * @file AudioProfilerSampler.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the sampler thread of the audio profiler.
+ */
+
+#include "Subsystems/AudioProfilerSampler.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorAudio::AudioProfiler;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerSamplerSampleTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerSampler.000_SampleTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerSamplerSampleTest::RunTest(const FString& Parameters) {
+    // 1 ms is far below the frame time, which the former game thread timer could not reach
+    FAudioProfilerSampler Sampler(nullptr, 0.001, 1024, false);
+    if (!TestTrue(TEXT("Sampler thread should start"), Sampler.Start())) return false;
+
+    FPlatformProcess::Sleep(0.1f);
+    Sampler.Shutdown();
+
+    int32 NumRecords = 0;
+    double LastTimestamp = 0.0;
+    bool bIsMonotonic = true;
+    FAudioProfilerSampleRecord Record;
+    while (Sampler.TryDequeue(Record)) {
+        bIsMonotonic &= Record.Timestamp > LastTimestamp;
+        LastTimestamp = Record.Timestamp;
+        ++NumRecords;
+    }
+
+    TestTrue(TEXT("Sampler should take more samples than game frames would allow"), NumRecords > 10);
+    TestTrue(TEXT("Timestamps should increase"), bIsMonotonic);
+    TestEqual(TEXT("No record should be dropped"), Sampler.GetNumDropped(), 0ll);
+    TestFalse(TEXT("Records without device should say so"), Record.bHasAudioDevice);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerSamplerOverflowTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerSampler.005_OverflowTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerSamplerOverflowTest::RunTest(const FString& Parameters) {
+    // A ring of 7 records that is never drained while sampling
+    FAudioProfilerSampler Sampler(nullptr, 0.0005, 7, false);
+    if (!TestTrue(TEXT("Sampler thread should start"), Sampler.Start())) return false;
+
+    FPlatformProcess::Sleep(0.05f);
+    Sampler.Shutdown();
+
+    int32 NumRecords = 0;
+    FAudioProfilerSampleRecord Record;
+    while (Sampler.TryDequeue(Record)) ++NumRecords;
+
+    TestEqual(TEXT("A full ring should keep its oldest records"), NumRecords, 7);
+    TestTrue(TEXT("Records beyond the capacity should be counted as dropped"), Sampler.GetNumDropped() > 0);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,57 @@
+﻿/**
+ * @file AudioProfilerTrace.Test.cpp
+ * @author Markus Schramm
+ * @brief Contains atomic unit tests for the Insights trace events of the audio profiler.
+ */
+
+#include "Trace/AudioProfilerTrace.h"
+
+#if WITH_AUTOMATION_TESTS && UE_TRACE_ENABLED
+
+#include "Misc/AutomationTest.h"
+#include "Subsystems/AudioProfilerSampler.h"
+#include "Trace/Trace.h"
+
+using namespace BachelorAudio::AudioProfiler;
+namespace ProfilerTrace = BachelorAudio::AudioProfiler::Trace;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAudioProfilerTraceChannelTest,
+    "prototype.BachelorAudio.AudioProfiler.AudioProfilerTrace.000_ChannelTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAudioProfilerTraceChannelTest::RunTest(const FString& Parameters) {
+    const bool bWasEnabled = ProfilerTrace::IsEnabled();
+
+    FAudioProfilerSampleRecord Record;
+    FMemory::Memzero(Record);
+    Record.Timestamp = FPlatformTime::Seconds();
+    Record.bHasNodeTotals = true;
+    FAudioProfilerSampleRecord Previous = Record;
+    Record.NodeTotals[0].Cycles = 1000;
+    Record.NodeTotals[0].NumExecutes = 2;
+    Record.NodeTotals[0].NumSamples = 512;
+
+    UE::Trace::ToggleChannel(TEXT("AudioProfiler"), false);
+    TestFalse(TEXT("A disabled channel should read as disabled"), ProfilerTrace::IsEnabled());
+    // Disabled emission must be a no-op
+    ProfilerTrace::OutputRecord(Record);
+    ProfilerTrace::OutputBookmark(TEXT("Test"), Record.Timestamp);
+
+    UE::Trace::ToggleChannel(TEXT("AudioProfiler"), true);
+    TestTrue(TEXT("An enabled channel should read as enabled"), ProfilerTrace::IsEnabled());
+    ProfilerTrace::OutputNodeClasses();
+    ProfilerTrace::OutputRecord(Record);
+    ProfilerTrace::OutputNodeCosts(Record, Previous.NodeTotals);
+    ProfilerTrace::OutputBookmark(TEXT("Test"), Record.Timestamp - 1.0);
+    // A bookmark from before the cycle counter started must not wrap around
+    ProfilerTrace::OutputBookmark(TEXT("Test"), -1.0e9);
+
+    UE::Trace::ToggleChannel(TEXT("AudioProfiler"), bWasEnabled);
+    return true;
+}
+
+#endif
@@ -0,0 +1,164 @@
+﻿/**
+ * @file AudioProfilerTrace.cpp
+ * @author Markus Schramm
+ */
+
+#include "AudioProfilerTrace.h"
+
+#include "ProfilingDebugging/CountersTrace.h"
+#include "Subsystems/AudioProfilerSampler.h"
+#include "Trace/Trace.h"
+
+#if UE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL(AudioProfilerChannel)
+
+UE_TRACE_EVENT_BEGIN(AudioProfiler, Record)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(float, AudioDelta)
+	UE_TRACE_EVENT_FIELD(float, DeltaTime)
+	UE_TRACE_EVENT_FIELD(float, CPUUsage)
+	UE_TRACE_EVENT_FIELD(float, MemoryUsageMB)
+	UE_TRACE_EVENT_FIELD(float, MasterVolume)
+	UE_TRACE_EVENT_FIELD(float, Headroom)
+	UE_TRACE_EVENT_FIELD(int32, ActiveSoundCount)
+	UE_TRACE_EVENT_FIELD(int32, FreeSourcesCount)
+	UE_TRACE_EVENT_FIELD(float, CallbackPeriodP50Ms)
+	UE_TRACE_EVENT_FIELD(float, CallbackPeriodP99Ms)
+	UE_TRACE_EVENT_FIELD(float, CallbackPeriodMaxMs)
+	UE_TRACE_EVENT_FIELD(float, BufferLengthMs)
+	UE_TRACE_EVENT_FIELD(int32, CallbackCount)
+	UE_TRACE_EVENT_FIELD(int32, LateCallbackCount)
+	UE_TRACE_EVENT_FIELD(float, OutputRmsDb)
+	UE_TRACE_EVENT_FIELD(float, OutputTruePeakDb)
+	UE_TRACE_EVENT_FIELD(float, OutputLoudnessLUFS)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AudioProfiler, NodeClass, NoSync|Important)
+	UE_TRACE_EVENT_FIELD(uint8, Id)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AudioProfiler, NodeCost)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint8, Id)
+	UE_TRACE_EVENT_FIELD(uint64, Cycles)
+	UE_TRACE_EVENT_FIELD(uint32, NumExecutes)
+	UE_TRACE_EVENT_FIELD(uint32, NumSamples)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AudioProfiler, Bookmark)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+#endif
+
+#if COUNTERSTRACE_ENABLED
+
+TRACE_DECLARE_FLOAT_COUNTER(AudioProfilerCPUUsage, TEXT("AudioProfiler/CPUUsage"));
+TRACE_DECLARE_INT_COUNTER(AudioProfilerActiveSounds, TEXT("AudioProfiler/ActiveSoundCount"));
+TRACE_DECLARE_FLOAT_COUNTER(AudioProfilerCallbackPeriodMax, TEXT("AudioProfiler/CallbackPeriodMaxMs"));
+TRACE_DECLARE_INT_COUNTER(AudioProfilerLateCallbacks, TEXT("AudioProfiler/LateCallbacks"));
+TRACE_DECLARE_FLOAT_COUNTER(AudioProfilerTruePeak, TEXT("AudioProfiler/OutputTruePeakDb"));
+TRACE_DECLARE_FLOAT_COUNTER(AudioProfilerLoudness, TEXT("AudioProfiler/OutputLoudnessLUFS"));
+
+#endif
+
+namespace BachelorAudio::AudioProfiler::Trace {
+	bool IsEnabled() {
+#if UE_TRACE_ENABLED
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(AudioProfilerChannel);
+#else
+		return false;
+#endif
+	}
+
+	void OutputNodeClasses() {
+#if UE_TRACE_ENABLED
+		if(!IsEnabled()) return;
+
+		using namespace BachelorMetasound;
+		for(int32 i = 0; i < static_cast<int32>(ENodeRenderClass::Num); ++i) {
+			const TCHAR* name = LexToString(static_cast<ENodeRenderClass>(i));
+			UE_TRACE_LOG(AudioProfiler, NodeClass, AudioProfilerChannel)
+				<< NodeClass.Id(static_cast<uint8>(i))
+				<< NodeClass.Name(name, FCString::Strlen(name));
+		}
+#endif
+	}
+
+	void OutputRecord(const FAudioProfilerSampleRecord& InRecord) {
+#if UE_TRACE_ENABLED
+		if(!IsEnabled()) return;
+
+		UE_TRACE_LOG(AudioProfiler, Record, AudioProfilerChannel)
+			<< Record.Cycle(FPlatformTime::Cycles64())
+			<< Record.AudioDelta(InRecord.CurrentAudioDelta)
+			<< Record.DeltaTime(InRecord.CurrentDelta)
+			<< Record.CPUUsage(InRecord.CPUUsage)
+			<< Record.MemoryUsageMB(InRecord.MemoryUsageMB)
+			<< Record.MasterVolume(InRecord.MasterVolumeLin)
+			<< Record.Headroom(InRecord.Headroom)
+			<< Record.ActiveSoundCount(InRecord.ActiveSoundCount)
+			<< Record.FreeSourcesCount(InRecord.FreeSourcesCount)
+			<< Record.CallbackPeriodP50Ms(InRecord.RenderTiming.PeriodP50Ms)
+			<< Record.CallbackPeriodP99Ms(InRecord.RenderTiming.PeriodP99Ms)
+			<< Record.CallbackPeriodMaxMs(InRecord.RenderTiming.PeriodMaxMs)
+			<< Record.BufferLengthMs(InRecord.RenderTiming.BufferLengthMs)
+			<< Record.CallbackCount(InRecord.RenderTiming.NumCallbacks)
+			<< Record.LateCallbackCount(InRecord.RenderTiming.NumLateCallbacks)
+			<< Record.OutputRmsDb(InRecord.bHasOutputAnalysis ? InRecord.OutputAnalysis.RmsDb : MinLevelDb)
+			<< Record.OutputTruePeakDb(InRecord.bHasOutputAnalysis ? InRecord.OutputAnalysis.TruePeakDb : MinLevelDb)
+			<< Record.OutputLoudnessLUFS(InRecord.bHasOutputAnalysis ? InRecord.OutputAnalysis.ShortTermLufs : MinLevelDb);
+#endif
+
+#if COUNTERSTRACE_ENABLED
+		if(!IsEnabled()) return;
+
+		TRACE_COUNTER_SET(AudioProfilerCPUUsage, InRecord.CPUUsage);
+		TRACE_COUNTER_SET(AudioProfilerActiveSounds, InRecord.ActiveSoundCount);
+		if(InRecord.bHasRenderTiming) {
+			TRACE_COUNTER_SET(AudioProfilerCallbackPeriodMax, InRecord.RenderTiming.PeriodMaxMs);
+			TRACE_COUNTER_SET(AudioProfilerLateCallbacks, InRecord.RenderTiming.NumLateCallbacks);
+		}
+		if(InRecord.bHasOutputAnalysis) {
+			TRACE_COUNTER_SET(AudioProfilerTruePeak, InRecord.OutputAnalysis.TruePeakDb);
+			TRACE_COUNTER_SET(AudioProfilerLoudness, InRecord.OutputAnalysis.ShortTermLufs);
+		}
+#endif
+	}
+
+	void OutputNodeCosts(const FAudioProfilerSampleRecord& InRecord, const BachelorMetasound::FNodeRenderStatsSnapshot* InPreviousTotals) {
+#if UE_TRACE_ENABLED
+		if(!IsEnabled() || !InRecord.bHasNodeTotals) return;
+
+		const uint64 cycle = FPlatformTime::Cycles64();
+		for(int32 i = 0; i < static_cast<int32>(BachelorMetasound::ENodeRenderClass::Num); ++i) {
+			const BachelorMetasound::FNodeRenderStatsSnapshot& totals = InRecord.NodeTotals[i];
+			// Idle node classes would only add empty events
+			if(totals.NumExecutes == InPreviousTotals[i].NumExecutes) continue;
+			UE_TRACE_LOG(AudioProfiler, NodeCost, AudioProfilerChannel)
+				<< NodeCost.Cycle(cycle)
+				<< NodeCost.Id(static_cast<uint8>(i))
+				<< NodeCost.Cycles(totals.Cycles - InPreviousTotals[i].Cycles)
+				<< NodeCost.NumExecutes(static_cast<uint32>(totals.NumExecutes - InPreviousTotals[i].NumExecutes))
+				<< NodeCost.NumSamples(static_cast<uint32>(totals.NumSamples - InPreviousTotals[i].NumSamples));
+		}
+#endif
+	}
+
+	void OutputBookmark(const FString& InName, const double InTime) {
+#if UE_TRACE_ENABLED
+		if(!IsEnabled()) return;
+
+		// Bookmarks are traced when drained, moved back to the cycle they were added at
+		const uint64 now = FPlatformTime::Cycles64();
+		const uint64 ageCycles = static_cast<uint64>(
+			FMath::Max(FPlatformTime::Seconds() - InTime, 0.0) / FPlatformTime::GetSecondsPerCycle64());
+		UE_TRACE_LOG(AudioProfiler, Bookmark, AudioProfilerChannel)
+			<< Bookmark.Cycle(now - FMath::Min(ageCycles, now))
+			<< Bookmark.Name(*InName, InName.Len());
+#endif
+	}
+}
@@ -0,0 +1,55 @@
+﻿/**
+ * @file AudioProfilerTrace.h
+ * @author Markus Schramm
+ * @brief Emits the audio profiler data as Unreal Insights trace events.
+ *
+ * The events go to the "AudioProfiler" trace channel, enabled with -trace=default,AudioProfiler
+ * or the Trace.Enable console command. Every event carries the cycle counter it was taken at,
+ * so the audio metrics line up with the CPU and GPU timelines of the same trace:
+ * - AudioProfiler.Record, the metrics of every sample
+ * - AudioProfiler.NodeClass, the name of a node class id, important and sent once per session
+ * - AudioProfiler.NodeCost, the render cost of a node class within one interval
+ * - AudioProfiler.Bookmark, a bookmark at the time it was added
+ * The main metrics are set as AudioProfiler counters too, which Insights shows without an analyzer.
+ * Every function first checks the channel, a disabled channel costs a single branch.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NodeRenderStats.h"
+
+namespace BachelorAudio::AudioProfiler {
+	struct FAudioProfilerSampleRecord;
+}
+
+namespace BachelorAudio::AudioProfiler::Trace {
+	/** @return Whether the AudioProfiler trace channel is enabled, false if tracing is compiled out */
+	bool IsEnabled();
+
+	/**
+	 * Emits the names of all node classes. Call whenever the channel was enabled since the last call,
+	 * node cost events refer to the classes by id.
+	 */
+	void OutputNodeClasses();
+
+	/**
+	 * Emits a sampled record and sets the counters. Any thread.
+	 * @param InRecord The record, just sampled.
+	 */
+	void OutputRecord(const FAudioProfilerSampleRecord& InRecord);
+
+	/**
+	 * Emits the render cost of every node class since the previous record. Any thread.
+	 * @param InRecord The record with node totals, just sampled.
+	 * @param InPreviousTotals Node totals of the previous record, one per node class.
+	 */
+	void OutputNodeCosts(const FAudioProfilerSampleRecord& InRecord, const BachelorMetasound::FNodeRenderStatsSnapshot* InPreviousTotals);
+
+	/**
+	 * Emits a bookmark at the time it was added. Any thread.
+	 * @param InName Name of the bookmark.
+	 * @param InTime Platform time the bookmark was added at, see FPlatformTime::Seconds.
+	 */
+	void OutputBookmark(const FString& InName, const double InTime);
+}
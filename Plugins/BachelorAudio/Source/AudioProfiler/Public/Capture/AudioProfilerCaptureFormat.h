@@ -0,0 +1,178 @@
+﻿/**
+ * @file AudioProfilerCaptureFormat.h
+ * @author Markus Schramm
+ * @brief Layout of the binary capture file of the audio profiler.
+ *
+ * A capture file holds, in this order:
+ * - FAudioProfilerCaptureHeader at offset 0
+ * - chunks of up to RecordsPerChunk records, each a FAudioProfilerCaptureChunkHeader followed by its columns
+ * - the chunk table, one uint64 file offset per chunk
+ * - the node class table, one string id per node class
+ * - the string table, see FAudioProfilerCaptureStringTable
+ *
+ * Every section and column starts 8 byte aligned and holds fixed width little-endian values,
+ * so a mapped file is read in place. Within a chunk the columns of one metric are contiguous:
+ * - uint32 TimestampDeltaMicroseconds[N], microseconds since the previous record, 0 for the first
+ * - float CurrentAudioDelta, CurrentAudioTime, CurrentDelta, CPUUsage, MemoryUsageMB, MasterVolumeLin, Headroom,
+ *   CallbackPeriodP50Ms, CallbackPeriodP99Ms, CallbackPeriodMaxMs, BufferLengthMs,
+ *   OutputRmsDb, OutputTruePeakDb, OutputLoudnessLufs, OutputSpectrumDb of 8 bands [N] each
+ * - int32 ActiveSoundCountDelta[N], FreeSourcesCountDelta[N], CallbackCountDelta[N], LateCallbackCountDelta[N],
+ *   change since the previous record, absolute for the first
+ * - per node class: uint64 CyclesDelta[N], uint32 NumExecutesDelta[N], uint32 NumSamplesDelta[N], cost of the interval
+ * - uint32 SoundBegin[N + 1], FAudioProfilerCaptureSound Sounds[NumSounds]
+ * - uint32 BookmarkBegin[N + 1], FAudioProfilerCaptureBookmark Bookmarks[NumBookmarks]
+ * Sounds and bookmarks of record i are the entries from Begin[i] to Begin[i + 1].
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace BachelorAudio::AudioProfiler::Capture {
+	/** Identifies a capture file, "APCP" */
+	constexpr uint32 Magic = 0x50435041;
+
+	/** Version of the layout described in this file */
+	constexpr uint32 Version = 3;
+
+	/** Records per chunk, a chunk is written at once */
+	constexpr uint32 RecordsPerChunk = 1024;
+
+	/** Number of float metric columns of a chunk */
+	constexpr int32 NumFloatColumns = 22;
+
+	/** Index of the first float column of the output spectrum bands */
+	constexpr int32 FirstSpectrumColumn = 14;
+
+	/** Number of int32 metric columns of a chunk */
+	constexpr int32 NumIntColumns = 4;
+
+	/** String id of no string */
+	constexpr uint32 InvalidStringId = MAX_uint32;
+
+	/**
+	 * @struct FAudioProfilerCaptureHeader
+	 * @brief Header at the start of a capture file
+	 * @details Offsets and counts are zero until the capture is finalized.
+	 */
+	struct FAudioProfilerCaptureHeader {
+		uint32 Magic = Capture::Magic;
+		uint32 Version = Capture::Version;
+
+		/** Number of records in all chunks */
+		uint32 NumRecords = 0;
+
+		/** Number of chunks */
+		uint32 NumChunks = 0;
+
+		/** Number of node classes with cost columns, zero if node costs were not captured */
+		uint32 NumNodeClasses = 0;
+
+		/** Records per full chunk */
+		uint32 RecordsPerChunk = Capture::RecordsPerChunk;
+
+		/** File offset of the chunk table */
+		uint64 ChunkTableOffset = 0;
+
+		/** File offset of the node class table */
+		uint64 NodeClassTableOffset = 0;
+
+		/** File offset of the string table */
+		uint64 StringTableOffset = 0;
+
+		/** Platform time of the first record in seconds, timestamps are deltas to it */
+		double FirstTimestamp = 0.0;
+
+		/** Seconds per cycle of the capturing machine, converts node cost cycles */
+		double SecondsPerCycle = 0.0;
+
+		/** Capture interval in seconds */
+		double Interval = 0.0;
+
+		/** Session start, FDateTime ticks */
+		int64 DateTicks = 0;
+
+		/** String id of the session name */
+		uint32 SessionNameId = InvalidStringId;
+
+		/** String id of the world name */
+		uint32 WorldNameId = InvalidStringId;
+
+		int32 SampleRate = 0;
+		int32 MaxChannels = 0;
+		int32 MaxSources = 0;
+		int32 BufferLength = 0;
+		int32 NumBuffers = 0;
+		int32 NumSourceWorkers = 0;
+	};
+
+	static_assert(sizeof(FAudioProfilerCaptureHeader) == 112, "Capture header layout changed, bump the version");
+
+	/**
+	 * @struct FAudioProfilerCaptureChunkHeader
+	 * @brief Header in front of the columns of a chunk
+	 */
+	struct FAudioProfilerCaptureChunkHeader {
+		/** Number of records in the chunk */
+		uint32 NumRecords = 0;
+
+		/** Number of sound entries of all records */
+		uint32 NumSounds = 0;
+
+		/** Number of bookmark entries of all records */
+		uint32 NumBookmarks = 0;
+
+		uint32 Reserved = 0;
+
+		/** Microseconds from the first record of the capture to the first record of the chunk */
+		uint64 FirstTimestampMicroseconds = 0;
+	};
+
+	static_assert(sizeof(FAudioProfilerCaptureChunkHeader) == 24, "Chunk header layout changed, bump the version");
+
+	/**
+	 * @struct FAudioProfilerCaptureSound
+	 * @brief An active sound of a record
+	 */
+	struct FAudioProfilerCaptureSound {
+		/** String id of the sound name */
+		uint32 NameId = InvalidStringId;
+
+		/** Volume of the active sound */
+		float Volume = 0.f;
+	};
+
+	/**
+	 * @struct FAudioProfilerCaptureBookmark
+	 * @brief A bookmark added before a record
+	 */
+	struct FAudioProfilerCaptureBookmark {
+		/** String id of the bookmark name */
+		uint32 NameId = InvalidStringId;
+
+		uint32 Reserved = 0;
+
+		/** Platform time the bookmark was added at in seconds */
+		double Time = 0.0;
+	};
+
+	/**
+	 * @struct FAudioProfilerCaptureStringTable
+	 * @brief Header of the string table
+	 * @details Followed by uint32 Offsets[NumStrings + 1] and the UTF-8 bytes of all strings.
+	 * String i are the bytes from Offsets[i] to Offsets[i + 1], relative to the first byte.
+	 */
+	struct FAudioProfilerCaptureStringTable {
+		uint32 NumStrings = 0;
+		uint32 Reserved = 0;
+	};
+
+	/**
+	 * Rounds a size up to the alignment of sections and columns.
+	 * @param InSize Size in bytes.
+	 * @return Size rounded up to 8 bytes.
+	 */
+	constexpr uint64 AlignSection(const uint64 InSize) {
+		return (InSize + 7) & ~static_cast<uint64>(7);
+	}
+}
@@ -0,0 +1,117 @@
+﻿/**
+ * @file AudioProfilerCaptureReader.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioProfilerCaptureFormat.h"
+#include "Models/AudioProfilerHeaderModel.h"
+#include "Models/AudioProfilerTimestampModel.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace BachelorAudio::AudioProfiler {
+	/**
+	 * @class FAudioProfilerCaptureReader
+	 * @brief Reads a binary capture file, see AudioProfilerCaptureFormat.h
+	 * @details Maps the file and reads the columns in place, platforms without file mapping
+	 * load it into memory instead. Chunks are decoded one at a time, so converting a long
+	 * capture never holds more than one chunk of timestamp models.
+	 * Public, so callers needing the records of a session read them from its capture chunk by chunk.
+	 */
+	class AUDIOPROFILER_API FAudioProfilerCaptureReader {
+	public:
+		FAudioProfilerCaptureReader();
+		~FAudioProfilerCaptureReader();
+
+		FAudioProfilerCaptureReader(const FAudioProfilerCaptureReader&) = delete;
+		FAudioProfilerCaptureReader& operator=(const FAudioProfilerCaptureReader&) = delete;
+
+		/**
+		 * Opens a capture file and validates its header and tables.
+		 * @param InFilePath Path of the capture file.
+		 * @return False if the file is missing, unfinished or of another version.
+		 */
+		bool Open(const FString& InFilePath);
+
+		/** @return Header of the open capture */
+		const Capture::FAudioProfilerCaptureHeader& GetHeader() const { return *Header; }
+
+		/** @return Session information of the open capture */
+		FAudioProfilerHeaderModel GetHeaderModel() const;
+
+		/** @return Number of chunks of the open capture */
+		int32 GetNumChunks() const { return static_cast<int32>(Header->NumChunks); }
+
+		/**
+		 * Returns an interned string.
+		 * @param InId String id.
+		 * @return The string, empty for unknown ids.
+		 */
+		const FString& GetString(const uint32 InId) const;
+
+		/**
+		 * Decodes the records of a chunk.
+		 * @param InIndex Index of the chunk.
+		 * @param OutTimestamps Receives one timestamp per record, appended.
+		 * @return False if the chunk lies outside of the file.
+		 */
+		bool ReadChunk(const int32 InIndex, TArray<FAudioProfilerTimestampModel>& OutTimestamps) const;
+
+	private:
+		/**
+		 * Returns a column of the file, if it lies within the file.
+		 * @param InOffset File offset of the column.
+		 * @param InNum Number of values.
+		 * @return First value, null if out of bounds.
+		 */
+		template<typename T>
+		const T* GetColumn(const uint64 InOffset, const uint64 InNum) const {
+			if(InOffset > Size || InNum > (Size - InOffset) / sizeof(T)) return nullptr;
+			return reinterpret_cast<const T*>(Data + InOffset);
+		}
+
+		/**
+		 * Returns the column at a cursor and moves the cursor behind it.
+		 * @param InOutOffset Cursor, moved to the next column.
+		 * @param InNum Number of values.
+		 * @return First value, null if out of bounds.
+		 */
+		template<typename T>
+		const T* NextColumn(uint64& InOutOffset, const uint64 InNum) const {
+			const T* column = GetColumn<T>(InOutOffset, InNum);
+			InOutOffset += Capture::AlignSection(sizeof(T) * InNum);
+			return column;
+		}
+
+		/** Mapped file, null if not mapped */
+		TUniquePtr<IMappedFileHandle> MappedFile;
+
+		/** Mapped region of the whole file */
+		TUniquePtr<IMappedFileRegion> MappedRegion;
+
+		/** File content if mapping is not supported */
+		TArray64<uint8> FileData;
+
+		/** First byte of the file */
+		const uint8* Data = nullptr;
+
+		/** Size of the file in bytes */
+		uint64 Size = 0;
+
+		/** Header at the start of the file */
+		const Capture::FAudioProfilerCaptureHeader* Header = nullptr;
+
+		/** File offsets of the chunks */
+		const uint64* ChunkOffsets = nullptr;
+
+		/** Decoded string table */
+		TArray<FString> Strings;
+
+		/** Names of the node classes with cost columns */
+		TArray<FString> NodeClassNames;
+	};
+}
@@ -52,6 +52,51 @@ struct AUDIOPROFILER_API FAudioProfilerDeveloperModel {
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	float Interval = 1.f;
 
+	/**
+	 * Whether the render cost of MetaSound node classes is captured.
+	 * Enables the timing inside the BachelorMetasound operators while profiling.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bCaptureNodeRenderCost = false;
+
+	/**
+	 * Seconds of metrics and audio the flight recorder keeps.
+	 * Older records are overwritten, a dump holds at most this window.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float FlightRecorderSeconds = 30.f;
+
+	/**
+	 * The time interval between flight recorder captures in seconds.
+	 * Usually coarser than the profiling interval, the recorder runs all the time.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float FlightRecorderInterval = 0.1f;
+
+	/**
+	 * Whether the flight recorder keeps the output audio and dumps it as wave file.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bFlightRecorderAudio = false;
+
+	/**
+	 * Whether a late callback of the main submix, estimated from its callback periods, triggers a flight recorder dump.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	bool bDumpOnLateCallback = true;
+
+	/**
+	 * Game frame time in milliseconds that triggers a flight recorder dump, 0 disables the trigger.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float FrameSpikeThresholdMs = 50.f;
+
+	/**
+	 * Output true peak in dBTP that triggers a flight recorder dump.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float PeakThresholdDb = -0.1f;
+
 	/**
 	 * @brief A safe pointer to an object associated with this profiling data.
 	 * 
@@ -134,4 +179,102 @@ public:
 			ClampMax = 10
 			))
 	float ProfilingInterval;
+
+	/**
+	 * @brief Captures the render cost of every BachelorMetasound node class
+	 * @details Times the Execute of every operator while profiling and exports the cost per
+	 * node class and capture interval. Adds a little overhead to every operator.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Bachelor Audio | Audio Profiling"
+		)
+	bool bCaptureNodeRenderCost = false;
+
+	/**
+	 * @brief Seconds of metrics, bookmarks and audio the flight recorder keeps
+	 * @details The flight recorder keeps the last seconds in rings allocated once and dumps
+	 * them when a trigger fires. Memory grows with the window and falls with the interval.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Bachelor Audio | Flight Recorder",
+		meta = (
+			UIMin = 1,
+			ClampMin = 1,
+			UIMax = 300,
+			ClampMax = 300
+			))
+	float FlightRecorderSeconds = 30.f;
+
+	/**
+	 * @brief Time interval between flight recorder captures in seconds
+	 * @details The flight recorder is meant to run all the time, a coarse interval keeps its cost low.
+	 * @note Value is clamped between 0.01 seconds and 1 second.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Bachelor Audio | Flight Recorder",
+		meta = (
+			UIMin = 0.01,
+			ClampMin = 0.01,
+			UIMax = 1,
+			ClampMax = 1
+			))
+	float FlightRecorderInterval = 0.1f;
+
+	/**
+	 * @brief Keeps the output audio of the flight recorder window
+	 * @details Keeps the front left and right channels of the main submix and dumps them
+	 * as wave file next to the capture. Takes about 23 MB for 30 seconds at 48 kHz.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Bachelor Audio | Flight Recorder"
+		)
+	bool bFlightRecorderAudio = false;
+
+	/**
+	 * @brief Dumps the flight recorder when a callback of the main submix comes late
+	 * @details Estimated from the callback periods, the platform does not report actual underruns
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Bachelor Audio | Flight Recorder"
+		)
+	bool bDumpOnLateCallback = true;
+
+	/**
+	 * @brief Game frame time in milliseconds that dumps the flight recorder
+	 * @details 0 disables the trigger.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Bachelor Audio | Flight Recorder",
+		meta = (
+			UIMin = 0,
+			ClampMin = 0
+			))
+	float FrameSpikeThresholdMs = 50.f;
+
+	/**
+	 * @brief Output true peak in dBTP that dumps the flight recorder
+	 * @details Measured on the main submix including the peaks between samples, values above 0 dBTP
+	 * only trigger on clipping float output.
+	 */
+	UPROPERTY(
+		EditAnywhere,
+		Config,
+		Category = "Bachelor Audio | Flight Recorder",
+		meta = (
+			UIMin = -24,
+			UIMax = 6
+			))
+	float PeakThresholdDb = -0.1f;
 };
\ No newline at end of file
@@ -49,20 +49,6 @@ struct AUDIOPROFILER_API FAudioProfilerModel {
 			))
 	FAudioProfilerHeaderModel AudioProfilerHeader;
 
-	/**
-	 * @brief all currently active sounds and audio device info
-	 * @details Stores identifiers and current values for each active sound, useful for debugging and analysis
-	 */
-	UPROPERTY(
-		VisibleAnywhere,
-		BlueprintReadOnly,
-		Category = "Sounds",
-		meta = (
-			DisplayName = "Active Sound Names",
-			ShowOnlyInnerProperties
-			))
-	TArray<FAudioProfilerTimestampModel> AudioProfilerData;
-
 	/**
 	 * @brief A safe pointer to an object associated with this profiling data.
 	 * 
@@ -0,0 +1,80 @@
+﻿/**
+ * @file AudioProfilerNodeCostModel.h
+ * @author Markus Schramm
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioProfilerNodeCostModel.generated.h"
+
+/**
+ * @struct FAudioProfilerNodeCostModel
+ * @brief Data structure for the render cost of one MetaSound node class
+ * @details Holds the cost all instances of a node class caused within one capture interval,
+ * to see which node class eats the audio render budget
+ */
+USTRUCT(BlueprintType, Category = "Audio Profiler")
+struct AUDIOPROFILER_API FAudioProfilerNodeCostModel {
+	GENERATED_BODY()
+
+	/**
+	 * @brief Name of the node class
+	 * @details Identifies the node class, e.g. Volume or AdvancedNoise
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		meta = (
+			DisplayName = "Node Class"
+			))
+	FString NodeClassName{TEXT("")};
+
+	/**
+	 * @brief Number of executed blocks
+	 * @details Counts the blocks of all instances rendered within the interval
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		meta = (
+			DisplayName = "Executes"
+			))
+	int64 NumExecutes{0};
+
+	/**
+	 * @brief Number of rendered frames
+	 * @details Counts the frames of all instances rendered within the interval
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		meta = (
+			DisplayName = "Samples"
+			))
+	int64 NumSamples{0};
+
+	/**
+	 * @brief Render time in milliseconds
+	 * @details Time all instances spent in Execute within the interval
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		meta = (
+			DisplayName = "Render Time ms"
+			))
+	double RenderTimeMs{0.0};
+
+	/**
+	 * @brief Render time per frame in nanoseconds
+	 * @details Comparable between node classes independent of block size and instance count
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		meta = (
+			DisplayName = "ns per Sample"
+			))
+	double NanosecondsPerSample{0.0};
+};
@@ -7,6 +7,7 @@
 
 #include "CoreMinimal.h"
 #include "AudioProfilerSoundModel.h"
+#include "AudioProfilerNodeCostModel.h"
 #include "AudioProfilerTimestampModel.generated.h"
 
 struct FAudioProfilerSoundModel;
@@ -163,6 +164,137 @@ struct AUDIOPROFILER_API FAudioProfilerTimestampModel {
 			DisplayName = "Free Sources Count"
 			))
 	int32 FreeSourcesCount{0};
+
+	/**
+	 * @brief Median time between two callbacks of the main submix in ms
+	 * @details Measured on the audio render thread over this interval, compare with the buffer length.
+	 * This is the callback period, not the time spent rendering a buffer.
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Callback",
+		meta = (
+			DisplayName = "Callback Period P50 ms"
+			))
+	float CallbackPeriodP50Ms{0.f};
+
+	/**
+	 * @brief 99th percentile of the time between two callbacks of the main submix in ms
+	 * @details Shows rare late callbacks the median hides
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Callback",
+		meta = (
+			DisplayName = "Callback Period P99 ms"
+			))
+	float CallbackPeriodP99Ms{0.f};
+
+	/**
+	 * @brief Longest time between two callbacks of the main submix in ms
+	 * @details The worst callback of this interval
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Callback",
+		meta = (
+			DisplayName = "Callback Period Max ms"
+			))
+	float CallbackPeriodMaxMs{0.f};
+
+	/**
+	 * @brief Audio length of one buffer in ms
+	 * @details The expected callback period
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Callback",
+		meta = (
+			DisplayName = "Buffer Length ms"
+			))
+	float BufferLengthMs{0.f};
+
+	/**
+	 * @brief Number of callbacks of the main submix within this interval
+	 * @details Zero if the callbacks were not timed
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Callback",
+		meta = (
+			DisplayName = "Callbacks"
+			))
+	int32 CallbackCount{0};
+
+	/**
+	 * @brief Number of callbacks that came later than the modelled device queue allows
+	 * @details Estimated from the callback periods, the platform does not report actual underruns
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Callback",
+		meta = (
+			DisplayName = "Late Callbacks"
+			))
+	int32 LateCallbackCount{0};
+
+	/**
+	 * @brief RMS level of the main submix output within this interval in dBFS
+	 * @details -120 if the output was silent or not analyzed
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Output",
+		meta = (
+			DisplayName = "Output RMS dB"
+			))
+	float OutputRmsDb{0.f};
+
+	/**
+	 * @brief Highest peak of the main submix output within this interval in dBTP
+	 * @details Includes the peaks between samples, above 0 the output clips after conversion
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Output",
+		meta = (
+			DisplayName = "Output True Peak dB"
+			))
+	float OutputTruePeakDb{0.f};
+
+	/**
+	 * @brief Short-term loudness of the main submix output in LUFS
+	 * @details K-weighted over the 3 seconds before the end of this interval
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Output",
+		meta = (
+			DisplayName = "Output Loudness LUFS"
+			))
+	float OutputLoudnessLUFS{0.f};
+
+	/**
+	 * @brief Mean level of the coarse spectrum bands of the main submix output in dBFS
+	 * @details One value per band, the bands start at 20, 125, 250 and 500 Hz and at 1, 2, 4 and 8 kHz
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Output",
+		meta = (
+			DisplayName = "Output Spectrum dB"
+			))
+	TArray<float> OutputSpectrumDb{};
 	
 	/**
 	 * @brief all currently active sounds
@@ -192,6 +324,20 @@ struct AUDIOPROFILER_API FAudioProfilerTimestampModel {
 			))
 	TArray<FString> ActiveBookmarks{};
 
+	/**
+	 * @brief render cost of every MetaSound node class within this interval
+	 * @details Only filled if node render cost capturing is enabled in the developer settings
+	 */
+	UPROPERTY(
+		VisibleAnywhere,
+		BlueprintReadOnly,
+		Category = "Nodes",
+		meta = (
+			DisplayName = "Node Costs",
+			ShowOnlyInnerProperties
+			))
+	TArray<FAudioProfilerNodeCostModel> NodeCosts{};
+
 	/**
 	 * @brief A safe pointer to an object associated with this profiling data.
 	 * 
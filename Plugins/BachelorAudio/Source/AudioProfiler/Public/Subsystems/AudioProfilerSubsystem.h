@@ -12,10 +12,54 @@
 enum class EAudioProfilerDebuggingType : uint8;
 enum class EAudioProfilerProfilingType : uint8;
 
+namespace BachelorAudio::AudioProfiler {
+	class FAudioProfilerAudioRing;
+	class FAudioProfilerBookmarkQueue;
+	class FAudioProfilerCaptureWriter;
+	class FAudioProfilerFlightRecorder;
+	class FAudioProfilerOutputAnalyzer;
+	class FAudioProfilerRenderTimer;
+	class FAudioProfilerSampler;
+}
+
+/**
+ * Broadcast on the game thread once the reports of a profiling session are converted from its capture.
+ * @param bSucceeded Whether both files were written completely.
+ * @param CSVFilePath Path of the CSV file, empty if nothing was captured.
+ * @param MDFilePath Path of the Markdown report, empty if nothing was captured.
+ * @param CaptureFilePath Path of the binary capture holding all records, read it with FAudioProfilerCaptureReader.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(
+	FOnAudioProfilerExportCompleted,
+	bool, bSucceeded,
+	const FString&, CSVFilePath,
+	const FString&, MDFilePath,
+	const FString&, CaptureFilePath
+	);
+
+/**
+ * Broadcast on the game thread once a flight recorder dump is written.
+ * @param Reason Trigger or caller reason of the dump.
+ * @param bSucceeded Whether the capture was written completely.
+ * @param CaptureFilePath Path of the binary capture, empty if nothing was recorded.
+ * @param WaveFilePath Path of the output audio, empty if audio is not recorded.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(
+	FOnAudioProfilerFlightRecorderDumped,
+	const FString&, Reason,
+	bool, bSucceeded,
+	const FString&, CaptureFilePath,
+	const FString&, WaveFilePath
+	);
+
 /**
  * A subsystem for profiling audio performance in a game instance.
  * Captures and records audio performance metrics at specified intervals during gameplay.
- * Data can be exported to CSV and Markdown formats for analysis.
+ * Sampling runs on a dedicated thread, the game thread only drains the sampled records.
+ * Records are streamed to a binary capture file while profiling, which is converted into
+ * the CSV and Markdown reports in the background when profiling stops.
+ * Alternatively the flight recorder keeps only the last seconds in fixed memory and dumps
+ * them into a capture when a late audio callback, frame spike or headroom breach is detected.
  */
 UCLASS(config=Game, ClassGroup="Audio")
 class AUDIOPROFILER_API UAudioProfilerSubsystem final : public UGameInstanceSubsystem {
@@ -80,43 +124,129 @@ public:
 	   );
 	
 	/**
-	 * Stops the current profiling session and exports collected data.
-	 * Cleans up the timer and exports data to CSV and Markdown files.
+	 * Stops the current profiling session and finalizes the export.
+	 * Cleans up the timer, closes the capture and converts it into the CSV and Markdown files
+	 * in the background. OnExportCompleted is broadcast when they are written. The records are
+	 * not kept in memory, callers needing them read the capture it names.
 	 * No effect if profiling is not currently active.
 	 * @param WorldContext Reference to the world in which profiling is taking place.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Audio Profiling")
 	void StopProfiling(const UWorld* WorldContext = nullptr);
 	
+	/**
+	 * Starts the flight recorder.
+	 * Keeps the metrics, bookmarks and optionally the output audio of the last seconds in fixed
+	 * memory and dumps them when a trigger fires. Can not run while profiling.
+	 * @param WorldContext Reference to the world in which recording is taking place.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Profiling")
+	void StartFlightRecorder(const UWorld* WorldContext = nullptr);
+
+	/**
+	 * Stops the flight recorder without dumping it.
+	 * No effect if the flight recorder is not running.
+	 * @param WorldContext Reference to the world in which recording is taking place.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Profiling")
+	void StopFlightRecorder(const UWorld* WorldContext = nullptr);
+
+	/**
+	 * Dumps the window of the flight recorder into a capture, and the output audio into a wave file.
+	 * Files are written in the background, OnFlightRecorderDumped is broadcast when done.
+	 * The flight recorder keeps recording.
+	 * @param InReason Reason of the dump, part of the file names.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Audio Profiling")
+	void DumpFlightRecorder(const FString& InReason = TEXT("Manual"));
+
 	/**
 	 * Adds a named bookmark to the profiling session at the current time.
 	 * Useful for marking significant events during profiling.
+	 * Thread-safe, a known name only takes a shared lock and does not allocate.
 	 * @param InName Name of the bookmark for later reference.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Audio Profiling")
 	void AddBookmark(const FString& InName);
 
+	/**
+	 * Interns a bookmark name for AddBookmarkById.
+	 * Thread-safe, call it once outside of time critical code.
+	 * @param InName Name of the bookmark.
+	 * @return Id of the name, stays valid for the lifetime of the subsystem.
+	 */
+	uint32 RegisterBookmarkName(const FString& InName);
+
+	/**
+	 * Adds a bookmark with an interned name at the current time.
+	 * Lock-free and without allocations, safe to call from the audio render thread.
+	 * @param InNameId Id returned by RegisterBookmarkName.
+	 */
+	void AddBookmarkById(const uint32 InNameId);
+
 	/**
 	 * Retrieves the current profiling data model.
 	 * @return The current audio profiler model containing all collected data.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Audio Profiling")
 	const FAudioProfilerModel& GetProfilingData() const;
+
+	/**
+	 * Broadcast when the export of a stopped profiling session is written.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Audio Profiling")
+	FOnAudioProfilerExportCompleted OnExportCompleted;
+
+	/**
+	 * Broadcast when a flight recorder dump is written.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Audio Profiling")
+	FOnAudioProfilerFlightRecorderDumped OnFlightRecorderDumped;
 	
 private:
 	/**
-	 * Captures a snapshot of the current audio state.
-	 * Collects audio metrics from the active audio engine and adds them to the profiling data.
-	 * Called periodically during profiling based on the specified interval.
-	 * @param AudioDevice the audio device to capture
+	 * Moves all records sampled since the last drain into the capture.
+	 * Each queued bookmark goes to the first record taken after it, active sound names to the last record.
+	 * Called periodically during profiling by the drain timer and once when profiling stops.
 	 */
-	void CaptureProfilingData();
+	void DrainProfilingData();
 
 	/**
-	 * Exports the collected profiling data to CSV and Markdown files.
-	 * Called when profiling is stopped.
+	 * Moves all records sampled since the last drain into the flight recorder and dumps it if a record fires a trigger.
+	 * Called instead of draining into the capture while the flight recorder runs.
 	 */
-	void ExportProfilingData() const;
+	void DrainFlightRecorder();
+
+	/**
+	 * Reads the audio device of a world and the session information of the header.
+	 * @param World World in which profiling or recording takes place.
+	 */
+	void BindAudioDevice(const UWorld* World);
+
+	/**
+	 * Starts the sampler thread, the render timer and the drain timer.
+	 * @param World World owning the drain timer.
+	 * @param InInterval Time between two samples.
+	 * @return False if the sampler thread could not be started.
+	 */
+	bool StartSampler(const UWorld* World, const float InInterval);
+
+	/**
+	 * Stops the sampler thread and the render timer, drains the last records and clears the drain timer.
+	 * @param World World owning the drain timer, may be null.
+	 */
+	void StopSampler(const UWorld* World);
+
+	/**
+	 * Adds the active sounds of the audio device to the last captured record.
+	 */
+	void CaptureActiveSounds(BachelorAudio::AudioProfiler::FAudioProfilerCaptureWriter& InWriter) const;
+
+	/**
+	 * Finalizes the capture and converts it into the reports in the background.
+	 * Called when profiling is stopped, broadcasts OnExportCompleted when done.
+	 */
+	void FinishExport();
 	
 	/**
 	 * Builds a formatted session string from the session name.
@@ -134,29 +264,6 @@ private:
 	 */
 	FString BuildSessionPath(const FString& InFileType) const;
 
-	/**
-	 * Builds the content for the CSV export file.
-	 * Formats all collected data points into CSV rows.
-	 * @return String containing the formatted CSV data.
-	 */
-	FString BuildCSVContent() const;
-	
-	/**
-	 * Builds the header section for the Markdown report.
-	 * Creates a title, summary, and link to the CSV data.
-	 * @param CSVFilepath Path to the CSV file referenced in the markdown.
-	 * @return String containing the markdown header content.
-	 */
-	FString BuildMDHeader(const FString& CSVFilepath) const;
-
-	/**
-	 * Builds the full Markdown report content.
-	 * Adds detailed analytics and bookmarks to the header.
-	 * @param MDHeader The header section of the markdown report.
-	 * @return String containing the complete markdown report.
-	 */
-	FString BuildMDContent(const FString& MDHeader) const;
-
 	/**
 	 * The data model containing all captured audio profiling information.
 	 * Stores metrics like CPU usage, memory consumption, and active sounds.
@@ -172,31 +279,59 @@ private:
 	FAudioProfilerModel ProfilingData;
 
 	/**
-	 * Map of timestamps to bookmark names.
-	 * Used to mark significant events during the profiling session.
+	 * Queue of the bookmarks added since the last drain.
+	 * Used to mark significant events during the profiling session, filled from any thread.
 	 */
-	UPROPERTY(
-		VisibleAnywhere,
-		BlueprintReadOnly,
-		Category="Audio Profiling",
-		meta = (
-			AllowPrivateAccess = "true",
-			ShowOnlyInnerProperties
-			))
-	TMap<float, FString> ProfilingBookmarks;
+	TUniquePtr<BachelorAudio::AudioProfiler::FAudioProfilerBookmarkQueue> ProfilingBookmarks;
 
 	/**
-	 * Timer delegate for periodic data capture.
-	 * Binds to the CaptureProfilingData method.
+	 * Timer delegate for periodic draining of the sampled records.
+	 * Binds to the DrainProfilingData method.
 	 */
 	FTimerDelegate ProfilingTimerDelegate;
 
 	/**
-	 * Timer handle for the profiling update timer.
-	 * Used to manage the timing of data captures.
+	 * Timer handle for the drain timer.
+	 * Used to manage the timing of drains on the game thread.
 	 */
 	FTimerHandle ProfilingTimerHandle;
 
+	/**
+	 * Sampler thread writing the records the drain timer reads.
+	 * Only exists while profiling.
+	 */
+	TUniquePtr<BachelorAudio::AudioProfiler::FAudioProfilerSampler> Sampler;
+
+	/**
+	 * Listener timing every buffer the audio render thread renders, registered while profiling.
+	 * Kept after profiling stops, the render thread may still be inside the callback while it unregisters.
+	 */
+	TUniquePtr<BachelorAudio::AudioProfiler::FAudioProfilerRenderTimer> RenderTimer;
+
+	/**
+	 * Listener measuring level, loudness and spectrum of every rendered buffer, registered with the render timer.
+	 * Kept after profiling stops for the same reason.
+	 */
+	TUniquePtr<BachelorAudio::AudioProfiler::FAudioProfilerOutputAnalyzer> OutputAnalyzer;
+
+	/**
+	 * Writer streaming the drained records into the binary capture.
+	 * Only exists while profiling.
+	 */
+	TSharedPtr<BachelorAudio::AudioProfiler::FAudioProfilerCaptureWriter, ESPMode::ThreadSafe> CaptureWriter;
+
+	/**
+	 * Rings of the records and bookmarks of the last seconds, filled while the flight recorder runs.
+	 * Allocated on the first start and kept, so restarting does not allocate again.
+	 */
+	TUniquePtr<BachelorAudio::AudioProfiler::FAudioProfilerFlightRecorder> FlightRecorder;
+
+	/**
+	 * Listener keeping the output audio of the last seconds, registered while the flight recorder runs.
+	 * Kept after the recorder stops, like the render timer.
+	 */
+	TUniquePtr<BachelorAudio::AudioProfiler::FAudioProfilerAudioRing> AudioRing;
+
 	/**
 	 * Flag indicating whether profiling is currently active.
 	 * Prevents starting multiple profiling sessions simultaneously.
@@ -204,10 +339,16 @@ private:
 	bool bIsProfiling;
 
 	/**
-	 * Value of Bookmark map size.
-	 * To prepare data in right order for csv.
+	 * Flag indicating whether the flight recorder is currently running.
+	 * Profiling and the flight recorder share the sampler and exclude each other.
+	 */
+	bool bIsRecording = false;
+
+	/**
+	 * Whether node render timing was enabled before profiling started.
+	 * Restored when profiling stops, so a console variable set by hand stays intact.
 	 */
-	int LastBookMarksNum;
+	bool bWasNodeRenderStatsEnabled = false;
 	
 	/**
 	 * Pointer to audio device
@@ -17,6 +17,7 @@ public class BachelorMetasound : ModuleRules
                 "AudioExtensions",
                 "Serialization",
                 "SignalProcessing",
+                "BachelorRenderStats",
             }
         );
 
@@ -25,6 +26,7 @@ public class BachelorMetasound : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "Json",
                 "Slate",
                 "SlateCore",
             }
@@ -14,28 +14,16 @@
 #include "MetasoundPrimitives.h"
 #include "MetasoundTrigger.h"
 #include "MetasoundVertex.h"
+#include "DSP/ColoredNoise.h"
 #include "DSP/Noise.h"
+#include "DSP/NoiseWavetable.h"
+#include "DSP/PeakingFilter.h"
+#include "ControlRate.h"
+#include "NodeRenderStats.h"
 
 #define LOCTEXT_NAMESPACE "BachelorMetasound_AdvancedNoiseNode"
 
 namespace Metasound {
-	enum class EAdvancedNoiseType : uint8 {
-		Pink	= 0,
-		White	= 1,
-		Brown	= 2,
-		Green	= 3
-	};
-
-	DECLARE_METASOUND_ENUM(
-		EAdvancedNoiseType,
-		EAdvancedNoiseType::Pink,
-		BACHELORMETASOUND_API,
-		FEnumAdvancedNoiseType,
-		FEnumAdvancedNoiseTypeInfo,
-		FEnumAdvancedNoiseTypeReadRef,
-		FEnumAdvancedNoiseTypeWriteRef
-		);
-
 	DEFINE_METASOUND_ENUM_BEGIN(EAdvancedNoiseType, FEnumAdvancedNoiseType, "AdvancedNoiseType")
 		DEFINE_METASOUND_ENUM_ENTRY(
 			EAdvancedNoiseType::Pink,
@@ -69,6 +57,10 @@ namespace Metasound {
 			"Bandwidth of noise passed. 0 = all passes, 0,707 = Standard Green Noise. Only used at Green Noise!")
 		METASOUND_PARAM(InputGain, "Gain (db)",
 			"Gain to apply at frequency.")
+		METASOUND_PARAM(InputUseWavetable, "Use Wavetable",
+			"Reads noise from shared precomputed tables instead of generating it per voice. Cheap for many voices. Same spectrum as generated noise, the tables are peak normalized, so the level can differ slightly.")
+		METASOUND_PARAM(InputRuntimeType, "Runtime Type",
+			"Allows changing Type while playing without rebuilding the graph. Crossfades between types over 10 ms. Combined with Use Wavetable every type is read from the shared tables.")
 
 		// Output params
 		METASOUND_PARAM(OutAudio, "Out", "Audio output.")
@@ -80,6 +72,9 @@ namespace Metasound {
 		static constexpr float DefaultFrequency = 2000.f;
 		static constexpr float DefaultBandwidth = 0.f;
 		static constexpr float DefaultGain = 0.f;
+		static constexpr bool DefaultUseWavetable = false;
+		static constexpr bool DefaultRuntimeType = false;
+		static constexpr float DefaultQuality = 0.707f;
 
 		static const FNodeClassMetadata& GetNodeInfo();
 		static FVertexInterface DeclareVertexInterface();
@@ -94,7 +89,9 @@ namespace Metasound {
 			FEnumAdvancedNoiseTypeReadRef InNoiseTypeReadRef,
 			FFloatReadRef InFrequencyReadRef,
 			FFloatReadRef InBandwidthReadRef,
-			FFloatReadRef InGainReadRef
+			FFloatReadRef InGainReadRef,
+			FBoolReadRef InUseWavetableReadRef,
+			FBoolReadRef InRuntimeTypeReadRef
 			);
 
 		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override;
@@ -106,9 +103,14 @@ namespace Metasound {
 
 	protected:
 		template<typename T>
-		static T MakeGenerator(int32 InSeed) {
-			if(InSeed == DefaultSeed) return T{};
-			return T{InSeed};
+		T MakeGenerator(int32 InSeed) const {
+			// Green noise is a band pass, so its generator is tuned for the sample rate
+			if constexpr (std::is_same_v<T, BachelorDSP::FGreenNoise>) {
+				return T{SampleRate, InSeed};
+			} else {
+				if(InSeed == DefaultSeed) return T{};
+				return T{InSeed};
+			}
 		}
 
 		template<typename T>
@@ -126,11 +128,41 @@ namespace Metasound {
 			}
 		}
 
+		/**
+		 * Recomputes the peaking filter if Frequency, Bandwidth or Gain changed, at control rate.
+		 * Bandwidth sets the quality for Green noise only, all other types use DefaultQuality.
+		 * bForce takes the current inputs without decimation or smoothing.
+		 */
+		void UpdateShaping(const bool bForce = false) {
+			UpdateShaping(*NoiseType, bForce);
+		}
+
+		/** UpdateShaping for the given type instead of the Type input. */
+		void UpdateShaping(const EAdvancedNoiseType InType, const bool bForce) {
+			if (bForce) ShapingParameters.Reset();
+			if (!ShapingParameters.Update({ *Frequency, *Bandwidth, *Gain })) return;
+
+			const float quality = InType == EAdvancedNoiseType::Green ? ShapingParameters[1] : DefaultQuality;
+			Shaping.SetValues(SampleRate, ShapingParameters[0], quality, ShapingParameters[2]);
+		}
+
 		template<typename T>
 		FORCEINLINE void Generate(T& InGenerator) {
-			float* writePtr = Out->GetData();
-			for (int32 i = Out->Num(); i > 0; --i) {
-				*writePtr++ = InGenerator.Generate();
+			GenerateTo(InGenerator, Out->GetData(), Out->Num());
+		}
+
+		/** Generates and filters in one loop, so shaping costs no extra pass over the buffer. */
+		template<typename T>
+		FORCEINLINE void GenerateTo(T& InGenerator, float* OutData, const int32 NumSamples) {
+			float* writePtr = OutData;
+			if (!Shaping.IsActive()) {
+				for (int32 i = NumSamples; i > 0; --i) {
+					*writePtr++ = InGenerator.Generate();
+				}
+				return;
+			}
+			for (int32 i = NumSamples; i > 0; --i) {
+				*writePtr++ = Shaping.ProcessSample(InGenerator.Generate());
 			}
 		}
 		
@@ -139,18 +171,25 @@ namespace Metasound {
 		FFloatReadRef Frequency;
 		FFloatReadRef Bandwidth;
 		FFloatReadRef Gain;
+		FBoolReadRef UseWavetable;
+		FBoolReadRef RuntimeType;
 		FAudioBufferWriteRef Out;
+
+		float SampleRate;
+		BachelorDSP::FPeakingFilter Shaping;
 		
 		int32 OldSeed;
-		float OldFrequency;
-		float OldBandwidth;
-		float OldGain;
+		/** Frequency, Bandwidth and Gain of the shaping. */
+		BachelorMetasound::TControlRateParameters<3> ShapingParameters;
 	};
 
 	constexpr int32 FAdvancedNoiseOperator::DefaultSeed;
 	constexpr float FAdvancedNoiseOperator::DefaultFrequency;
 	constexpr float FAdvancedNoiseOperator::DefaultBandwidth;
 	constexpr float FAdvancedNoiseOperator::DefaultGain;
+	constexpr bool FAdvancedNoiseOperator::DefaultUseWavetable;
+	constexpr bool FAdvancedNoiseOperator::DefaultRuntimeType;
+	constexpr float FAdvancedNoiseOperator::DefaultQuality;
 	
 	struct FAdvancedNoiseOperator_White final : public FAdvancedNoiseOperator {
 		Audio::FWhiteNoise Generator;
@@ -161,14 +200,18 @@ namespace Metasound {
 			FEnumAdvancedNoiseTypeReadRef&& InNoiseTypeReadRef,
 			FFloatReadRef&& InFrequencyReadRef,
 			FFloatReadRef&& InBandwidthReadRef,
-			FFloatReadRef&& InGainReadRef
+			FFloatReadRef&& InGainReadRef,
+			FBoolReadRef&& InUseWavetableReadRef,
+			FBoolReadRef&& InRuntimeTypeReadRef
 			) : FAdvancedNoiseOperator {
 				InSettings,
 				MoveTemp(InSeed),
 				MoveTemp(InNoiseTypeReadRef),
 				MoveTemp(InFrequencyReadRef),
 				MoveTemp(InBandwidthReadRef),
-				MoveTemp(InGainReadRef) },
+				MoveTemp(InGainReadRef),
+				MoveTemp(InUseWavetableReadRef),
+				MoveTemp(InRuntimeTypeReadRef) },
 				Generator {
 					MakeGenerator<Audio::FWhiteNoise>(*Seed)
 				}
@@ -176,11 +219,15 @@ namespace Metasound {
 
 		void Reset(const FResetParams& InParams) {
 			ResetAdvancedNoiseOperator(Generator);
+			UpdateShaping(true);
+			Shaping.Init();
 			Out->Zero();
 		}
 
 		void Execute() {
+			const BachelorMetasound::FScopedNodeRenderStats RenderStats(BachelorMetasound::ENodeRenderClass::AdvancedNoise, Out->Num());
 			CheckAndReseed(Generator);
+			UpdateShaping();
 			Generate(Generator);
 		}
 		
@@ -208,14 +255,18 @@ namespace Metasound {
 			FEnumAdvancedNoiseTypeReadRef&& InNoiseTypeReadRef,
 			FFloatReadRef&& InFrequencyReadRef,
 			FFloatReadRef&& InBandwidthReadRef,
-			FFloatReadRef&& InGainReadRef
+			FFloatReadRef&& InGainReadRef,
+			FBoolReadRef&& InUseWavetableReadRef,
+			FBoolReadRef&& InRuntimeTypeReadRef
 			) : FAdvancedNoiseOperator {
 				InSettings,
 				MoveTemp(InSeed),
 				MoveTemp(InNoiseTypeReadRef),
 				MoveTemp(InFrequencyReadRef),
 				MoveTemp(InBandwidthReadRef),
-				MoveTemp(InGainReadRef) },
+				MoveTemp(InGainReadRef),
+				MoveTemp(InUseWavetableReadRef),
+				MoveTemp(InRuntimeTypeReadRef) },
 				Generator {
 					MakeGenerator<Audio::FPinkNoise>(*Seed)
 				}
@@ -223,11 +274,15 @@ namespace Metasound {
 
 		void Reset(const FResetParams& InParams) {
 			ResetAdvancedNoiseOperator(Generator);
+			UpdateShaping(true);
+			Shaping.Init();
 			Out->Zero();
 		}
 
 		void Execute() {
+			const BachelorMetasound::FScopedNodeRenderStats RenderStats(BachelorMetasound::ENodeRenderClass::AdvancedNoise, Out->Num());
 			CheckAndReseed(Generator);
+			UpdateShaping();
 			Generate(Generator);
 		}
 
@@ -247,7 +302,7 @@ namespace Metasound {
 	};
 
 	struct FAdvancedNoiseOperator_Brown final : public FAdvancedNoiseOperator {
-		Audio::FWhiteNoise Generator;
+		BachelorDSP::FBrownNoise Generator;
 
 		FAdvancedNoiseOperator_Brown(
 			const FOperatorSettings& InSettings,
@@ -255,26 +310,34 @@ namespace Metasound {
 			FEnumAdvancedNoiseTypeReadRef&& InNoiseTypeReadRef,
 			FFloatReadRef&& InFrequencyReadRef,
 			FFloatReadRef&& InBandwidthReadRef,
-			FFloatReadRef&& InGainReadRef
+			FFloatReadRef&& InGainReadRef,
+			FBoolReadRef&& InUseWavetableReadRef,
+			FBoolReadRef&& InRuntimeTypeReadRef
 			) : FAdvancedNoiseOperator {
 				InSettings,
 				MoveTemp(InSeed),
 				MoveTemp(InNoiseTypeReadRef),
 				MoveTemp(InFrequencyReadRef),
 				MoveTemp(InBandwidthReadRef),
-				MoveTemp(InGainReadRef) },
+				MoveTemp(InGainReadRef),
+				MoveTemp(InUseWavetableReadRef),
+				MoveTemp(InRuntimeTypeReadRef) },
 				Generator {
-					MakeGenerator<Audio::FWhiteNoise>(*Seed)
+					MakeGenerator<BachelorDSP::FBrownNoise>(*Seed)
 				}
 			{}
 
 		void Reset(const FResetParams& InParams) {
 			ResetAdvancedNoiseOperator(Generator);
+			UpdateShaping(true);
+			Shaping.Init();
 			Out->Zero();
 		}
 
 		void Execute() {
+			const BachelorMetasound::FScopedNodeRenderStats RenderStats(BachelorMetasound::ENodeRenderClass::AdvancedNoise, Out->Num());
 			CheckAndReseed(Generator);
+			UpdateShaping();
 			Generate(Generator);
 		}
 		
@@ -294,7 +357,7 @@ namespace Metasound {
 	};
 
 	struct FAdvancedNoiseOperator_Green final : public FAdvancedNoiseOperator {
-		Audio::FWhiteNoise Generator;
+		BachelorDSP::FGreenNoise Generator;
 
 		FAdvancedNoiseOperator_Green(
 			const FOperatorSettings& InSettings,
@@ -302,26 +365,34 @@ namespace Metasound {
 			FEnumAdvancedNoiseTypeReadRef&& InNoiseTypeReadRef,
 			FFloatReadRef&& InFrequencyReadRef,
 			FFloatReadRef&& InBandwidthReadRef,
-			FFloatReadRef&& InGainReadRef
+			FFloatReadRef&& InGainReadRef,
+			FBoolReadRef&& InUseWavetableReadRef,
+			FBoolReadRef&& InRuntimeTypeReadRef
 			) : FAdvancedNoiseOperator {
 				InSettings,
 				MoveTemp(InSeed),
 				MoveTemp(InNoiseTypeReadRef),
 				MoveTemp(InFrequencyReadRef),
 				MoveTemp(InBandwidthReadRef),
-				MoveTemp(InGainReadRef) },
+				MoveTemp(InGainReadRef),
+				MoveTemp(InUseWavetableReadRef),
+				MoveTemp(InRuntimeTypeReadRef) },
 				Generator {
-					MakeGenerator<Audio::FWhiteNoise>(*Seed)
+					MakeGenerator<BachelorDSP::FGreenNoise>(*Seed)
 				}
 			{}
 
 		void Reset(const FResetParams& InParams) {
 			ResetAdvancedNoiseOperator(Generator);
+			UpdateShaping(true);
+			Shaping.Init();
 			Out->Zero();
 		}
 
 		void Execute() {
+			const BachelorMetasound::FScopedNodeRenderStats RenderStats(BachelorMetasound::ENodeRenderClass::AdvancedNoise, Out->Num());
 			CheckAndReseed(Generator);
+			UpdateShaping();
 			Generate(Generator);
 		}
 		
@@ -340,24 +411,281 @@ namespace Metasound {
 		}
 	};
 
+	/** Reads from the shared precomputed noise tables, only keeps a read position per voice. */
+	struct FAdvancedNoiseOperator_Wavetable final : public FAdvancedNoiseOperator {
+		BachelorDSP::ENoiseColor Color;
+		BachelorDSP::FNoiseWavetableReader Reader;
+
+		FAdvancedNoiseOperator_Wavetable(
+			const FOperatorSettings& InSettings,
+			FInt32ReadRef&& InSeed,
+			FEnumAdvancedNoiseTypeReadRef&& InNoiseTypeReadRef,
+			FFloatReadRef&& InFrequencyReadRef,
+			FFloatReadRef&& InBandwidthReadRef,
+			FFloatReadRef&& InGainReadRef,
+			FBoolReadRef&& InUseWavetableReadRef,
+			FBoolReadRef&& InRuntimeTypeReadRef
+			) : FAdvancedNoiseOperator {
+				InSettings,
+				MoveTemp(InSeed),
+				MoveTemp(InNoiseTypeReadRef),
+				MoveTemp(InFrequencyReadRef),
+				MoveTemp(InBandwidthReadRef),
+				MoveTemp(InGainReadRef),
+				MoveTemp(InUseWavetableReadRef),
+				MoveTemp(InRuntimeTypeReadRef) },
+				Color {
+					GetNoiseColor(*NoiseType)
+				},
+				Reader {
+					Color, *Seed
+				}
+			{}
+
+		void Reset(const FResetParams& InParams) {
+			Reader = BachelorDSP::FNoiseWavetableReader(Color, *Seed);
+			OldSeed = *Seed;
+			UpdateShaping(true);
+			Shaping.Init();
+			Out->Zero();
+		}
+
+		void Execute() {
+			const BachelorMetasound::FScopedNodeRenderStats RenderStats(BachelorMetasound::ENodeRenderClass::AdvancedNoise, Out->Num());
+			const int32 NewSeed = *Seed;
+			if (OldSeed != NewSeed) {
+				Reader = BachelorDSP::FNoiseWavetableReader(Color, NewSeed);
+				OldSeed = NewSeed;
+			}
+			UpdateShaping();
+			if (Shaping.IsActive()) {
+				GenerateTo(Reader, Out->GetData(), Out->Num());
+				return;
+			}
+			Reader.Generate(Out->GetData(), Out->Num());
+		}
+
+		static void ResetFunction(IOperator* InOperator, const FResetParams& InParams) {
+			static_cast<FAdvancedNoiseOperator_Wavetable*>(InOperator)->Reset(InParams);
+		}
+		virtual FResetFunction GetResetFunction() override {
+			return &FAdvancedNoiseOperator_Wavetable::ResetFunction;
+		}
+
+		static void ExecuteFunction(IOperator* InOperator) {
+			static_cast<FAdvancedNoiseOperator_Wavetable*>(InOperator)->Execute();
+		}
+		virtual FExecuteFunction GetExecuteFunction() override {
+			return &FAdvancedNoiseOperator_Wavetable::ExecuteFunction;
+		}
+	};
+
+	/**
+	 * Holds the generator of every noise type and reads Type each block, so the type can change without
+	 * rebuilding the graph. A type change crossfades from the previous generator over FadeSeconds. The fade
+	 * is counted in frames and may span blocks, so every block size renders the same signal.
+	 * With Use Wavetable a table reader per type replaces the generators.
+	 */
+	struct FAdvancedNoiseOperator_Dynamic final : public FAdvancedNoiseOperator {
+		/** Length of the crossfade between two types. */
+		static constexpr float FadeSeconds = 0.01f;
+
+		Audio::FWhiteNoise WhiteGenerator;
+		Audio::FPinkNoise PinkGenerator;
+		BachelorDSP::FBrownNoise BrownGenerator;
+		BachelorDSP::FGreenNoise GreenGenerator;
+		EAdvancedNoiseType CurrentType;
+		/** Type faded out, valid while FadeFramesLeft is not zero. */
+		EAdvancedNoiseType FadeType;
+		int32 NumFadeFrames;
+		int32 FadeFramesLeft = 0;
+		TArray<float> FadeBuffer;
+		/** Table reader of every type indexed by ENoiseColor, empty unless Use Wavetable is set. */
+		TArray<BachelorDSP::FNoiseWavetableReader, TFixedAllocator<static_cast<int32>(BachelorDSP::ENoiseColor::Num)>> Readers;
+
+		FAdvancedNoiseOperator_Dynamic(
+			const FOperatorSettings& InSettings,
+			FInt32ReadRef&& InSeed,
+			FEnumAdvancedNoiseTypeReadRef&& InNoiseTypeReadRef,
+			FFloatReadRef&& InFrequencyReadRef,
+			FFloatReadRef&& InBandwidthReadRef,
+			FFloatReadRef&& InGainReadRef,
+			FBoolReadRef&& InUseWavetableReadRef,
+			FBoolReadRef&& InRuntimeTypeReadRef
+			) : FAdvancedNoiseOperator {
+				InSettings,
+				MoveTemp(InSeed),
+				MoveTemp(InNoiseTypeReadRef),
+				MoveTemp(InFrequencyReadRef),
+				MoveTemp(InBandwidthReadRef),
+				MoveTemp(InGainReadRef),
+				MoveTemp(InUseWavetableReadRef),
+				MoveTemp(InRuntimeTypeReadRef) },
+				WhiteGenerator {
+					MakeGenerator<Audio::FWhiteNoise>(*Seed)
+				},
+				PinkGenerator {
+					MakeGenerator<Audio::FPinkNoise>(*Seed)
+				},
+				BrownGenerator {
+					MakeGenerator<BachelorDSP::FBrownNoise>(*Seed)
+				},
+				GreenGenerator {
+					MakeGenerator<BachelorDSP::FGreenNoise>(*Seed)
+				},
+				CurrentType {
+					*NoiseType
+				},
+				FadeType {
+					*NoiseType
+				},
+				NumFadeFrames {
+					FMath::Max(1, FMath::RoundToInt(FadeSeconds * InSettings.GetSampleRate()))
+				}
+			{
+				// Sized once here, so a type change never allocates on the render thread. Blocks are crossfaded
+				// in chunks, so the buffer stays small for large offline blocks.
+				FadeBuffer.SetNumZeroed(FMath::Min(InSettings.GetNumFramesPerBlock(), BachelorDSP::ChunkSize));
+				// The tables are only built if a voice reads them
+				if (*UseWavetable) ResetGenerators();
+			}
+
+		/** Restarts the generators, or the table readers if Use Wavetable is set, from the Seed input. */
+		void ResetGenerators() {
+			if (*UseWavetable) {
+				Readers.Reset();
+				for (int32 Color = 0; Color < static_cast<int32>(BachelorDSP::ENoiseColor::Num); ++Color) {
+					Readers.Emplace(static_cast<BachelorDSP::ENoiseColor>(Color), *Seed);
+				}
+				OldSeed = *Seed;
+				return;
+			}
+			ResetAdvancedNoiseOperator(WhiteGenerator);
+			ResetAdvancedNoiseOperator(PinkGenerator);
+			ResetAdvancedNoiseOperator(BrownGenerator);
+			ResetAdvancedNoiseOperator(GreenGenerator);
+		}
+
+		void Reset(const FResetParams& InParams) {
+			ResetGenerators();
+			CurrentType = *NoiseType;
+			FadeFramesLeft = 0;
+			UpdateShaping(true);
+			Shaping.Init();
+			Out->Zero();
+		}
+
+		void Execute() {
+			const BachelorMetasound::FScopedNodeRenderStats RenderStats(BachelorMetasound::ENodeRenderClass::AdvancedNoise, Out->Num());
+			if (OldSeed != *Seed) ResetGenerators();
+
+			float* OutData = Out->GetData();
+			const int32 NumSamples = Out->Num();
+			// A change during a fade waits for it to end, so the output never jumps between two mixes.
+			const EAdvancedNoiseType NewType = *NoiseType;
+			const bool bStartsFade = FadeFramesLeft == 0 && NewType != CurrentType;
+			if (bStartsFade) {
+				FadeType = CurrentType;
+				CurrentType = NewType;
+				FadeFramesLeft = NumFadeFrames;
+			}
+			// Type decides whether Bandwidth is used, so a type change always recomputes the shaping.
+			UpdateShaping(CurrentType, bStartsFade);
+
+			// Linear crossfade from the previous type into the new one, shaped afterward with one filter state.
+			// Every pass runs per chunk, so the chunk stays in cache between passes. The gain is derived from the
+			// frames left instead of accumulated, so a fade split across blocks renders the same samples.
+			const int32 NumFadeSamples = FMath::Min(FadeFramesLeft, NumSamples);
+			float* FadeData = FadeBuffer.GetData();
+			const float FadeStep = 1.f / static_cast<float>(NumFadeFrames);
+			BachelorDSP::ForEachChunk(NumFadeSamples, [&](const int32 Offset, const int32 NumChunkSamples) {
+				float* ChunkData = OutData + Offset;
+				GenerateType(CurrentType, ChunkData, NumChunkSamples, false);
+				GenerateType(FadeType, FadeData, NumChunkSamples, false);
+				for (int32 Index = 0; Index < NumChunkSamples; ++Index) {
+					const float FadeIn = static_cast<float>(NumFadeFrames - FadeFramesLeft--) * FadeStep;
+					ChunkData[Index] = FadeData[Index] + (ChunkData[Index] - FadeData[Index]) * FadeIn;
+				}
+				if (Shaping.IsActive()) Shaping.Process(ChunkData, ChunkData, NumChunkSamples);
+			});
+
+			if (NumFadeSamples < NumSamples) {
+				GenerateType(CurrentType, OutData + NumFadeSamples, NumSamples - NumFadeSamples, true);
+			}
+		}
+
+		template<typename T>
+		static FORCEINLINE void GenerateInto(T& InGenerator, float* OutData, const int32 NumSamples) {
+			for (int32 Index = 0; Index < NumSamples; ++Index) {
+				OutData[Index] = InGenerator.Generate();
+			}
+		}
+
+		template<typename T>
+		FORCEINLINE void GenerateWith(T& InGenerator, float* OutData, const int32 NumSamples, const bool bShape) {
+			if (bShape) GenerateTo(InGenerator, OutData, NumSamples);
+			else GenerateInto(InGenerator, OutData, NumSamples);
+		}
+
+		void GenerateType(const EAdvancedNoiseType InType, float* OutData, const int32 NumSamples, const bool bShape) {
+			if (Readers.Num() > 0) {
+				GenerateWith(Readers[static_cast<int32>(GetNoiseColor(InType))], OutData, NumSamples, bShape);
+				return;
+			}
+			switch (InType) {
+			case EAdvancedNoiseType::Pink:
+				GenerateWith(PinkGenerator, OutData, NumSamples, bShape);
+				break;
+			case EAdvancedNoiseType::Brown:
+				GenerateWith(BrownGenerator, OutData, NumSamples, bShape);
+				break;
+			case EAdvancedNoiseType::Green:
+				GenerateWith(GreenGenerator, OutData, NumSamples, bShape);
+				break;
+			default:
+				GenerateWith(WhiteGenerator, OutData, NumSamples, bShape);
+				break;
+			}
+		}
+
+		static void ResetFunction(IOperator* InOperator, const FResetParams& InParams) {
+			static_cast<FAdvancedNoiseOperator_Dynamic*>(InOperator)->Reset(InParams);
+		}
+		virtual FResetFunction GetResetFunction() override {
+			return &FAdvancedNoiseOperator_Dynamic::ResetFunction;
+		}
+
+		static void ExecuteFunction(IOperator* InOperator) {
+			static_cast<FAdvancedNoiseOperator_Dynamic*>(InOperator)->Execute();
+		}
+		virtual FExecuteFunction GetExecuteFunction() override {
+			return &FAdvancedNoiseOperator_Dynamic::ExecuteFunction;
+		}
+	};
+
 	FAdvancedNoiseOperator::FAdvancedNoiseOperator(
 		const FOperatorSettings& InSettings,
 		FInt32ReadRef InSeedReadRef,
 		FEnumAdvancedNoiseTypeReadRef InNoiseTypeReadRef,
 		FFloatReadRef InFrequencyReadRef,
 		FFloatReadRef InBandwidthReadRef,
-		FFloatReadRef InGainReadRef
+		FFloatReadRef InGainReadRef,
+		FBoolReadRef InUseWavetableReadRef,
+		FBoolReadRef InRuntimeTypeReadRef
 		) : Seed{ MoveTemp(InSeedReadRef) },
 			NoiseType{ MoveTemp(InNoiseTypeReadRef) },
 			Frequency{ MoveTemp(InFrequencyReadRef) },
 			Bandwidth{ MoveTemp(InBandwidthReadRef) },
 			Gain{ MoveTemp(InGainReadRef) },
+			UseWavetable{ MoveTemp(InUseWavetableReadRef) },
+			RuntimeType{ MoveTemp(InRuntimeTypeReadRef) },
 			Out{ FAudioBufferWriteRef::CreateNew(InSettings) },
+			SampleRate(InSettings.GetSampleRate()),
 			OldSeed(*Seed),
-			OldFrequency(*Frequency),
-			OldBandwidth(*Bandwidth),
-			OldGain(*Gain)
-		{}
+			ShapingParameters(InSettings.GetActualBlockRate())
+		{
+			UpdateShaping(true);
+		}
 
 	void FAdvancedNoiseOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData) {
 		using namespace AdvancedNoiseGeneratorVertexNames;
@@ -366,6 +694,8 @@ namespace Metasound {
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputFrequency), Frequency);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBandwidth), Bandwidth);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGain), Gain);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputUseWavetable), UseWavetable);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRuntimeType), RuntimeType);
 	}
 
 	void FAdvancedNoiseOperator::BindOutputs(FOutputVertexInterfaceData& InOutVertexData) {
@@ -383,7 +713,9 @@ namespace Metasound {
     				),
     			TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputFrequency), 2000.f),
     			TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBandwidth), 0.f),
-    			TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain), 0.f)
+    			TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain), 0.f),
+    			TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputUseWavetable), DefaultUseWavetable),
+    			TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRuntimeType), DefaultRuntimeType)
 			),
 		FOutputVertexInterface(
     				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudio))
@@ -397,7 +729,7 @@ namespace Metasound {
 			FNodeClassMetadata Info;
 			Info.ClassName = { TEXT("UE"), TEXT("Noise"), TEXT("Generators") };
 			Info.MajorVersion = 1;
-			Info.MinorVersion = 0;
+			Info.MinorVersion = 2;
 			Info.DisplayName = METASOUND_LOCTEXT("Metasound_AdvancedNoiseNodeDisplayNameX", "Advanced Noise");
 			Info.Description = METASOUND_LOCTEXT("Metasound_AdvancedNoiseNodeDescription",
 				"Advanced Noise Generator that produces different types of noise, and gives Control over Gain and Frequency.");
@@ -455,6 +787,37 @@ namespace Metasound {
 			InputInterface, METASOUND_GET_PARAM_NAME(InputBandwidth), Settings);
 		FFloatReadRef Gain = InputCol.GetDataReadReferenceOrConstructWithVertexDefault<float>(
 			InputInterface, METASOUND_GET_PARAM_NAME(InputGain), Settings);
+		// Static property pin, only used for factory.
+		FBoolReadRef UseWavetable = InputCol.GetDataReadReferenceOrConstructWithVertexDefault<bool>(
+			InputInterface, METASOUND_GET_PARAM_NAME(InputUseWavetable), Settings);
+		// Static property pin, only used for factory.
+		FBoolReadRef RuntimeType = InputCol.GetDataReadReferenceOrConstructWithVertexDefault<bool>(
+			InputInterface, METASOUND_GET_PARAM_NAME(InputRuntimeType), Settings);
+
+		// Handles Use Wavetable itself, so it comes first
+		if (*RuntimeType) {
+			return MakeUnique<FAdvancedNoiseOperator_Dynamic>(
+				InParams.OperatorSettings,
+				MoveTemp(Seed),
+				MoveTemp(Type),
+				MoveTemp(Frequency),
+				MoveTemp(Bandwidth),
+				MoveTemp(Gain),
+				MoveTemp(UseWavetable),
+				MoveTemp(RuntimeType));
+		}
+
+		if (*UseWavetable) {
+			return MakeUnique<FAdvancedNoiseOperator_Wavetable>(
+				InParams.OperatorSettings,
+				MoveTemp(Seed),
+				MoveTemp(Type),
+				MoveTemp(Frequency),
+				MoveTemp(Bandwidth),
+				MoveTemp(Gain),
+				MoveTemp(UseWavetable),
+				MoveTemp(RuntimeType));
+		}
 	
 		switch (*Type)
 		{
@@ -466,7 +829,9 @@ namespace Metasound {
 				MoveTemp(Type),
 				MoveTemp(Frequency),
 				MoveTemp(Bandwidth),
-				MoveTemp(Gain));
+				MoveTemp(Gain),
+				MoveTemp(UseWavetable),
+				MoveTemp(RuntimeType));
 		case EAdvancedNoiseType::Pink:
 			return MakeUnique<FAdvancedNoiseOperator_Pink>(
 				InParams.OperatorSettings,
@@ -474,7 +839,9 @@ namespace Metasound {
 				MoveTemp(Type),
 				MoveTemp(Frequency),
 				MoveTemp(Bandwidth),
-				MoveTemp(Gain));
+				MoveTemp(Gain),
+				MoveTemp(UseWavetable),
+				MoveTemp(RuntimeType));
 		case EAdvancedNoiseType::Brown:
 			return MakeUnique<FAdvancedNoiseOperator_Brown>(
 				InParams.OperatorSettings,
@@ -482,7 +849,9 @@ namespace Metasound {
 				MoveTemp(Type),
 				MoveTemp(Frequency),
 				MoveTemp(Bandwidth),
-				MoveTemp(Gain));
+				MoveTemp(Gain),
+				MoveTemp(UseWavetable),
+				MoveTemp(RuntimeType));
 		case EAdvancedNoiseType::Green:
 			return MakeUnique<FAdvancedNoiseOperator_Green>(
 				InParams.OperatorSettings,
@@ -490,7 +859,9 @@ namespace Metasound {
 				MoveTemp(Type),
 				MoveTemp(Frequency),
 				MoveTemp(Bandwidth),
-				MoveTemp(Gain));
+				MoveTemp(Gain),
+				MoveTemp(UseWavetable),
+				MoveTemp(RuntimeType));
 		}
 		checkNoEntry();
 		return nullptr;
@@ -0,0 +1,179 @@
+﻿/**
+ * @file BachelorOfflineRenderCommandlet.cpp
+ * @brief Headless entry point of the offline renderer.
+ */
+
+#include "Commandlets/BachelorOfflineRenderCommandlet.h"
+
+#include "BachelorMetasoundModule.h"
+#include "OfflineRenderer.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace BachelorMetasound::OfflineRenderCommandlet {
+
+	bool ParseNoiseColor(const FString& InName, BachelorDSP::ENoiseColor& OutColor) {
+		static const TCHAR* Names[] = { TEXT("White"), TEXT("Pink"), TEXT("Brown"), TEXT("Green") };
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(Names); ++Index) {
+			if (InName.Equals(Names[Index], ESearchCase::IgnoreCase)) {
+				OutColor = static_cast<BachelorDSP::ENoiseColor>(Index);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Reads a stage, parameter names are listed in the order FOfflineRenderStage expects them. */
+	bool ParseStage(const FJsonObject& InObject, FOfflineRenderStage& OutStage) {
+		const FString TypeName = InObject.GetStringField(TEXT("Type"));
+		TArray<const TCHAR*, TInlineAllocator<3>> ParameterNames;
+		if (TypeName == TEXT("Volume")) {
+			OutStage.Type = BachelorDSP::EDSPType::Volume;
+			ParameterNames = { TEXT("Amplitude") };
+		} else if (TypeName == TEXT("NotchFilter")) {
+			OutStage.Type = BachelorDSP::EDSPType::NotchFilter;
+			ParameterNames = { TEXT("Cutoff"), TEXT("Bandwidth") };
+		} else if (TypeName == TEXT("PeakingFilter")) {
+			OutStage.Type = BachelorDSP::EDSPType::PeakingFilter;
+			ParameterNames = { TEXT("Frequency"), TEXT("Quality"), TEXT("Gain") };
+		} else {
+			return false;
+		}
+		for (const TCHAR* ParameterName : ParameterNames) {
+			double Value = 0.0;
+			InObject.TryGetNumberField(ParameterName, Value);
+			OutStage.Parameters.Add(static_cast<float>(Value));
+		}
+		return true;
+	}
+
+	bool ParseJobs(
+		const FString& InJobFile,
+		const FString& InOutputDir,
+		TArray<FOfflineRenderJob>& OutJobs,
+		TArray<FString>& OutNames
+	) {
+		FString JobText;
+		if (!FFileHelper::LoadFileToString(JobText, *InJobFile)) {
+			UE_LOG(LogBachelorMetasound, Error, TEXT("Can not read job file %s"), *InJobFile);
+			return false;
+		}
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JobText), Root) || !Root.IsValid()) {
+			UE_LOG(LogBachelorMetasound, Error, TEXT("Job file %s is no valid JSON"), *InJobFile);
+			return false;
+		}
+
+		const FString BaseDir = FPaths::GetPath(InJobFile);
+		int32 SampleRate = 48000;
+		Root->TryGetNumberField(TEXT("SampleRate"), SampleRate);
+
+		const TArray<TSharedPtr<FJsonValue>>* JobValues = nullptr;
+		if (!Root->TryGetArrayField(TEXT("Jobs"), JobValues)) {
+			UE_LOG(LogBachelorMetasound, Error, TEXT("Job file %s has no Jobs array"), *InJobFile);
+			return false;
+		}
+
+		// File names of all jobs, FString compares ignore case just like most file systems do.
+		TSet<FString> FileNames;
+		for (const TSharedPtr<FJsonValue>& JobValue : *JobValues) {
+			const TSharedPtr<FJsonObject> JobObject = JobValue->AsObject();
+			if (!JobObject.IsValid()) continue;
+
+			const FString Name = JobObject->GetStringField(TEXT("Name"));
+			if (Name.IsEmpty()) {
+				UE_LOG(LogBachelorMetasound, Error, TEXT("Job %d has no Name"), OutJobs.Num());
+				return false;
+			}
+			// The name becomes a file name, so it must not leave the output directory or overwrite another job.
+			const FString FileName = FPaths::MakeValidFileName(Name);
+			bool bIsDuplicate = false;
+			FileNames.Add(FileName, &bIsDuplicate);
+			if (bIsDuplicate) {
+				UE_LOG(LogBachelorMetasound, Error, TEXT("Job %s: the output name %s is used by another job"), *Name, *FileName);
+				return false;
+			}
+
+			FOfflineRenderJob& Job = OutJobs.AddDefaulted_GetRef();
+			OutNames.Add(Name);
+			Job.SampleRate = SampleRate;
+			Job.OutputPath = FPaths::Combine(InOutputDir, FileName + TEXT(".wav"));
+
+			FString InputPath;
+			if (JobObject->TryGetStringField(TEXT("Input"), InputPath)) {
+				Job.InputPath = FPaths::IsRelative(InputPath) ? FPaths::Combine(BaseDir, InputPath) : InputPath;
+			} else {
+				FString NoiseName = TEXT("White");
+				JobObject->TryGetStringField(TEXT("Noise"), NoiseName);
+				if (!ParseNoiseColor(NoiseName, Job.NoiseColor)) {
+					UE_LOG(LogBachelorMetasound, Error, TEXT("Job %s: unknown noise %s"), *Name, *NoiseName);
+					return false;
+				}
+				JobObject->TryGetNumberField(TEXT("Seed"), Job.Seed);
+				double Seconds = 1.0;
+				JobObject->TryGetNumberField(TEXT("Seconds"), Seconds);
+				Job.NumFrames = FMath::RoundToInt32(Seconds * SampleRate);
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* StageValues = nullptr;
+			if (!JobObject->TryGetArrayField(TEXT("Chain"), StageValues)) continue;
+			for (const TSharedPtr<FJsonValue>& StageValue : *StageValues) {
+				const TSharedPtr<FJsonObject> StageObject = StageValue->AsObject();
+				if (!StageObject.IsValid() || !ParseStage(*StageObject, Job.Chain.AddDefaulted_GetRef())) {
+					UE_LOG(LogBachelorMetasound, Error, TEXT("Job %s: invalid chain stage"), *Name);
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+UBachelorOfflineRenderCommandlet::UBachelorOfflineRenderCommandlet() {
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBachelorOfflineRenderCommandlet::Main(const FString& Params) {
+	using namespace BachelorMetasound;
+
+	FString JobFile;
+	if (!FParse::Value(*Params, TEXT("Jobs="), JobFile)) {
+		UE_LOG(LogBachelorMetasound, Error, TEXT("Usage: -run=BachelorOfflineRender -Jobs=<file.json> [-Output=<dir>] [-SingleThreaded]"));
+		return 1;
+	}
+	JobFile = FPaths::ConvertRelativePathToFull(JobFile);
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputDir)) {
+		OutputDir = FPaths::Combine(FPaths::GetPath(JobFile), TEXT("Out"));
+	}
+	const bool bSingleThreaded = FParse::Param(*Params, TEXT("SingleThreaded"));
+
+	TArray<FOfflineRenderJob> Jobs;
+	TArray<FString> Names;
+	if (!OfflineRenderCommandlet::ParseJobs(JobFile, FPaths::ConvertRelativePathToFull(OutputDir), Jobs, Names)) return 1;
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	const TArray<FOfflineRenderResult> Results = FOfflineRenderer::Render(Jobs, bSingleThreaded);
+	const double TotalSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+	int32 NumFailed = 0;
+	for (int32 Index = 0; Index < Results.Num(); ++Index) {
+		const FOfflineRenderResult& Result = Results[Index];
+		if (Result.bSucceeded) {
+			UE_LOG(LogBachelorMetasound, Display, TEXT("%s: %d frames in %.3f s -> %s"),
+				*Names[Index], Result.NumFrames, Result.Seconds, *Jobs[Index].OutputPath);
+			continue;
+		}
+		UE_LOG(LogBachelorMetasound, Error, TEXT("%s: %s"), *Names[Index], *Result.Error);
+		++NumFailed;
+	}
+	UE_LOG(LogBachelorMetasound, Display, TEXT("Rendered %d of %d jobs in %.3f s"),
+		Results.Num() - NumFailed, Results.Num(), TotalSeconds);
+	return NumFailed == 0 ? 0 : 1;
+}
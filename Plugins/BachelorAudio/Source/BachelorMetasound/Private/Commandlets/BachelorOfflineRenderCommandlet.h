@@ -0,0 +1,49 @@
+﻿/**
+ * @file BachelorOfflineRenderCommandlet.h
+ * @brief Headless entry point of the offline renderer.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BachelorOfflineRenderCommandlet.generated.h"
+
+/**
+ * @class UBachelorOfflineRenderCommandlet
+ * @brief Renders the jobs of a JSON file into WAV files, see BachelorMetasound::FOfflineRenderer.
+ *
+ * Usage, e.g. on a Linux build box:
+ * UnrealEditor-Cmd prototype.uproject -run=BachelorOfflineRender -Jobs=Render/Jobs.json
+ * [-Output=Render/Out] [-SingleThreaded] -nullrhi -nosound -unattended
+ *
+ * The job file looks like
+ * {
+ *   "SampleRate": 48000,
+ *   "Jobs": [
+ *     { "Name": "Drop_01", "Noise": "Pink", "Seed": 3, "Seconds": 2.0,
+ *       "Chain": [ { "Type": "NotchFilter", "Cutoff": 440, "Bandwidth": 0.9 }, { "Type": "Volume", "Amplitude": 0.5 } ] },
+ *     { "Name": "Impact_01", "Input": "Render/Impact.wav",
+ *       "Chain": [ { "Type": "PeakingFilter", "Frequency": 2000, "Quality": 0.7, "Gain": 6 } ] }
+ *   ]
+ * }
+ * Relative paths are relative to the job file, every job is written to <Output>/<Name>.wav.
+ */
+UCLASS()
+class UBachelorOfflineRenderCommandlet : public UCommandlet {
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Default constructor.
+	 */
+	UBachelorOfflineRenderCommandlet();
+
+	/**
+	 * @brief Parses the job file, renders all jobs and logs one line per job.
+	 *
+	 * @param Params Command line of the commandlet.
+	 * @return 0 if every job was written, 1 otherwise.
+	 */
+	virtual int32 Main(const FString& Params) override;
+};
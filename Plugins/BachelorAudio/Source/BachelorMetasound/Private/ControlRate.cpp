@@ -0,0 +1,44 @@
+﻿/**
+ * @file ControlRate.cpp
+ * @brief Control-rate evaluation of operator parameters.
+ */
+
+#include "ControlRate.h"
+
+#include "HAL/IConsoleManager.h"
+
+namespace BachelorMetasound {
+
+	namespace ControlRate {
+
+		float DecimationMsCVar = 0.f;
+		FAutoConsoleVariableRef CVarDecimationMs(
+			TEXT("au.BachelorMetasound.ControlRate.DecimationMs"),
+			DecimationMsCVar,
+			TEXT("BachelorMetasound operators re-evaluate their parameters every this many milliseconds, rounded to whole blocks.\n0: every block"),
+			ECVF_Default);
+
+		float EpsilonCVar = 0.f;
+		FAutoConsoleVariableRef CVarEpsilon(
+			TEXT("au.BachelorMetasound.ControlRate.Epsilon"),
+			EpsilonCVar,
+			TEXT("Parameter changes up to this absolute difference are ignored.\n0: every change counts"),
+			ECVF_Default);
+
+		float SmoothingMsCVar = 0.f;
+		FAutoConsoleVariableRef CVarSmoothingMs(
+			TEXT("au.BachelorMetasound.ControlRate.SmoothingMs"),
+			SmoothingMsCVar,
+			TEXT("Parameter changes are ramped over this many milliseconds, rounded to whole blocks.\n0: no smoothing"),
+			ECVF_Default);
+	}
+
+	FControlRateSettings FControlRateSettings::GetDefault() {
+		FControlRateSettings Settings;
+		Settings.DecimationMs = ControlRate::DecimationMsCVar;
+		Settings.Epsilon = ControlRate::EpsilonCVar;
+		Settings.SmoothingMs = ControlRate::SmoothingMsCVar;
+		return Settings;
+	}
+
+}
@@ -0,0 +1,152 @@
+﻿/**
+ * @file ControlRate.h
+ * @brief Control-rate evaluation of operator parameters.
+ *
+ * Operators read their parameter inputs every block, but derived values like filter coefficients only
+ * need to follow them at control rate. TControlRateParameters looks at the inputs every few milliseconds,
+ * ignores changes within an epsilon and ramps accepted changes over a number of milliseconds, so the
+ * derived values are only recomputed while something actually moves.
+ *
+ * Times are converted to whole blocks with the block rate of the operator, so the same settings
+ * behave the same at every block size up to the rounding to one block. The defaults (every block, no
+ * epsilon, no smoothing) keep the previous sample exact behavior. The console variables
+ * au.BachelorMetasound.ControlRate.* change the settings of newly built operators.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace BachelorMetasound {
+
+	/**
+	 * @struct FControlRateSettings
+	 * @brief How often and how exact parameters are re-evaluated.
+	 */
+	struct BACHELORMETASOUND_API FControlRateSettings {
+		/** Inputs are looked at every this many milliseconds, 0 checks every block. */
+		float DecimationMs = 0.f;
+
+		/** Changes up to this absolute difference are ignored. */
+		float Epsilon = 0.f;
+
+		/** Accepted changes are ramped linearly over this many milliseconds, 0 jumps. */
+		float SmoothingMs = 0.f;
+
+		/** @return Settings of the au.BachelorMetasound.ControlRate console variables. */
+		static FControlRateSettings GetDefault();
+	};
+
+	/**
+	 * @class TControlRateParameters
+	 * @brief A group of parameters evaluated together at control rate.
+	 *
+	 * Grouped parameters share one decimation counter and one ramp, so e.g. all inputs of a filter
+	 * arrive at their targets in the same block. Update() is meant to be called once per block with the
+	 * current inputs, derived values are recomputed only if it returns true.
+	 *
+	 * @tparam NumValues Number of parameters in the group.
+	 */
+	template<int32 NumValues>
+	class TControlRateParameters {
+	public:
+		/**
+		 * @param InBlockRate Blocks per second of the operator, converts the settings to blocks.
+		 * @param InSettings Decimation, epsilon and smoothing of the group.
+		 */
+		explicit TControlRateParameters(
+			const float InBlockRate,
+			const FControlRateSettings& InSettings = FControlRateSettings::GetDefault()
+		) : Epsilon(InSettings.Epsilon),
+			NumDecimationBlocks(FMath::Max(ToBlocks(InSettings.DecimationMs, InBlockRate), 1)),
+			NumSmoothingBlocks(FMath::Max(ToBlocks(InSettings.SmoothingMs, InBlockRate), 0)) {}
+
+		/**
+		 * @brief Advances one block.
+		 *
+		 * The first call after construction or Reset() takes the inputs as they are.
+		 *
+		 * @param InInputs Current values of the inputs.
+		 * @return True if the values changed and derived values have to be recomputed.
+		 */
+		bool Update(const float (&InInputs)[NumValues]) {
+			if (!bInitialized) {
+				Jump(InInputs);
+				return true;
+			}
+
+			if (++NumBlocksSinceCheck >= NumDecimationBlocks) {
+				NumBlocksSinceCheck = 0;
+				if (HasChanged(InInputs)) StartRamp(InInputs);
+			}
+
+			if (NumRemainingSteps == 0) return false;
+			if (--NumRemainingSteps == 0) {
+				FMemory::Memcpy(Values, Targets, sizeof(Values));
+				return true;
+			}
+			for (int32 Index = 0; Index < NumValues; ++Index) {
+				Values[Index] += Steps[Index];
+			}
+			return true;
+		}
+
+		/** Forgets all values, the next Update() takes its inputs without smoothing. */
+		void Reset() {
+			bInitialized = false;
+			NumRemainingSteps = 0;
+			NumBlocksSinceCheck = 0;
+		}
+
+		/** @return Current, possibly smoothed value of a parameter. */
+		FORCEINLINE float operator[](const int32 InIndex) const { return Values[InIndex]; }
+
+	private:
+		static int32 ToBlocks(const float InMs, const float InBlockRate) {
+			return FMath::RoundToInt(FMath::Max(InMs, 0.f) * 0.001f * InBlockRate);
+		}
+
+		void Jump(const float (&InInputs)[NumValues]) {
+			FMemory::Memcpy(Values, InInputs, sizeof(Values));
+			FMemory::Memcpy(Targets, InInputs, sizeof(Targets));
+			NumRemainingSteps = 0;
+			NumBlocksSinceCheck = 0;
+			bInitialized = true;
+		}
+
+		bool HasChanged(const float (&InInputs)[NumValues]) const {
+			for (int32 Index = 0; Index < NumValues; ++Index) {
+				// Exact compare first, so an epsilon of 0 still catches every change.
+				if (InInputs[Index] != Targets[Index] && FMath::Abs(InInputs[Index] - Targets[Index]) > Epsilon) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void StartRamp(const float (&InInputs)[NumValues]) {
+			FMemory::Memcpy(Targets, InInputs, sizeof(Targets));
+			if (NumSmoothingBlocks == 0) {
+				// Finishes with the copy in Update() within this block.
+				NumRemainingSteps = 1;
+				return;
+			}
+			const float Scale = 1.f / static_cast<float>(NumSmoothingBlocks);
+			for (int32 Index = 0; Index < NumValues; ++Index) {
+				Steps[Index] = (Targets[Index] - Values[Index]) * Scale;
+			}
+			NumRemainingSteps = NumSmoothingBlocks;
+		}
+
+		float Epsilon;
+		int32 NumDecimationBlocks;
+		int32 NumSmoothingBlocks;
+		float Values[NumValues] = {};
+		float Targets[NumValues] = {};
+		float Steps[NumValues] = {};
+		int32 NumRemainingSteps = 0;
+		int32 NumBlocksSinceCheck = 0;
+		bool bInitialized = false;
+	};
+
+}
@@ -4,7 +4,7 @@ struct FAdvancedNoiseParameterPack {
 	float Frequency						= 2000.f;
 	float Gain							= 0.f;
 	float Bandwidth						= 0.f;
-	float Scale							= 0.f;
+	float Scale							= 1.f; // Brown and Green multiply by it, 0 would silence them
 	float Offset						= 0.f;
 };
 
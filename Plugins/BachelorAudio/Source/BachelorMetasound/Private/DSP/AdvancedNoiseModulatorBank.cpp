@@ -0,0 +1,123 @@
+﻿#include "AdvancedNoiseModulatorBank.h"
+
+FAdvancedNoiseModulatorBank::FAdvancedNoiseModulatorBank(
+	const float InControlRate,
+	const int32 InitialCapacity,
+	const int32 InSeed
+	) : ControlRate(InControlRate),
+		BaseSeed(static_cast<uint32>(InSeed == INDEX_NONE ? FPlatformTime::Cycles() : InSeed)) {
+	Types.Reserve(InitialCapacity);
+	RandomState.Reserve(InitialCapacity);
+	ForEachFloatArray([InitialCapacity](TArray<float>& Array) { Array.Reserve(InitialCapacity); });
+}
+
+int32 FAdvancedNoiseModulatorBank::Add(const FAdvancedNoiseParameterPack& ParameterPack, const uint8 Type) {
+	const int32 Index = Types.Add(Type > 3 ? 0 : Type);
+	RandomState.Add(MakeRandomState(NumAdded++));
+	ForEachFloatArray([](TArray<float>& Array) { Array.Add(0.f); });
+	SetParameters(Index, ParameterPack);
+	return Index;
+}
+
+void FAdvancedNoiseModulatorBank::RemoveAtSwap(const int32 Index) {
+	Types.RemoveAtSwap(Index, 1, false);
+	RandomState.RemoveAtSwap(Index, 1, false);
+	ForEachFloatArray([Index](TArray<float>& Array) { Array.RemoveAtSwap(Index, 1, false); });
+}
+
+void FAdvancedNoiseModulatorBank::SetParameters(const int32 Index, const FAdvancedNoiseParameterPack& ParameterPack) {
+	Frequency[Index] = ParameterPack.Frequency;
+	Gain[Index] = ParameterPack.Gain;
+	Bandwidth[Index] = ParameterPack.Bandwidth;
+	Scale[Index] = ParameterPack.Scale;
+	Offset[Index] = ParameterPack.Offset;
+	SetCoefficients(Index);
+}
+
+void FAdvancedNoiseModulatorBank::SetType(const int32 Index, const uint8 NewType) {
+	Types[Index] = NewType > 3 ? 0 : NewType;
+	SetCoefficients(Index);
+}
+
+void FAdvancedNoiseModulatorBank::Process(TArrayView<float> OutValues) {
+	const int32 Count = Num();
+	check(OutValues.Num() >= Count);
+
+	uint32* RESTRICT Random = RandomState.GetData();
+	float* RESTRICT Pink = PinkState.GetData();
+	float* RESTRICT Brown = BrownState.GetData();
+	float* RESTRICT Smooth = SmoothState.GetData();
+	float* RESTRICT Band = BandState.GetData();
+	const float* RESTRICT White_W = WhiteWeight.GetData();
+	const float* RESTRICT Pink_W = PinkWeight.GetData();
+	const float* RESTRICT Brown_W = BrownWeight.GetData();
+	const float* RESTRICT Green_W = GreenWeight.GetData();
+	const float* RESTRICT Smooth_C = SmoothCoefficient.GetData();
+	const float* RESTRICT Band_C = BandCoefficient.GetData();
+	const float* RESTRICT Gain_L = GainLin.GetData();
+	const float* RESTRICT Scale_L = ScaleLin.GetData();
+	const float* RESTRICT Offset_L = OffsetLin.GetData();
+	float* RESTRICT Out = OutValues.GetData();
+
+	// No branches on the noise type, every color is computed and selected by weight, so the loop vectorizes.
+	for(int32 i = 0; i < Count; ++i) {
+		uint32 X = Random[i];
+		X ^= X << 13;
+		X ^= X >> 17;
+		X ^= X << 5;
+		Random[i] = X;
+		const float White = static_cast<float>(static_cast<int32>(X)) * (1.f / 2147483648.f);
+
+		Pink[i] = 0.9f * Pink[i] + 0.1f * White;
+		Brown[i] = (Brown[i] + 0.02f * White) * (1.f / 1.02f);
+		const float Colored = (White_W[i] + Green_W[i]) * White
+			+ Pink_W[i] * (0.5f * White + 2.f * Pink[i])
+			+ Brown_W[i] * 3.5f * Brown[i];
+
+		Smooth[i] += Smooth_C[i] * (Colored - Smooth[i]);
+		Band[i] += Band_C[i] * (Colored - Band[i]);
+		// Green keeps the band between both low passes, all other colors the plain low pass.
+		const float Shaped = Smooth[i] - Green_W[i] * Band[i];
+
+		Out[i] = Offset_L[i] + Scale_L[i] * Gain_L[i] * Shaped;
+	}
+}
+
+void FAdvancedNoiseModulatorBank::SetCoefficients(const int32 Index) {
+	const uint8 Type = Types[Index];
+	const float Nyquist = 0.5f * ControlRate;
+	auto OnePole = [this, Nyquist](const float Cutoff) {
+		if(ControlRate <= 0.f) return 1.f;
+		return 1.f - FMath::Exp(-2.f * PI * FMath::Clamp(Cutoff, 0.f, Nyquist) / ControlRate);
+	};
+
+	SmoothCoefficient[Index] = OnePole(Frequency[Index]);
+	BandCoefficient[Index] = OnePole(Frequency[Index] * FMath::Clamp(Bandwidth[Index], 0.f, 0.99f));
+	GainLin[Index] = FMath::Pow(10.f, Gain[Index] / 20.f);
+	ScaleLin[Index] = Type < 2 ? 1.f : Scale[Index];
+	OffsetLin[Index] = Type < 2 ? 0.f : Offset[Index];
+	WhiteWeight[Index] = Type == 0 ? 1.f : 0.f;
+	PinkWeight[Index] = Type == 1 ? 1.f : 0.f;
+	BrownWeight[Index] = Type == 2 ? 1.f : 0.f;
+	GreenWeight[Index] = Type == 3 ? 1.f : 0.f;
+}
+
+uint32 FAdvancedNoiseModulatorBank::MakeRandomState(const uint32 Serial) const {
+	uint32 Hash = BaseSeed + 0x9E3779B9u * (Serial + 1);
+	Hash ^= Hash >> 16;
+	Hash *= 0x85EBCA6Bu;
+	Hash ^= Hash >> 13;
+	Hash *= 0xC2B2AE35u;
+	Hash ^= Hash >> 16;
+	return Hash != 0 ? Hash : 0x6D2B79F5u;
+}
+
+void FAdvancedNoiseModulatorBank::ForEachFloatArray(TFunctionRef<void(TArray<float>&)> Func) {
+	for(TArray<float>* Array : {
+		&Frequency, &Gain, &Bandwidth, &Scale, &Offset,
+		&GainLin, &ScaleLin, &OffsetLin, &SmoothCoefficient, &BandCoefficient,
+		&WhiteWeight, &PinkWeight, &BrownWeight, &GreenWeight,
+		&PinkState, &BrownState, &SmoothState, &BandState }) {
+		Func(*Array);
+	}
+}
@@ -0,0 +1,85 @@
+﻿#pragma once
+
+#include "AdvancedNoiseModulator.h"
+
+/**
+ * Holds the state of many noise modulators as structure of arrays and advances all of them in one pass.
+ *
+ * Meant for control rate modulation of many emitters, e.g. one flicker modulator per cave drop, where one
+ * FAdvancedNoiseModulator object per emitter would cost a virtual call and a cache miss each.
+ * Every field of FAdvancedNoiseModulator lives in its own contiguous array, indexed by modulator.
+ *
+ * Output of a modulator per tick: noise of its type, low passed at Frequency, scaled by Gain (dB).
+ * Brown and Green additionally apply Scale and Offset, Green uses Bandwidth as relative band width.
+ * Parameters take effect with the next Process(), there is no parameter history to advance.
+ */
+class BACHELORMETASOUND_API FAdvancedNoiseModulatorBank {
+public:
+	FAdvancedNoiseModulatorBank() = delete;
+
+	/**
+	 * @param InControlRate Ticks per second Process() is called with, by value instead of reference.
+	 * @param InitialCapacity Number of modulators to preallocate.
+	 * @param InSeed Base seed, INDEX_NONE picks a time based seed.
+	 */
+	FAdvancedNoiseModulatorBank(
+		const float InControlRate,
+		const int32 InitialCapacity,
+		const int32 InSeed = INDEX_NONE
+		);
+
+	/** Adds a modulator and returns its index. Indices are stable until RemoveAtSwap. */
+	int32 Add(const FAdvancedNoiseParameterPack& ParameterPack, const uint8 Type);
+
+	/** Removes a modulator, the last modulator takes its index. */
+	void RemoveAtSwap(const int32 Index);
+
+	int32 Num() const { return Types.Num(); }
+
+	void SetParameters(const int32 Index, const FAdvancedNoiseParameterPack& ParameterPack);
+	void SetType(const int32 Index, const uint8 NewType);
+	uint8 GetType(const int32 Index) const { return Types[Index]; }
+
+	/**
+	 * Advances all modulators by one control tick.
+	 * @param OutValues Receives one value per modulator, must hold Num() entries.
+	 */
+	void Process(TArrayView<float> OutValues);
+
+private:
+	void SetCoefficients(const int32 Index);
+	uint32 MakeRandomState(const uint32 Serial) const;
+	void ForEachFloatArray(TFunctionRef<void(TArray<float>&)> Func);
+
+	float ControlRate;
+	uint32 BaseSeed;
+	// Modulators added so far, seeds every new modulator with its own sequence even if it reuses an index
+	uint32 NumAdded = 0;
+
+	TArray<uint8> Types; // 0-White 1-Pink 2-Brown 3-Green
+
+	// Parameters
+	TArray<float> Frequency;
+	TArray<float> Gain;
+	TArray<float> Bandwidth;
+	TArray<float> Scale;
+	TArray<float> Offset;
+
+	// Derived coefficients, branch free selection of the noise color
+	TArray<float> GainLin;
+	TArray<float> ScaleLin;
+	TArray<float> OffsetLin;
+	TArray<float> SmoothCoefficient;
+	TArray<float> BandCoefficient;
+	TArray<float> WhiteWeight;
+	TArray<float> PinkWeight;
+	TArray<float> BrownWeight;
+	TArray<float> GreenWeight;
+
+	// Noise state
+	TArray<uint32> RandomState;
+	TArray<float> PinkState;
+	TArray<float> BrownState;
+	TArray<float> SmoothState;
+	TArray<float> BandState;
+};
@@ -7,6 +7,7 @@
 
 
 #include "DSP/BachelorVolume.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 BachelorDSP::FBachelorVolume::FBachelorVolume()
 	: FProcessorBase(EDSPType::Volume), Amplitude(0.f) {}
@@ -29,11 +30,11 @@ void BachelorDSP::FBachelorVolume::SetAmplitude(const float NewAmplitude) {
 void BachelorDSP::FBachelorVolume::InitVolume() {}
 
 void BachelorDSP::FBachelorVolume::ProcessVolumeBuffer(const float* InBuffer, float* OutBuffer, const int32 InNumSamples) {
-	// Uncomment to profile the cost of this DSP processing in Unreal Insights
-	//TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("FVolume::ProcessAudioBuffer"))
+	// Shows up in Unreal Insights when the cpu trace channel is enabled, costs a branch otherwise
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBachelorVolume::ProcessVolumeBuffer);
 
 	// Naive version (and without parameter smoothing)
 	for (int32 Index = 0; Index < InNumSamples; ++Index) {
-		OutBuffer[Index] = Amplitude * InBuffer[Index];
+		OutBuffer[Index] = ProcessSample(InBuffer[Index]);
 	}
 }
@@ -64,6 +64,14 @@ namespace BachelorDSP {
 		 */
 		void SetAmplitude(const float NewAmplitude);
 
+		/**
+		 * @brief Scales a single sample, the kernel of Process().
+		 * 
+		 * @param InSample Input sample.
+		 * @return Scaled sample.
+		 */
+		FORCEINLINE float ProcessSample(const float InSample) const { return Amplitude * InSample; }
+
 	private:
 		/**
 		 * @brief Internal initialization logic for volume settings.
@@ -0,0 +1,42 @@
+﻿/**
+ * @file ColoredNoise.cpp
+ * @brief Per-sample brown and green noise generators for BachelorDSP.
+ */
+
+#include "DSP/ColoredNoise.h"
+
+namespace BachelorDSP::ColoredNoise {
+	/** RMS the brown noise is scaled to, keeps the peaks of the random walk within full scale. */
+	constexpr float BrownRms = 0.25f;
+
+}
+
+BachelorDSP::FBrownNoise::FBrownNoise()
+	: Gain(GetMakeupGain()) {}
+
+BachelorDSP::FBrownNoise::FBrownNoise(const int32 InSeed)
+	: White(InSeed),
+	  Gain(GetMakeupGain()) {}
+
+float BachelorDSP::FBrownNoise::GetMakeupGain() {
+	// The integrator keeps (1 - Leak) / sqrt(1 - Leak^2) of the white noise RMS of 1 / sqrt(3).
+	const float IntegratedRms = (1.f - Leak) / FMath::Sqrt(1.f - Leak * Leak) / FMath::Sqrt(3.f);
+	return ColoredNoise::BrownRms / IntegratedRms;
+}
+
+BachelorDSP::FGreenNoiseCoefficients::FGreenNoiseCoefficients(const float InSampleRate) {
+	if (InSampleRate <= 0.f) return;
+
+	// RBJ band pass with constant 0 dB peak gain, normalized by A0.
+	const float W0 = 2.f * PI * FMath::Min(CenterFrequency, 0.49f * InSampleRate) / InSampleRate;
+	const float Alpha = FMath::Sin(W0) / (2.f * Quality);
+	const float A0 = 1.f + Alpha;
+	B0 = Alpha / A0;
+	B2 = -Alpha / A0;
+	A1 = -2.f * FMath::Cos(W0) / A0;
+	A2 = (1.f - Alpha) / A0;
+}
+
+BachelorDSP::FGreenNoise::FGreenNoise(const float InSampleRate, const int32 InSeed)
+	: White(InSeed == INDEX_NONE ? Audio::FWhiteNoise() : Audio::FWhiteNoise(InSeed)),
+	  Coefficients(InSampleRate) {}
@@ -0,0 +1,120 @@
+﻿/**
+ * @file ColoredNoise.h
+ * @brief Per-sample brown and green noise generators for BachelorDSP.
+ *
+ * Shapes white noise exactly like the shared noise tables, so generating noise per voice and reading it
+ * from FNoiseWavetable give the same spectrum for every noise color. The tables are built with these
+ * generators and peak normalized afterward. TNoiseBank runs the same recurrences per lane with the constants
+ * shared from here.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/Noise.h"
+
+namespace BachelorDSP {
+
+	/**
+	 * @class FBrownNoise
+	 * @brief White noise through a leaky integrator, falls with 6 dB per octave.
+	 */
+	class FBrownNoise {
+	public:
+		/** Leak of the integrator, keeps the random walk bounded. */
+		static constexpr float Leak = 0.995f;
+
+		/** Constructs a generator with a time based seed. */
+		FBrownNoise();
+
+		/**
+		 * @param InSeed Seed of the white noise source.
+		 */
+		explicit FBrownNoise(const int32 InSeed);
+
+		/** @return Makeup gain scaling the integrator to about a quarter of full scale RMS. */
+		static float GetMakeupGain();
+
+		/**
+		 * @brief Returns the next sample, for use inside a caller's own sample loop.
+		 *
+		 * @return Next sample, about a quarter of full scale RMS.
+		 */
+		FORCEINLINE float Generate() {
+			State = Leak * State + (1.f - Leak) * White.Generate();
+			return Gain * State;
+		}
+
+	private:
+		/** White noise source. */
+		Audio::FWhiteNoise White;
+
+		/** Integrator state. */
+		float State = 0.f;
+
+		/** Makeup gain of the integrator, see the constructor. */
+		float Gain;
+	};
+
+	/**
+	 * @struct FGreenNoiseCoefficients
+	 * @brief Normalized RBJ band pass coefficients of green noise, B1 is zero.
+	 */
+	struct FGreenNoiseCoefficients {
+		/** Center frequency of the band pass in Hz. */
+		static constexpr float CenterFrequency = 2000.f;
+
+		/** Quality of the band pass, 0.707 matches standard green noise. */
+		static constexpr float Quality = 0.707f;
+
+		FGreenNoiseCoefficients() = default;
+
+		/**
+		 * @param InSampleRate Sample rate the band pass is tuned for in Hz, zero or less keeps the band pass silent.
+		 */
+		explicit FGreenNoiseCoefficients(const float InSampleRate);
+
+		float B0 = 0.f;
+		float B2 = 0.f;
+		float A1 = 0.f;
+		float A2 = 0.f;
+	};
+
+	/**
+	 * @class FGreenNoise
+	 * @brief White noise through a constant peak gain band pass, centered on the middle of the audible range.
+	 */
+	class FGreenNoise {
+	public:
+		/**
+		 * @param InSampleRate Sample rate the band pass is tuned for in Hz.
+		 * @param InSeed Seed of the white noise source, INDEX_NONE picks a time based seed.
+		 */
+		FGreenNoise(const float InSampleRate, const int32 InSeed);
+
+		/**
+		 * @brief Returns the next sample, for use inside a caller's own sample loop.
+		 *
+		 * @return Next sample.
+		 */
+		FORCEINLINE float Generate() {
+			const float X = White.Generate();
+			const float Y = Coefficients.B0 * X + Coefficients.B2 * X2 - Coefficients.A1 * Y1 - Coefficients.A2 * Y2;
+			X2 = X1;
+			X1 = X;
+			Y2 = Y1;
+			Y1 = Y;
+			return Y;
+		}
+
+	private:
+		/** White noise source. */
+		Audio::FWhiteNoise White;
+
+		/** Band pass coefficients for the sample rate. */
+		FGreenNoiseCoefficients Coefficients;
+
+		// Filter state
+		float X1 = 0.f, X2 = 0.f, Y1 = 0.f, Y2 = 0.f;
+	};
+}
@@ -0,0 +1,11 @@
+﻿/**
+ * @file NoiseBank.cpp
+ * @brief Multi-lane decorrelated noise generator for BachelorDSP.
+ */
+
+#include "DSP/NoiseBank.h"
+
+void BachelorDSP::FNoiseShapingCoefficients::SetSampleRate(const float SampleRate) {
+	Green = FGreenNoiseCoefficients(SampleRate);
+	BrownGain = FBrownNoise::GetMakeupGain();
+}
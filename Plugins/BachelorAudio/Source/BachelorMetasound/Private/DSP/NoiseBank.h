@@ -0,0 +1,175 @@
+﻿/**
+ * @file NoiseBank.h
+ * @brief Multi-lane decorrelated noise generator for BachelorDSP.
+ *
+ * Generates several decorrelated noise channels in one pass. Every lane owns its own random stream and
+ * filter state, stored as arrays indexed by lane, while the spectral shaping coefficients are shared.
+ * Every color uses the algorithm and constants of the single AdvancedNoise node, so a lane sounds like
+ * the node it replaces.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ColoredNoise.h"
+#include "NoiseColor.h"
+
+namespace BachelorDSP {
+
+	/**
+	 * @struct FNoiseShapingCoefficients
+	 * @brief Spectral shaping coefficients shared by every lane of a noise bank.
+	 */
+	struct FNoiseShapingCoefficients {
+		/**
+		 * @brief Recomputes the sample rate dependent coefficients.
+		 *
+		 * @param SampleRate Sample rate in Hz.
+		 */
+		void SetSampleRate(const float SampleRate);
+
+		FGreenNoiseCoefficients Green; ///< Band pass of FGreenNoise.
+		float BrownGain = 0.f;         ///< Makeup gain of FBrownNoise.
+	};
+
+	/**
+	 * @class TNoiseBank
+	 * @brief Generates NumLanes decorrelated noise channels of the same color.
+	 *
+	 * Each lane runs its own xorshift32 stream. The per-sample inner loops run over the lanes with fixed
+	 * trip count and no dependencies between lanes, so the compiler maps them onto SIMD registers.
+	 * Pink lanes run one Audio::FPinkNoise each instead, whose data dependent octave updates do not vectorize.
+	 *
+	 * @tparam NumLanes Number of generated channels.
+	 */
+	template<int32 NumLanes>
+	class TNoiseBank {
+		static_assert(NumLanes > 0, "Noise bank needs at least one lane");
+
+	public:
+		/**
+		 * @brief Constructs the bank and seeds all lanes.
+		 *
+		 * @param SampleRate Sample rate in Hz, used for shaping coefficients.
+		 * @param Seed Base seed, INDEX_NONE picks a time based seed.
+		 */
+		TNoiseBank(const float SampleRate, const int32 Seed) {
+			Coefficients.SetSampleRate(SampleRate);
+			SetSeed(Seed);
+		}
+
+		/**
+		 * @brief Reseeds all lanes from one base seed and clears the filter state.
+		 *
+		 * @param Seed Base seed, INDEX_NONE picks a time based seed.
+		 */
+		void SetSeed(const int32 Seed) {
+			const uint32 BaseSeed = static_cast<uint32>(Seed == INDEX_NONE ? FPlatformTime::Cycles() : Seed);
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane) {
+				// Murmur3 finalizer spreads neighbouring lane indices to unrelated states.
+				uint32 Hash = BaseSeed + 0x9E3779B9u * static_cast<uint32>(Lane + 1);
+				Hash ^= Hash >> 16;
+				Hash *= 0x85EBCA6Bu;
+				Hash ^= Hash >> 13;
+				Hash *= 0xC2B2AE35u;
+				Hash ^= Hash >> 16;
+				State[Lane] = Hash != 0 ? Hash : 0x6D2B79F5u;
+
+				Pink[Lane] = Audio::FPinkNoise(static_cast<int32>(Hash));
+				Brown[Lane] = 0.f;
+				GreenX1[Lane] = GreenX2[Lane] = GreenY1[Lane] = GreenY2[Lane] = 0.f;
+			}
+		}
+
+		/**
+		 * @brief Generates one block for every lane.
+		 *
+		 * @param Color Noise color shared by all lanes.
+		 * @param OutBuffers NumLanes output buffers.
+		 * @param InNumSamples Number of samples per output buffer.
+		 */
+		void Generate(const ENoiseColor Color, float* const* OutBuffers, const int32 InNumSamples) {
+			switch (Color) {
+			case ENoiseColor::Pink:
+				GenerateColor<ENoiseColor::Pink>(OutBuffers, InNumSamples);
+				break;
+			case ENoiseColor::Brown:
+				GenerateColor<ENoiseColor::Brown>(OutBuffers, InNumSamples);
+				break;
+			case ENoiseColor::Green:
+				GenerateColor<ENoiseColor::Green>(OutBuffers, InNumSamples);
+				break;
+			default:
+				GenerateColor<ENoiseColor::White>(OutBuffers, InNumSamples);
+				break;
+			}
+		}
+
+	private:
+		template<ENoiseColor Color>
+		void GenerateColor(float* const* OutBuffers, const int32 InNumSamples) {
+			if constexpr (Color == ENoiseColor::Pink) {
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane) {
+					float* OutData = OutBuffers[Lane];
+					for (int32 Index = 0; Index < InNumSamples; ++Index) {
+						OutData[Index] = Pink[Lane].Generate();
+					}
+				}
+				return;
+			}
+
+			float White[NumLanes];
+			float Shaped[NumLanes];
+			for (int32 Index = 0; Index < InNumSamples; ++Index) {
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane) {
+					uint32 X = State[Lane];
+					X ^= X << 13;
+					X ^= X >> 17;
+					X ^= X << 5;
+					State[Lane] = X;
+					White[Lane] = static_cast<float>(static_cast<int32>(X)) * (1.f / 2147483648.f);
+				}
+
+				if constexpr (Color == ENoiseColor::Brown) {
+					// Same recurrence as FBrownNoise::Generate.
+					for (int32 Lane = 0; Lane < NumLanes; ++Lane) {
+						Brown[Lane] = FBrownNoise::Leak * Brown[Lane] + (1.f - FBrownNoise::Leak) * White[Lane];
+						Shaped[Lane] = Coefficients.BrownGain * Brown[Lane];
+					}
+				} else if constexpr (Color == ENoiseColor::Green) {
+					// Same recurrence as FGreenNoise::Generate.
+					for (int32 Lane = 0; Lane < NumLanes; ++Lane) {
+						const float Y = Coefficients.Green.B0 * White[Lane] + Coefficients.Green.B2 * GreenX2[Lane]
+							- Coefficients.Green.A1 * GreenY1[Lane]
+							- Coefficients.Green.A2 * GreenY2[Lane];
+						GreenX2[Lane] = GreenX1[Lane];
+						GreenX1[Lane] = White[Lane];
+						GreenY2[Lane] = GreenY1[Lane];
+						GreenY1[Lane] = Y;
+						Shaped[Lane] = Y;
+					}
+				} else {
+					for (int32 Lane = 0; Lane < NumLanes; ++Lane) {
+						Shaped[Lane] = White[Lane];
+					}
+				}
+
+				for (int32 Lane = 0; Lane < NumLanes; ++Lane) {
+					OutBuffers[Lane][Index] = Shaped[Lane];
+				}
+			}
+		}
+
+		/** Shaping coefficients shared by all lanes. */
+		FNoiseShapingCoefficients Coefficients;
+
+		// Per lane state, one array entry per lane.
+		uint32 State[NumLanes];  ///< xorshift32 random state.
+		Audio::FPinkNoise Pink[NumLanes]; ///< Pink generators, own their random streams.
+		float Brown[NumLanes];   ///< Brown integrator.
+		float GreenX1[NumLanes]; ///< Green band pass input history.
+		float GreenX2[NumLanes];
+		float GreenY1[NumLanes]; ///< Green band pass output history.
+		float GreenY2[NumLanes];
+	};
+}
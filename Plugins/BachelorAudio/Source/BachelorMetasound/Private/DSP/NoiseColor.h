@@ -0,0 +1,23 @@
+﻿/**
+ * @file NoiseColor.h
+ * @brief Noise color identifiers shared by the BachelorDSP noise generators.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace BachelorDSP {
+
+	/**
+	 * @enum ENoiseColor
+	 * @brief Spectral color of a generated noise signal.
+	 */
+	enum class ENoiseColor : uint8 {
+		White,
+		Pink,
+		Brown,
+		Green,
+		Num
+	};
+}
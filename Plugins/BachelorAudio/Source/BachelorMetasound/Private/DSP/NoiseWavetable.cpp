@@ -0,0 +1,137 @@
+﻿/**
+ * @file NoiseWavetable.cpp
+ * @brief Shared precomputed noise tables for BachelorDSP.
+ */
+
+#include "DSP/NoiseWavetable.h"
+
+#include "DSP/ColoredNoise.h"
+#include "DSP/Noise.h"
+
+namespace BachelorDSP::NoiseWavetable {
+	/** Fixed seed, so every process builds identical tables. */
+	constexpr int32 TableSeed = 0x6E6F6973;
+
+	/** Largest odd stride used for white noise readers. */
+	constexpr int32 MaxWhiteStride = 63;
+
+	void FillWhite(TArray<float>& OutTable) {
+		Audio::FWhiteNoise Generator(TableSeed);
+		for (float& Sample : OutTable) {
+			Sample = Generator.Generate();
+		}
+	}
+
+	void FillPink(TArray<float>& OutTable) {
+		Audio::FPinkNoise Generator(TableSeed);
+		for (float& Sample : OutTable) {
+			Sample = Generator.Generate();
+		}
+	}
+
+	void FillBrown(TArray<float>& OutTable) {
+		// Same shaping as the per-voice generator of the AdvancedNoise node
+		FBrownNoise Generator(TableSeed);
+		for (float& Sample : OutTable) {
+			Sample = Generator.Generate();
+		}
+
+		// Remove the linear trend, so the random walk ends where it starts and the table wraps without a step.
+		const int32 Num = OutTable.Num();
+		const float Slope = (OutTable[Num - 1] - OutTable[0]) / static_cast<float>(Num - 1);
+		const float Start = OutTable[0];
+		for (int32 Index = 0; Index < Num; ++Index) {
+			OutTable[Index] -= Start + Slope * static_cast<float>(Index);
+		}
+	}
+
+	void FillGreen(TArray<float>& OutTable) {
+		// Same shaping as the per-voice generator of the AdvancedNoise node
+		FGreenNoise Generator(FNoiseWavetable::ReferenceSampleRate, TableSeed);
+		for (float& Sample : OutTable) {
+			Sample = Generator.Generate();
+		}
+	}
+
+	void Normalize(TArray<float>& InOutTable) {
+		float Peak = 0.f;
+		for (const float Sample : InOutTable) {
+			Peak = FMath::Max(Peak, FMath::Abs(Sample));
+		}
+		if (Peak <= SMALL_NUMBER) return;
+
+		const float Scale = 1.f / Peak;
+		for (float& Sample : InOutTable) {
+			Sample *= Scale;
+		}
+	}
+}
+
+const BachelorDSP::FNoiseWavetable& BachelorDSP::FNoiseWavetable::Get(const ENoiseColor Color) {
+	// Function local statics are initialized once and thread safe, tables are immutable afterward.
+	static const FNoiseWavetable Tables[] = {
+		FNoiseWavetable(ENoiseColor::White),
+		FNoiseWavetable(ENoiseColor::Pink),
+		FNoiseWavetable(ENoiseColor::Brown),
+		FNoiseWavetable(ENoiseColor::Green),
+	};
+	static_assert(UE_ARRAY_COUNT(Tables) == static_cast<int32>(ENoiseColor::Num), "One table per noise color");
+
+	const int32 Index = static_cast<int32>(Color);
+	return Tables[Index < static_cast<int32>(ENoiseColor::Num) ? Index : 0];
+}
+
+BachelorDSP::FNoiseWavetable::FNoiseWavetable(const ENoiseColor InColor)
+	: Color(InColor) {
+	using namespace NoiseWavetable;
+	Table.SetNumUninitialized(TableSize);
+
+	switch (Color) {
+	default:
+	case ENoiseColor::White:
+		FillWhite(Table);
+		return;
+	case ENoiseColor::Pink:
+		FillPink(Table);
+		break;
+	case ENoiseColor::Brown:
+		FillBrown(Table);
+		break;
+	case ENoiseColor::Green:
+		FillGreen(Table);
+		break;
+	}
+	Normalize(Table);
+}
+
+BachelorDSP::FNoiseWavetableReader::FNoiseWavetableReader(const ENoiseColor Color, const int32 Seed)
+	: Table(FNoiseWavetable::Get(Color).GetData()),
+	  Position(0),
+	  Stride(1) {
+	const FRandomStream RandomStream(Seed == INDEX_NONE ? static_cast<int32>(FPlatformTime::Cycles()) : Seed);
+	Position = static_cast<uint32>(RandomStream.RandHelper(FNoiseWavetable::TableSize));
+	if (Color == ENoiseColor::White) {
+		// Odd strides are coprime to the power of two table size and visit every sample once per cycle.
+		Stride = static_cast<uint32>(RandomStream.RandHelper(NoiseWavetable::MaxWhiteStride / 2 + 1)) * 2 + 1;
+	}
+}
+
+void BachelorDSP::FNoiseWavetableReader::Generate(float* OutBuffer, const int32 InNumSamples) {
+	if (Stride == 1) {
+		// Contiguous reads, copy in runs up to the end of the table.
+		int32 Remaining = InNumSamples;
+		while (Remaining > 0) {
+			const int32 Run = FMath::Min(Remaining, FNoiseWavetable::TableSize - static_cast<int32>(Position));
+			FMemory::Memcpy(OutBuffer, Table + Position, Run * sizeof(float));
+			OutBuffer += Run;
+			Remaining -= Run;
+			Position = (Position + Run) & FNoiseWavetable::TableMask;
+		}
+		return;
+	}
+
+	for (int32 Index = 0; Index < InNumSamples; ++Index) {
+		OutBuffer[Index] = Table[Position];
+		Position = (Position + Stride) & FNoiseWavetable::TableMask;
+	}
+}
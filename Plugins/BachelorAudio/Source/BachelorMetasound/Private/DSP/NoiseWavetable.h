@@ -0,0 +1,116 @@
+﻿/**
+ * @file NoiseWavetable.h
+ * @brief Shared precomputed noise tables for BachelorDSP.
+ *
+ * Provides one large, read-only, spectrally shaped noise table per noise color. The tables are built once
+ * per process and shared by all voices, each voice only keeps its own read position and stride.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NoiseColor.h"
+
+namespace BachelorDSP {
+
+	/**
+	 * @class FNoiseWavetable
+	 * @brief Process-wide, read-only table of precomputed noise for a single noise color.
+	 *
+	 * Tables are created lazily on first access and never modified afterward, so they can be read
+	 * from any number of audio render threads without synchronization.
+	 */
+	class FNoiseWavetable {
+	public:
+		/** Number of samples per table (1 MB per color). Power of two, so read positions wrap with a mask. */
+		static constexpr int32 TableSize = 1 << 18;
+
+		/** Mask used to wrap read positions into the table. */
+		static constexpr uint32 TableMask = TableSize - 1;
+
+		/** Sample rate the Green table is shaped for in Hz. */
+		static constexpr float ReferenceSampleRate = 48000.f;
+
+		/**
+		 * @brief Returns the shared table for the given noise color, building all tables on first call.
+		 *
+		 * @param Color Requested noise color.
+		 * @return Reference to the shared table.
+		 */
+		static const FNoiseWavetable& Get(const ENoiseColor Color);
+
+		/**
+		 * @brief Returns the first sample of the table.
+		 *
+		 * @return Pointer to TableSize read-only samples.
+		 */
+		FORCEINLINE const float* GetData() const { return Table.GetData(); }
+
+		/**
+		 * @brief Returns the color the table was shaped for.
+		 */
+		FORCEINLINE ENoiseColor GetColor() const { return Color; }
+
+	private:
+		/**
+		 * @brief Builds and normalizes the table for one noise color.
+		 *
+		 * @param InColor Noise color to generate.
+		 */
+		explicit FNoiseWavetable(const ENoiseColor InColor);
+
+		/** Precomputed samples in range [-1, 1]. */
+		TArray<float> Table;
+
+		/** Color of the precomputed samples. */
+		ENoiseColor Color;
+	};
+
+	/**
+	 * @class FNoiseWavetableReader
+	 * @brief Per-voice read head into a shared FNoiseWavetable.
+	 *
+	 * Each reader starts at a random offset and advances by a per-voice stride, so voices sharing
+	 * one table stay decorrelated. Colored tables are read with stride 1, because skipping samples
+	 * would shift their spectrum; white noise uses a random odd stride, which still visits every sample.
+	 */
+	class FNoiseWavetableReader {
+	public:
+		/**
+		 * @brief Constructs a reader for the given color.
+		 *
+		 * @param Color Noise color to read.
+		 * @param Seed Seed for offset and stride, INDEX_NONE picks a time based seed.
+		 */
+		FNoiseWavetableReader(const ENoiseColor Color, const int32 Seed);
+
+		/**
+		 * @brief Copies the next samples of the table into the output buffer.
+		 *
+		 * @param OutBuffer Output buffer to write.
+		 * @param InNumSamples Number of samples to write.
+		 */
+		void Generate(float* OutBuffer, const int32 InNumSamples);
+
+		/**
+		 * @brief Returns the next sample of the table, for use inside a caller's own sample loop.
+		 *
+		 * @return Next table sample.
+		 */
+		FORCEINLINE float Generate() {
+			const float Sample = Table[Position];
+			Position = (Position + Stride) & FNoiseWavetable::TableMask;
+			return Sample;
+		}
+
+	private:
+		/** Shared table data, owned by FNoiseWavetable. */
+		const float* Table;
+
+		/** Current read position within the table. */
+		uint32 Position;
+
+		/** Number of samples to advance per generated sample. */
+		uint32 Stride;
+	};
+}
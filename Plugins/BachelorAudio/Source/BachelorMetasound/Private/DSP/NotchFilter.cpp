@@ -60,37 +60,49 @@ void BachelorDSP::FNotchFilter::SetValues(
 	const float& NewCutoffFrequency, 
 	const float& NewBandwidthCoefficient
 ) {
+	if (NewSamplingFrequency == SamplingFrequency
+		&& NewCutoffFrequency == CutoffFrequency
+		&& NewBandwidthCoefficient == BandwidthCoefficient) return;
+
 	SamplingFrequency = NewSamplingFrequency;
 	CutoffFrequency = NewCutoffFrequency;
 	BandwidthCoefficient = NewBandwidthCoefficient;
 	SetCoefficients();
 }
 
+bool BachelorDSP::FNotchFilter::AreValuesValid(
+	const float& InSamplingFrequency,
+	const float& InCutoffFrequency,
+	const float& InBandwidthCoefficient
+) {
+	if ((InSamplingFrequency < 0.0) || (InCutoffFrequency < 0.0)) return false;
+	if (InCutoffFrequency > (InSamplingFrequency / 2)) return false;
+	return IsBandwidthCoefficientValid(InBandwidthCoefficient);
+}
+
+bool BachelorDSP::FNotchFilter::IsBandwidthCoefficientValid(const float& InBandwidthCoefficient) {
+	return (InBandwidthCoefficient > 0.0) && (InBandwidthCoefficient < 1.0);
+}
+
+void BachelorDSP::FNotchFilter::Reset() {
+	Y = 0, Y1 = 0, Y2 = 0;
+	X = 0, X1 = 0, X2 = 0;
+}
+
 void BachelorDSP::FNotchFilter::InitNotchFilter() {
+	Reset();
 	SetCoefficients();
 }
 
 void BachelorDSP::FNotchFilter::ProcessNotchFilter(const float* InBuffer, float* OutBuffer, const int32 InNumSamples)
 {
 	for (int32 Index = 0; Index < InNumSamples; ++Index) {
-		Y = B * X + B1 * X1 + B2 * X2 - A * Y1 - A1 * Y2;
-		Y2 = Y1;
-		Y1 = Y;
-		X2 = X1;
-		X1 = X;
-		X = InBuffer[Index];
-
-		if (Y > 32767) Y = 32767;
-		else if (Y < -32768) Y = -32768;
-
-		OutBuffer[Index] = Y;
+		OutBuffer[Index] = ProcessSample(InBuffer[Index]);
 	}
 }
 
 void BachelorDSP::FNotchFilter::SetCoefficients() {
-	if ((SamplingFrequency < 0.0) || (CutoffFrequency < 0.0)) return;
-	if (CutoffFrequency > (SamplingFrequency / 2)) return;
-	if ((BandwidthCoefficient <= 0.0) || (BandwidthCoefficient >= 1.0)) return;
+	if (!AreValuesValid(SamplingFrequency, CutoffFrequency, BandwidthCoefficient)) return;
 
 	Z = cos(2 * PI * CutoffFrequency / SamplingFrequency);
 	B = (1 - BandwidthCoefficient) * (1 - BandwidthCoefficient) / (2 * (fabs(Z) + 1)) + BandwidthCoefficient;
@@ -98,7 +110,4 @@ void BachelorDSP::FNotchFilter::SetCoefficients() {
 	B1 = -2 * Z * B;
 	A = -2 * Z * BandwidthCoefficient;
 	A1 = BandwidthCoefficient * BandwidthCoefficient;
-
-	Y = 0, Y1 = 0, Y2 = 0;
-	X = 0, X1 = 0, X2 = 0;
 }
@@ -80,7 +80,7 @@ namespace BachelorDSP {
 		void SetBandwidthCoefficient(const float& NewBandwidthCoefficient);
 
 		/**
-		 * @brief Sets all filter parameters at once.
+		 * @brief Sets all filter parameters at once, coefficients are only recomputed on change.
 		 * 
 		 * @param NewSamplingFrequency Sampling frequency in Hz.
 		 * @param NewCutoffFrequency Cutoff (center) frequency in Hz.
@@ -92,6 +92,56 @@ namespace BachelorDSP {
 			const float& NewBandwidthCoefficient
 		);
 
+		/**
+		 * @brief Checks whether parameters would be accepted by the coefficient calculation.
+		 * 
+		 * Rejected parameters keep the previous coefficients, a filter that never received valid
+		 * parameters outputs silence.
+		 * 
+		 * @param InSamplingFrequency Sampling frequency in Hz.
+		 * @param InCutoffFrequency Cutoff (center) frequency in Hz.
+		 * @param InBandwidthCoefficient Bandwidth coefficient.
+		 * @return True if the coefficients would be recalculated.
+		 */
+		static bool AreValuesValid(
+			const float& InSamplingFrequency,
+			const float& InCutoffFrequency,
+			const float& InBandwidthCoefficient
+		);
+
+		/**
+		 * @brief Checks the bandwidth coefficient on its own, it has to be within (0, 1).
+		 * 
+		 * @param InBandwidthCoefficient Bandwidth coefficient.
+		 * @return False if no other parameter can make the filter valid.
+		 */
+		static bool IsBandwidthCoefficientValid(const float& InBandwidthCoefficient);
+
+		/**
+		 * @brief Clears the filter history, coefficients are kept.
+		 */
+		void Reset();
+
+		/**
+		 * @brief Filters a single sample, the kernel of Process().
+		 * 
+		 * @param InSample Input sample.
+		 * @return Filtered sample.
+		 */
+		FORCEINLINE float ProcessSample(const float InSample) {
+			Y = B * X + B1 * X1 + B2 * X2 - A * Y1 - A1 * Y2;
+			Y2 = Y1;
+			Y1 = Y;
+			X2 = X1;
+			X1 = X;
+			X = InSample;
+
+			if (Y > 32767) Y = 32767;
+			else if (Y < -32768) Y = -32768;
+
+			return Y;
+		}
+
 	private:
 		/**
 		 * @brief Initializes internal filter state and coefficients.
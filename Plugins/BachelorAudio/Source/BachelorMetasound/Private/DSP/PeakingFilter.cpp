@@ -0,0 +1,77 @@
+﻿/**
+ * @file PeakingFilter.cpp
+ * @brief Defines a peaking equalizer for real-time audio processing.
+ *
+ * Implements a second-order IIR peaking filter (RBJ audio EQ cookbook).
+ * Part of the BachelorDSP module and inherits from FProcessorBase.
+ */
+
+#include "DSP/PeakingFilter.h"
+
+BachelorDSP::FPeakingFilter::FPeakingFilter()
+  :	FProcessorBase(EDSPType::PeakingFilter),
+	SamplingFrequency(0.f),
+	CenterFrequency(0.f),
+	Quality(0.f),
+	GainDb(0.f),
+	bIsActive(false),
+	X1(0.f), X2(0.f),
+	Y1(0.f), Y2(0.f),
+	B0(1.f), B1(0.f), B2(0.f),
+	A1(0.f), A2(0.f) {}
+
+void BachelorDSP::FPeakingFilter::Init() {
+	X1 = 0.f, X2 = 0.f;
+	Y1 = 0.f, Y2 = 0.f;
+}
+
+void BachelorDSP::FPeakingFilter::Process(const float* InBuffer, float* OutBuffer, const int32 InNumSamples) {
+	if (!bIsActive) {
+		if (InBuffer != OutBuffer) FMemory::Memcpy(OutBuffer, InBuffer, InNumSamples * sizeof(float));
+		return;
+	}
+	for (int32 Index = 0; Index < InNumSamples; ++Index) {
+		OutBuffer[Index] = ProcessSample(InBuffer[Index]);
+	}
+}
+
+void BachelorDSP::FPeakingFilter::SetValues(
+	const float& NewSamplingFrequency,
+	const float& NewCenterFrequency,
+	const float& NewQuality,
+	const float& NewGainDb
+) {
+	if (NewSamplingFrequency == SamplingFrequency
+		&& NewCenterFrequency == CenterFrequency
+		&& NewQuality == Quality
+		&& NewGainDb == GainDb) return;
+
+	SamplingFrequency = NewSamplingFrequency;
+	CenterFrequency = NewCenterFrequency;
+	Quality = NewQuality;
+	GainDb = NewGainDb;
+	SetCoefficients();
+}
+
+void BachelorDSP::FPeakingFilter::SetCoefficients() {
+	const bool bWasActive = bIsActive;
+	bIsActive = SamplingFrequency > 0.f && Quality > 0.f && !FMath::IsNearlyZero(GainDb);
+	if (!bIsActive) return;
+
+	// Keep the band below Nyquist, so the filter stays stable for any input.
+	const float Frequency = FMath::Clamp(CenterFrequency, 20.f, 0.49f * SamplingFrequency);
+	const float A = FMath::Pow(10.f, GainDb / 40.f);
+	const float W0 = 2.f * PI * Frequency / SamplingFrequency;
+	const float Alpha = FMath::Sin(W0) / (2.f * Quality);
+	const float CosW0 = FMath::Cos(W0);
+	const float A0 = 1.f + Alpha / A;
+
+	B0 = (1.f + Alpha * A) / A0;
+	B1 = -2.f * CosW0 / A0;
+	B2 = (1.f - Alpha * A) / A0;
+	A1 = B1;
+	A2 = (1.f - Alpha / A) / A0;
+
+	// State from a bypassed period does not belong to this filter.
+	if (!bWasActive) Init();
+}
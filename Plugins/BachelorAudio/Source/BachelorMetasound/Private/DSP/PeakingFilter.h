@@ -0,0 +1,115 @@
+﻿/**
+ * @file PeakingFilter.h
+ * @brief Defines a peaking equalizer for real-time audio processing.
+ *
+ * Implements a second-order IIR peaking filter (RBJ audio EQ cookbook), boosting or cutting a band
+ * around a center frequency. Part of the BachelorDSP module and inherits from FProcessorBase.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProcessorBase.h"
+
+namespace BachelorDSP {
+
+	/**
+	 * @class FPeakingFilter
+	 * @brief A second-order peaking equalizer processor.
+	 *
+	 * Besides block processing it exposes ProcessSample(), so generators can filter inside their own
+	 * sample loop instead of running a separate pass over the buffer.
+	 */
+	class FPeakingFilter : public FProcessorBase {
+	public:
+		/**
+		 * @brief Default constructor.
+		 *
+		 * Initializes an inactive filter that passes audio unchanged.
+		 */
+		FPeakingFilter();
+
+		/**
+		 * @brief Destructor.
+		 */
+		virtual ~FPeakingFilter() override = default;
+
+		/**
+		 * @brief Clears the internal filter state.
+		 */
+		virtual void Init() override;
+
+		/**
+		 * @brief Processes audio input using the peaking filter.
+		 *
+		 * @param InBuffer Input audio buffer (read-only).
+		 * @param OutBuffer Output buffer with filtered data, may be equal to InBuffer.
+		 * @param InNumSamples Number of samples to process.
+		 */
+		virtual void Process(const float* InBuffer, float* OutBuffer, const int32 InNumSamples) override;
+
+		/**
+		 * @brief Sets all filter parameters at once, coefficients are only recomputed on change.
+		 *
+		 * @param NewSamplingFrequency Sampling frequency in Hz.
+		 * @param NewCenterFrequency Center frequency in Hz.
+		 * @param NewQuality Quality of the band, 0 or less bypasses the filter.
+		 * @param NewGainDb Gain at the center frequency in dB, 0 bypasses the filter.
+		 */
+		void SetValues(
+			const float& NewSamplingFrequency,
+			const float& NewCenterFrequency,
+			const float& NewQuality,
+			const float& NewGainDb
+		);
+
+		/**
+		 * @brief Returns whether the filter changes the signal at all.
+		 *
+		 * @return False if gain or quality bypass the filter.
+		 */
+		FORCEINLINE bool IsActive() const { return bIsActive; }
+
+		/**
+		 * @brief Filters a single sample.
+		 *
+		 * @param InSample Input sample.
+		 * @return Filtered sample.
+		 */
+		FORCEINLINE float ProcessSample(const float InSample) {
+			const float Y = B0 * InSample + B1 * X1 + B2 * X2 - A1 * Y1 - A2 * Y2;
+			X2 = X1;
+			X1 = InSample;
+			Y2 = Y1;
+			Y1 = Y;
+			return Y;
+		}
+
+	private:
+		/**
+		 * @brief Calculates filter coefficients based on current parameter values.
+		 */
+		void SetCoefficients();
+
+		/** Current sampling rate in Hz. */
+		float SamplingFrequency;
+
+		/** Center frequency of the band in Hz. */
+		float CenterFrequency;
+
+		/** Quality of the band. */
+		float Quality;
+
+		/** Gain at the center frequency in dB. */
+		float GainDb;
+
+		/** Whether the current parameters change the signal. */
+		bool bIsActive;
+
+		// Internal filter state variables for recursive calculation
+		float X1, X2;     ///< Previous input samples.
+		float Y1, Y2;     ///< Previous output samples.
+		float B0, B1, B2; ///< Feed forward coefficients, normalized by A0.
+		float A1, A2;     ///< Feedback coefficients, normalized by A0.
+	};
+}
@@ -20,7 +20,30 @@ namespace BachelorDSP {
 	enum class EDSPType : uint8 {
 		Volume,
 		NotchFilter,
+		PeakingFilter,
+		Num
 	};
+
+	/**
+	 * @brief Largest number of samples a multi pass loop works on at once.
+	 * 
+	 * Code that runs several passes over a block, or needs scratch memory per sample, splits blocks of
+	 * any size into chunks of this size. 256 floats per buffer keep a few buffers within L1.
+	 */
+	constexpr int32 ChunkSize = 256;
+
+	/**
+	 * @brief Splits a block into consecutive chunks of at most ChunkSize samples.
+	 * 
+	 * @param InNumSamples Number of samples of the whole block.
+	 * @param InFunc Called with the offset and number of samples of every chunk, in order.
+	 */
+	template<typename FuncType>
+	FORCEINLINE void ForEachChunk(const int32 InNumSamples, FuncType&& InFunc) {
+		for (int32 Offset = 0; Offset < InNumSamples; Offset += ChunkSize) {
+			InFunc(Offset, FMath::Min(ChunkSize, InNumSamples - Offset));
+		}
+	}
 	
 	/**
 	 * @class FProcessorBase
@@ -60,6 +83,9 @@ namespace BachelorDSP {
 		/**
 		 * @brief Processes a block of audio data.
 		 * 
+		 * Blocks may have any size. State is carried from sample to sample, so splitting a block into
+		 * several calls produces bit identical output.
+		 * 
 		 * @param InBuffer Input audio buffer (read-only).
 		 * @param OutBuffer Output audio buffer (write).
 		 * @param InNumSamples Number of samples to process.
@@ -0,0 +1,88 @@
+﻿/**
+ * @file ProcessorRegistry.cpp
+ * @brief Creates BachelorDSP processors by EDSPType from pooled memory.
+ */
+
+#include "DSP/ProcessorRegistry.h"
+
+#include "DSP/BachelorVolume.h"
+#include "DSP/NotchFilter.h"
+#include "DSP/PeakingFilter.h"
+
+BachelorDSP::FProcessorRegistry& BachelorDSP::FProcessorRegistry::Get() {
+	static FProcessorRegistry Registry;
+	return Registry;
+}
+
+BachelorDSP::FProcessorRegistry::FProcessorRegistry() {
+	Register<FBachelorVolume>(EDSPType::Volume);
+	Register<FNotchFilter>(EDSPType::NotchFilter);
+	Register<FPeakingFilter>(EDSPType::PeakingFilter);
+}
+
+const BachelorDSP::FProcessorTypeInfo* BachelorDSP::FProcessorRegistry::Find(const EDSPType InType) const {
+	const int32 TypeIndex = static_cast<int32>(InType);
+	if (TypeIndex < 0 || TypeIndex >= static_cast<int32>(EDSPType::Num)) return nullptr;
+	return Infos[TypeIndex].Construct != nullptr ? &Infos[TypeIndex] : nullptr;
+}
+
+void BachelorDSP::FProcessorPool::FDeleter::operator()(FProcessorBase* InProcessor) const {
+	if (InProcessor != nullptr) Pool->Release(InProcessor);
+}
+
+BachelorDSP::FProcessorPool::~FProcessorPool() {
+	for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(EDSPType::Num); ++TypeIndex) {
+		ensureMsgf(FreeSlots[TypeIndex].Num() == NumSlots[TypeIndex],
+			TEXT("%d processors of type %d outlive their pool"), NumSlots[TypeIndex] - FreeSlots[TypeIndex].Num(), TypeIndex);
+		for (void* Slab : Slabs[TypeIndex]) {
+			FMemory::Free(Slab);
+		}
+	}
+}
+
+BachelorDSP::FProcessorPool& BachelorDSP::FProcessorPool::GetForCurrentThread() {
+	thread_local FProcessorPool Pool;
+	return Pool;
+}
+
+void BachelorDSP::FProcessorPool::Reserve(const EDSPType InType, const int32 InNum) {
+	const FProcessorTypeInfo* Info = FProcessorRegistry::Get().Find(InType);
+	const int32 NumMissing = InNum - GetNumFree(InType);
+	if (Info == nullptr || NumMissing <= 0) return;
+	AddSlab(InType, *Info, NumMissing);
+}
+
+BachelorDSP::FProcessorPool::FProcessorPtr BachelorDSP::FProcessorPool::Acquire(const EDSPType InType) {
+	const FProcessorTypeInfo* Info = FProcessorRegistry::Get().Find(InType);
+	if (Info == nullptr) return FProcessorPtr(nullptr, FDeleter{ this });
+
+	TArray<void*>& Free = FreeSlots[static_cast<int32>(InType)];
+	if (Free.Num() == 0) AddSlab(InType, *Info, DefaultSlabSize);
+	return FProcessorPtr(Info->Construct(Free.Pop(false)), FDeleter{ this });
+}
+
+int32 BachelorDSP::FProcessorPool::GetNumFree(const EDSPType InType) const {
+	const int32 TypeIndex = static_cast<int32>(InType);
+	if (TypeIndex < 0 || TypeIndex >= static_cast<int32>(EDSPType::Num)) return 0;
+	return FreeSlots[TypeIndex].Num();
+}
+
+void BachelorDSP::FProcessorPool::AddSlab(const EDSPType InType, const FProcessorTypeInfo& InInfo, const int32 InNum) {
+	const int32 TypeIndex = static_cast<int32>(InType);
+	const SIZE_T Stride = Align(InInfo.Size, static_cast<SIZE_T>(InInfo.Alignment));
+	uint8* Slab = static_cast<uint8*>(FMemory::Malloc(Stride * InNum, InInfo.Alignment));
+	Slabs[TypeIndex].Add(Slab);
+
+	NumSlots[TypeIndex] += InNum;
+	FreeSlots[TypeIndex].Reserve(NumSlots[TypeIndex]);
+	for (int32 Slot = InNum - 1; Slot >= 0; --Slot) {
+		FreeSlots[TypeIndex].Add(Slab + Slot * Stride);
+	}
+}
+
+void BachelorDSP::FProcessorPool::Release(FProcessorBase* InProcessor) {
+	const EDSPType Type = InProcessor->GetType();
+	const FProcessorTypeInfo* Info = FProcessorRegistry::Get().Find(Type);
+	check(Info != nullptr);
+	FreeSlots[static_cast<int32>(Type)].Add(Info->Destroy(InProcessor));
+}
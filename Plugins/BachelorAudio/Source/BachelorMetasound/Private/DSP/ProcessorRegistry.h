@@ -0,0 +1,152 @@
+﻿/**
+ * @file ProcessorRegistry.h
+ * @brief Creates BachelorDSP processors by EDSPType from pooled memory.
+ *
+ * FProcessorRegistry knows how to construct every processor type. FProcessorPool hands out processors
+ * from preallocated slabs, so data-driven chains can be built and torn down on the audio render thread
+ * without touching the heap, as long as the pool was reserved beforehand.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProcessorBase.h"
+
+namespace BachelorDSP {
+
+	/**
+	 * @struct FProcessorTypeInfo
+	 * @brief Memory layout and lifetime functions of one processor type.
+	 */
+	struct FProcessorTypeInfo {
+		/** Constructs a processor in place and returns it. */
+		using FConstructFunction = FProcessorBase* (*)(void* InMemory);
+
+		/** Destroys a processor in place and returns the memory it was constructed in. */
+		using FDestroyFunction = void* (*)(FProcessorBase* InProcessor);
+
+		SIZE_T Size = 0;
+		uint32 Alignment = 0;
+		FConstructFunction Construct = nullptr;
+		FDestroyFunction Destroy = nullptr;
+	};
+
+	/**
+	 * @class FProcessorRegistry
+	 * @brief Maps every EDSPType to the processor class implementing it.
+	 *
+	 * All built-in processors are registered on first use. Registering is meant to happen at startup,
+	 * lookups are lock-free afterward.
+	 */
+	class BACHELORMETASOUND_API FProcessorRegistry {
+	public:
+		/** @return The registry, with all built-in processors registered. */
+		static FProcessorRegistry& Get();
+
+		/**
+		 * @brief Registers or replaces the class created for a type.
+		 *
+		 * @tparam ProcessorType Default constructible FProcessorBase subclass.
+		 * @param InType Type the class is created for.
+		 */
+		template<typename ProcessorType>
+		void Register(const EDSPType InType) {
+			static_assert(TIsDerivedFrom<ProcessorType, FProcessorBase>::Value, "Processors have to derive from FProcessorBase");
+			FProcessorTypeInfo& Info = Infos[static_cast<int32>(InType)];
+			Info.Size = sizeof(ProcessorType);
+			Info.Alignment = alignof(ProcessorType);
+			Info.Construct = [](void* InMemory) -> FProcessorBase* { return new (InMemory) ProcessorType(); };
+			Info.Destroy = [](FProcessorBase* InProcessor) -> void* {
+				ProcessorType* Processor = static_cast<ProcessorType*>(InProcessor);
+				Processor->~ProcessorType();
+				return Processor;
+			};
+		}
+
+		/**
+		 * @brief Looks up the class of a type.
+		 *
+		 * @param InType Processor type.
+		 * @return Type info, nullptr if nothing is registered for the type.
+		 */
+		const FProcessorTypeInfo* Find(const EDSPType InType) const;
+
+	private:
+		FProcessorRegistry();
+
+		FProcessorTypeInfo Infos[static_cast<int32>(EDSPType::Num)];
+	};
+
+	/**
+	 * @class FProcessorPool
+	 * @brief Hands out processors from slabs of preallocated memory.
+	 *
+	 * Released processors are destroyed and their memory is handed out again, so after Reserve() a
+	 * pool neither allocates nor frees. A pool is not thread safe, every thread uses its own one, see
+	 * GetForCurrentThread(). All processors have to be released before their pool is destroyed.
+	 */
+	class BACHELORMETASOUND_API FProcessorPool {
+	public:
+		/**
+		 * @struct FDeleter
+		 * @brief Returns a processor to the pool it came from.
+		 */
+		struct BACHELORMETASOUND_API FDeleter {
+			FProcessorPool* Pool = nullptr;
+			void operator()(FProcessorBase* InProcessor) const;
+		};
+
+		/** Owning handle of a pooled processor, releases it when reset or destroyed. */
+		using FProcessorPtr = TUniquePtr<FProcessorBase, FDeleter>;
+
+		/** Processors allocated at once when Acquire() finds no free memory. */
+		static constexpr int32 DefaultSlabSize = 8;
+
+		FProcessorPool() = default;
+		~FProcessorPool();
+
+		FProcessorPool(const FProcessorPool&) = delete;
+		FProcessorPool& operator=(const FProcessorPool&) = delete;
+
+		/** @return Pool of the calling thread, created on first use. */
+		static FProcessorPool& GetForCurrentThread();
+
+		/**
+		 * @brief Makes sure that many processors of a type can be acquired without allocating.
+		 *
+		 * @param InType Processor type.
+		 * @param InNum Number of processors that have to be available at once.
+		 */
+		void Reserve(const EDSPType InType, const int32 InNum);
+
+		/**
+		 * @brief Constructs a processor of a type in pooled memory.
+		 *
+		 * Allocates a new slab if the type has no free memory left, reserve beforehand to avoid that on
+		 * the render thread.
+		 *
+		 * @param InType Processor type.
+		 * @return The processor, null if the type is not registered.
+		 */
+		FProcessorPtr Acquire(const EDSPType InType);
+
+		/** @return Number of processors of a type that can be acquired without allocating. */
+		int32 GetNumFree(const EDSPType InType) const;
+
+	private:
+		/** Adds a slab for InNum processors of a type. */
+		void AddSlab(const EDSPType InType, const FProcessorTypeInfo& InInfo, const int32 InNum);
+
+		/** Destroys a processor and frees its memory for the next Acquire(). */
+		void Release(FProcessorBase* InProcessor);
+
+		/** Slab memory per type, freed with the pool. */
+		TArray<void*> Slabs[static_cast<int32>(EDSPType::Num)];
+
+		/** Free slots per type, the capacity covers every slot so releasing never allocates. */
+		TArray<void*> FreeSlots[static_cast<int32>(EDSPType::Num)];
+
+		/** Number of slots per type over all slabs. */
+		int32 NumSlots[static_cast<int32>(EDSPType::Num)] = {};
+	};
+}
@@ -0,0 +1,42 @@
+﻿/**
+ * @file NodeBuildHelpers.h
+ * @brief Helpers for operator factories of the BachelorMetasound nodes.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundDataReference.h"
+#include "MetasoundNodeInterface.h"
+#include "MetasoundVertexData.h"
+
+namespace BachelorMetasound {
+
+	/**
+	 * @brief Reads an input whose value can not change after the operator is built.
+	 *
+	 * Unconnected inputs are constant with their vertex default. Connected inputs are only constant if
+	 * they carry a value reference, e.g. a literal or constructor input.
+	 *
+	 * @param InParams Build parameters passed to CreateOperator.
+	 * @param InName Vertex name of the input.
+	 * @param OutValue Receives the constant value.
+	 * @return True if the input is constant.
+	 */
+	template<typename DataType>
+	bool TryGetConstantInput(
+		const Metasound::FBuildOperatorParams& InParams,
+		const Metasound::FVertexName& InName,
+		DataType& OutValue
+	) {
+		const Metasound::FAnyDataReference* Reference = InParams.InputData.FindDataReference(InName);
+		if (Reference == nullptr) {
+			OutValue = *InParams.InputData.GetOrCreateDefaultDataReadReference<DataType>(InName, InParams.OperatorSettings);
+			return true;
+		}
+		if (Reference->GetAccessType() != Metasound::EDataReferenceAccessType::Value) return false;
+		OutValue = *Reference->GetDataReadReference<DataType>();
+		return true;
+	}
+
+}
@@ -0,0 +1,162 @@
+﻿/**
+ * @file NoiseBankNode.cpp
+ * @brief MetaSound operator and node for generating several decorrelated noise channels.
+ *
+ * This file defines a MetaSound-compatible operator and node that wraps the
+ * BachelorDSP::TNoiseBank processor, producing N decorrelated noise outputs in a single Execute.
+ */
+
+#include "NoiseBankNode.h"
+#include "NodeRenderStats.h"
+
+#include "MetasoundNodeRegistrationMacro.h"
+
+#define LOCTEXT_NAMESPACE "BachelorMetasound_NoiseBankNode"
+
+namespace BachelorMetasound::NoiseBankNode {
+	// Input params
+	METASOUND_PARAM(InParamNameSeed, "Seed", "Start seed, every channel derives its own stream from it.")
+	METASOUND_PARAM(InParamNameType, "Type", "Type of noise to generate on all channels.")
+
+	// Output params
+	METASOUND_PARAM(OutParamNameAudio, "Out {0}", "Decorrelated noise channel {0}.")
+}
+
+template<int32 NumChannels>
+BachelorMetasound::TNoiseBankOperator<NumChannels>::TNoiseBankOperator(
+	const Metasound::FOperatorSettings& InSettings,
+	const Metasound::FInt32ReadRef& InSeed,
+	const Metasound::FEnumAdvancedNoiseTypeReadRef& InNoiseType
+) : NoiseBankProcessor(InSettings.GetSampleRate(), *InSeed),
+	Seed(InSeed),
+	NoiseType(InNoiseType),
+	OldSeed(*InSeed) {
+	AudioOutputs.Reserve(NumChannels);
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+		AudioOutputs.Add(Metasound::FAudioBufferWriteRef::CreateNew(InSettings));
+	}
+}
+
+template<int32 NumChannels>
+const Metasound::FNodeClassMetadata& BachelorMetasound::TNoiseBankOperator<NumChannels>::GetNodeInfo() {
+	auto InitNodeInfo = []() -> Metasound::FNodeClassMetadata {
+		Metasound::FNodeClassMetadata Info;
+		Info.ClassName = { TEXT("UE"), TEXT("Noise Bank"), *FString::Printf(TEXT("%d"), NumChannels) };
+		Info.MajorVersion = 1;
+		Info.MinorVersion = 0;
+		Info.DisplayName = FText::Format(
+			LOCTEXT("BachelorMetasound_NoiseBankDisplayName", "Noise Bank ({0})"),
+			FText::AsNumber(NumChannels));
+		Info.Description = LOCTEXT("BachelorMetasound_NoiseBankNodeDescription",
+			"Generates several decorrelated noise channels of the same type in one node.");
+		Info.Author = Metasound::PluginAuthor;
+		Info.PromptIfMissing = Metasound::PluginNodeMissingPrompt;
+		Info.DefaultInterface = GetVertexInterface();
+		Info.CategoryHierarchy = { LOCTEXT("BachelorMetasound_NoiseBankNodeCategory", "Generators") };
+		return Info;
+	};
+	static const Metasound::FNodeClassMetadata Info = InitNodeInfo();
+	return Info;
+}
+
+template<int32 NumChannels>
+const Metasound::FVertexInterface& BachelorMetasound::TNoiseBankOperator<NumChannels>::GetVertexInterface() {
+	using namespace Metasound;
+	using namespace NoiseBankNode;
+	auto InitVertexInterface = []() -> FVertexInterface {
+		FInputVertexInterface InputInterface;
+		InputInterface.Add(TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameSeed), INDEX_NONE));
+		InputInterface.Add(TInputDataVertex<FEnumAdvancedNoiseType>(
+			METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameType), static_cast<int32>(EAdvancedNoiseType::Pink)));
+
+		FOutputVertexInterface OutputInterface;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+			OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(
+				METASOUND_GET_PARAM_NAME_WITH_INDEX_AND_METADATA(OutParamNameAudio, Channel)));
+		}
+		return FVertexInterface(InputInterface, OutputInterface);
+	};
+	static const FVertexInterface Interface = InitVertexInterface();
+	return Interface;
+}
+
+template<int32 NumChannels>
+TUniquePtr<Metasound::IOperator> BachelorMetasound::TNoiseBankOperator<NumChannels>::CreateOperator(
+	const Metasound::FBuildOperatorParams& InParams,
+	Metasound::FBuildResults& OutResults
+) {
+	using namespace Metasound;
+	using namespace NoiseBankNode;
+	FInt32ReadRef InSeed
+		= InParams.InputData.GetOrCreateDefaultDataReadReference<int32>(
+			METASOUND_GET_PARAM_NAME(InParamNameSeed),
+			InParams.OperatorSettings
+		);
+	FEnumAdvancedNoiseTypeReadRef InType
+		= InParams.InputData.GetOrCreateDefaultDataReadReference<FEnumAdvancedNoiseType>(
+			METASOUND_GET_PARAM_NAME(InParamNameType),
+			InParams.OperatorSettings
+		);
+	return MakeUnique<TNoiseBankOperator<NumChannels>>(InParams.OperatorSettings, InSeed, InType);
+}
+
+template<int32 NumChannels>
+void BachelorMetasound::TNoiseBankOperator<NumChannels>::BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) {
+	InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(NoiseBankNode::InParamNameSeed), Seed);
+	InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(NoiseBankNode::InParamNameType), NoiseType);
+}
+
+template<int32 NumChannels>
+void BachelorMetasound::TNoiseBankOperator<NumChannels>::BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) {
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+		InOutVertexData.BindReadVertex(
+			METASOUND_GET_PARAM_NAME_WITH_INDEX(NoiseBankNode::OutParamNameAudio, Channel),
+			AudioOutputs[Channel]);
+	}
+}
+
+template<int32 NumChannels>
+void BachelorMetasound::TNoiseBankOperator<NumChannels>::Execute() {
+	const FScopedNodeRenderStats RenderStats(ENodeRenderClass::NoiseBank, AudioOutputs[0]->Num());
+	const int32 NewSeed = *Seed;
+	if (OldSeed != NewSeed) {
+		NoiseBankProcessor.SetSeed(NewSeed);
+		OldSeed = NewSeed;
+	}
+
+	float* OutputAudio[NumChannels];
+	for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+		OutputAudio[Channel] = AudioOutputs[Channel]->GetData();
+	}
+
+	const int32 NumSamples = AudioOutputs[0]->Num();
+	NoiseBankProcessor.Generate(Metasound::GetNoiseColor(*NoiseType), OutputAudio, NumSamples);
+}
+
+template<int32 NumChannels>
+void BachelorMetasound::TNoiseBankOperator<NumChannels>::Reset(const Metasound::IOperator::FResetParams& InParams) {
+	OldSeed = *Seed;
+	NoiseBankProcessor.SetSeed(OldSeed);
+	for (const Metasound::FAudioBufferWriteRef& AudioOutput : AudioOutputs) {
+		AudioOutput->Zero();
+	}
+}
+
+template<int32 NumChannels>
+Metasound::IOperator::FResetFunction BachelorMetasound::TNoiseBankOperator<NumChannels>::GetResetFunction() {
+	return [](Metasound::IOperator* InOperator, const Metasound::IOperator::FResetParams& InParams) {
+		static_cast<TNoiseBankOperator*>(InOperator)->Reset(InParams);
+	};
+}
+
+namespace BachelorMetasound {
+	using FNoiseBankNode_2 = TNoiseBankNode<2>;
+	using FNoiseBankNode_4 = TNoiseBankNode<4>;
+	using FNoiseBankNode_8 = TNoiseBankNode<8>;
+
+	METASOUND_REGISTER_NODE(FNoiseBankNode_2)
+	METASOUND_REGISTER_NODE(FNoiseBankNode_4)
+	METASOUND_REGISTER_NODE(FNoiseBankNode_8)
+}
+
+#undef LOCTEXT_NAMESPACE
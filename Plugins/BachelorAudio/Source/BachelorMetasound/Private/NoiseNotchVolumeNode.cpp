@@ -0,0 +1,347 @@
+﻿/**
+ * @file NoiseNotchVolumeNode.cpp
+ * @brief MetaSound node generating, notch filtering and scaling noise in one operator.
+ *
+ * Per sample the operator runs the same kernels as the three single nodes, in the same order:
+ * noise generator, FPeakingFilter shaping, FNotchFilter and FBachelorVolume.
+ *
+ * The inputs are those of the three nodes, except "Use Wavetable" and "Runtime Type" of AdvancedNoise.
+ * The fused node always generates per sample with the type fixed at build time, like AdvancedNoise with
+ * both pins off.
+ */
+
+#include "NoiseNotchVolumeNode.h"
+#include "AdvancedNoiseNode.h"
+#include "ControlRate.h"
+#include "NodeRenderStats.h"
+
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "DSP/BachelorVolume.h"
+#include "DSP/ColoredNoise.h"
+#include "DSP/Noise.h"
+#include "DSP/NotchFilter.h"
+#include "DSP/PeakingFilter.h"
+
+#define LOCTEXT_NAMESPACE "BachelorMetasound_NoiseNotchVolumeNode"
+
+namespace BachelorMetasound::NoiseNotchVolumeNode {
+	// Noise input params
+	METASOUND_PARAM(InParamNameSeed, "Seed", "Start seed for generating noise.")
+	METASOUND_PARAM(InParamNameType, "Type", "Type of Noise to Generate.")
+	METASOUND_PARAM(InParamNameFrequency, "Frequency", "Center frequency of the noise shaping in Hz.")
+	METASOUND_PARAM(InParamNameBandwidth, "Bandwidth", "Quality of the noise shaping, only used by Green noise.")
+	METASOUND_PARAM(InParamNameGain, "Gain (db)", "Gain of the noise shaping at its center frequency in dB.")
+	// Notch filter input params
+	METASOUND_PARAM(InParamNameNotchFrequency, "Notch Frequency", "Frequency of sample.")
+	METASOUND_PARAM(InParamNameNotchCutoff, "Notch Cutoff", "Cutoff frequency.")
+	METASOUND_PARAM(InParamNameNotchBandwidth, "Notch Bandwidth", "Bandwidth coefficient.")
+	// Volume input params
+	METASOUND_PARAM(InParamNameAmplitude, "Amplitude", "The amount of amplitude to apply to the output signal.")
+
+	// Output params
+	METASOUND_PARAM(OutParamNameAudio, "Out", "Audio output.")
+
+	/** Shaping quality of every type but Green, has to match the AdvancedNoise node. */
+	constexpr float DefaultQuality = 0.707f;
+
+	/**
+	 * @class FNoiseNotchVolumeOperator
+	 * @brief Inputs, processors and vertex interface shared by all noise generator variants.
+	 */
+	class FNoiseNotchVolumeOperator : public Metasound::IOperator {
+	public:
+		FNoiseNotchVolumeOperator(
+			const Metasound::FOperatorSettings& InSettings,
+			const Metasound::FInt32ReadRef& InSeed,
+			const Metasound::FEnumAdvancedNoiseTypeReadRef& InNoiseType,
+			const Metasound::FFloatReadRef& InFrequency,
+			const Metasound::FFloatReadRef& InBandwidth,
+			const Metasound::FFloatReadRef& InGain,
+			const Metasound::FFloatReadRef& InNotchFrequency,
+			const Metasound::FFloatReadRef& InNotchCutoff,
+			const Metasound::FFloatReadRef& InNotchBandwidth,
+			const Metasound::FFloatReadRef& InAmplitude
+		) : Seed(InSeed),
+			NoiseType(InNoiseType),
+			Frequency(InFrequency),
+			Bandwidth(InBandwidth),
+			Gain(InGain),
+			NotchFrequency(InNotchFrequency),
+			NotchCutoff(InNotchCutoff),
+			NotchBandwidth(InNotchBandwidth),
+			Amplitude(InAmplitude),
+			AudioOutput(Metasound::FAudioBufferWriteRef::CreateNew(InSettings)),
+			SampleRate(InSettings.GetSampleRate()),
+			OldSeed(*InSeed),
+			ShapingParameters(InSettings.GetActualBlockRate()),
+			NotchParameters(InSettings.GetActualBlockRate()) {
+			UpdateShaping(true);
+		}
+
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+		static const Metasound::FVertexInterface& GetVertexInterface();
+		static TUniquePtr<Metasound::IOperator> CreateOperator(
+			const Metasound::FBuildOperatorParams& InParams,
+			Metasound::FBuildResults& OutResults
+		);
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameSeed), Seed);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameType), NoiseType);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFrequency), Frequency);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameBandwidth), Bandwidth);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameGain), Gain);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameNotchFrequency), NotchFrequency);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameNotchCutoff), NotchCutoff);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameNotchBandwidth), NotchBandwidth);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAmplitude), Amplitude);
+		}
+
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioOutput);
+		}
+
+		virtual FPostExecuteFunction GetPostExecuteFunction() override { return nullptr; }
+
+	protected:
+		/** Same generator construction as the AdvancedNoise node, Green noise is tuned for the sample rate. */
+		template<typename GeneratorType>
+		GeneratorType MakeGenerator(const int32 InSeed) const {
+			if constexpr (std::is_same_v<GeneratorType, BachelorDSP::FGreenNoise>) {
+				return GeneratorType{SampleRate, InSeed};
+			} else {
+				if (InSeed == INDEX_NONE) return GeneratorType{};
+				return GeneratorType{InSeed};
+			}
+		}
+
+		/** Same shaping update as the AdvancedNoise node, Bandwidth is the quality of Green noise only. */
+		void UpdateShaping(const bool bForce = false) {
+			if (bForce) ShapingParameters.Reset();
+			if (!ShapingParameters.Update({ *Frequency, *Bandwidth, *Gain })) return;
+
+			const float Quality = *NoiseType == Metasound::EAdvancedNoiseType::Green ? ShapingParameters[1] : DefaultQuality;
+			Shaping.SetValues(SampleRate, ShapingParameters[0], Quality, ShapingParameters[2]);
+		}
+
+		/** Same notch update as the NotchFilter node. */
+		void UpdateNotch() {
+			if (!NotchParameters.Update({ *NotchFrequency, *NotchCutoff, *NotchBandwidth })) return;
+			NotchFilterProcessor.SetValues(NotchParameters[0], NotchParameters[1], NotchParameters[2]);
+		}
+
+		/** Updates all processors from the inputs, in the order the three single nodes execute. */
+		void UpdateProcessors() {
+			UpdateShaping();
+			UpdateNotch();
+			VolumeProcessor.SetAmplitude(*Amplitude);
+		}
+
+		/** Generates, shapes, filters and scales one block in a single loop. */
+		template<typename GeneratorType>
+		FORCEINLINE void Render(GeneratorType& InGenerator) {
+			float* OutData = AudioOutput->GetData();
+			const int32 NumSamples = AudioOutput->Num();
+			const FScopedNodeRenderStats RenderStats(ENodeRenderClass::NoiseNotchVolume, NumSamples);
+
+			if (!Shaping.IsActive()) {
+				for (int32 Index = 0; Index < NumSamples; ++Index) {
+					OutData[Index] = VolumeProcessor.ProcessSample(
+						NotchFilterProcessor.ProcessSample(InGenerator.Generate()));
+				}
+				return;
+			}
+			for (int32 Index = 0; Index < NumSamples; ++Index) {
+				OutData[Index] = VolumeProcessor.ProcessSample(
+					NotchFilterProcessor.ProcessSample(Shaping.ProcessSample(InGenerator.Generate())));
+			}
+		}
+
+		/** Clears all processors and the output, like resetting the three single nodes. */
+		void ResetProcessors() {
+			UpdateShaping(true);
+			Shaping.Init();
+			NotchParameters.Reset();
+			UpdateNotch();
+			NotchFilterProcessor.Reset();
+			VolumeProcessor.Init();
+			AudioOutput->Zero();
+		}
+
+		Metasound::FInt32ReadRef Seed;
+		Metasound::FEnumAdvancedNoiseTypeReadRef NoiseType;
+		Metasound::FFloatReadRef Frequency;
+		Metasound::FFloatReadRef Bandwidth;
+		Metasound::FFloatReadRef Gain;
+		Metasound::FFloatReadRef NotchFrequency;
+		Metasound::FFloatReadRef NotchCutoff;
+		Metasound::FFloatReadRef NotchBandwidth;
+		Metasound::FFloatReadRef Amplitude;
+		Metasound::FAudioBufferWriteRef AudioOutput;
+
+		float SampleRate;
+		BachelorDSP::FPeakingFilter Shaping;
+		BachelorDSP::FNotchFilter NotchFilterProcessor;
+		BachelorDSP::FBachelorVolume VolumeProcessor;
+
+		int32 OldSeed;
+		/** Frequency, Bandwidth and Gain of the shaping. */
+		TControlRateParameters<3> ShapingParameters;
+		/** Sample rate, cutoff and bandwidth of the notch filter. */
+		TControlRateParameters<3> NotchParameters;
+	};
+
+	/**
+	 * @class TNoiseNotchVolumeOperator
+	 * @brief Fused operator for one noise generator, chosen by the static Type pin like AdvancedNoise.
+	 *
+	 * @tparam GeneratorType Audio::FWhiteNoise, Audio::FPinkNoise, BachelorDSP::FBrownNoise or BachelorDSP::FGreenNoise.
+	 */
+	template<typename GeneratorType>
+	class TNoiseNotchVolumeOperator final : public FNoiseNotchVolumeOperator {
+	public:
+		template<typename... ArgTypes>
+		explicit TNoiseNotchVolumeOperator(ArgTypes&&... Args)
+			: FNoiseNotchVolumeOperator(Forward<ArgTypes>(Args)...),
+			  Generator(MakeGenerator<GeneratorType>(*Seed)) {}
+
+		void Execute() {
+			const int32 NewSeed = *Seed;
+			if (OldSeed != NewSeed) {
+				Generator = MakeGenerator<GeneratorType>(NewSeed);
+				OldSeed = NewSeed;
+			}
+			UpdateProcessors();
+			Render(Generator);
+		}
+
+		void Reset(const FResetParams& InParams) {
+			Generator = MakeGenerator<GeneratorType>(*Seed);
+			OldSeed = *Seed;
+			ResetProcessors();
+		}
+
+		virtual FExecuteFunction GetExecuteFunction() override {
+			return [](IOperator* InOperator) {
+				static_cast<TNoiseNotchVolumeOperator*>(InOperator)->Execute();
+			};
+		}
+
+		virtual FResetFunction GetResetFunction() override {
+			return [](IOperator* InOperator, const FResetParams& InParams) {
+				static_cast<TNoiseNotchVolumeOperator*>(InOperator)->Reset(InParams);
+			};
+		}
+
+	private:
+		GeneratorType Generator;
+	};
+
+	const Metasound::FNodeClassMetadata& FNoiseNotchVolumeOperator::GetNodeInfo() {
+		auto InitNodeInfo = []() -> Metasound::FNodeClassMetadata {
+			Metasound::FNodeClassMetadata Info;
+			Info.ClassName = { TEXT("UE"), TEXT("Noise Notch Volume"), TEXT("Generators") };
+			Info.MajorVersion = 1;
+			Info.MinorVersion = 0;
+			Info.DisplayName = LOCTEXT("BachelorMetasound_NoiseNotchVolumeDisplayName", "Noise Notch Volume");
+			Info.Description = LOCTEXT("BachelorMetasound_NoiseNotchVolumeNodeDescription",
+				"Advanced Noise, Notch Filter and Volume in one node. Same output as the three nodes, in a single pass. "
+				"Noise is always generated per sample with a fixed type, Use Wavetable and Runtime Type are not supported.");
+			Info.Author = Metasound::PluginAuthor;
+			Info.PromptIfMissing = Metasound::PluginNodeMissingPrompt;
+			Info.DefaultInterface = GetVertexInterface();
+			Info.CategoryHierarchy = { LOCTEXT("BachelorMetasound_NoiseNotchVolumeNodeCategory", "Generators") };
+			return Info;
+		};
+		static const Metasound::FNodeClassMetadata Info = InitNodeInfo();
+		return Info;
+	}
+
+	const Metasound::FVertexInterface& FNoiseNotchVolumeOperator::GetVertexInterface() {
+		using namespace Metasound;
+		// Defaults are the defaults of the three single nodes.
+		static const FVertexInterface Interface(
+			FInputVertexInterface(
+				TInputDataVertex<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameSeed), INDEX_NONE),
+				TInputDataVertex<FEnumAdvancedNoiseType>(
+					METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameType), static_cast<int32>(EAdvancedNoiseType::Pink)),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameFrequency), 2000.f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameBandwidth), 0.f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameGain), 0.f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameNotchFrequency), 20000.f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameNotchCutoff), 20000.f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameNotchBandwidth), 0.f),
+				TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InParamNameAmplitude), 1.0f)
+			),
+			FOutputVertexInterface(
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutParamNameAudio))
+			)
+		);
+		return Interface;
+	}
+
+	TUniquePtr<Metasound::IOperator> FNoiseNotchVolumeOperator::CreateOperator(
+		const Metasound::FBuildOperatorParams& InParams,
+		Metasound::FBuildResults& OutResults
+	) {
+		using namespace Metasound;
+		const FInputVertexInterfaceData& InputData = InParams.InputData;
+		const FOperatorSettings& Settings = InParams.OperatorSettings;
+
+		FInt32ReadRef InSeed = InputData.GetOrCreateDefaultDataReadReference<int32>(
+			METASOUND_GET_PARAM_NAME(InParamNameSeed), Settings);
+		// Static property pin, only used for factory.
+		FEnumAdvancedNoiseTypeReadRef InType = InputData.GetOrCreateDefaultDataReadReference<FEnumAdvancedNoiseType>(
+			METASOUND_GET_PARAM_NAME(InParamNameType), Settings);
+		FFloatReadRef InFrequency = InputData.GetOrCreateDefaultDataReadReference<float>(
+			METASOUND_GET_PARAM_NAME(InParamNameFrequency), Settings);
+		FFloatReadRef InBandwidth = InputData.GetOrCreateDefaultDataReadReference<float>(
+			METASOUND_GET_PARAM_NAME(InParamNameBandwidth), Settings);
+		FFloatReadRef InGain = InputData.GetOrCreateDefaultDataReadReference<float>(
+			METASOUND_GET_PARAM_NAME(InParamNameGain), Settings);
+		FFloatReadRef InNotchFrequency = InputData.GetOrCreateDefaultDataReadReference<float>(
+			METASOUND_GET_PARAM_NAME(InParamNameNotchFrequency), Settings);
+		FFloatReadRef InNotchCutoff = InputData.GetOrCreateDefaultDataReadReference<float>(
+			METASOUND_GET_PARAM_NAME(InParamNameNotchCutoff), Settings);
+		FFloatReadRef InNotchBandwidth = InputData.GetOrCreateDefaultDataReadReference<float>(
+			METASOUND_GET_PARAM_NAME(InParamNameNotchBandwidth), Settings);
+		FFloatReadRef InAmplitude = InputData.GetOrCreateDefaultDataReadReference<float>(
+			METASOUND_GET_PARAM_NAME(InParamNameAmplitude), Settings);
+
+		// Every type uses the generator of the AdvancedNoise node, so the output matches the chain of single nodes.
+		switch (*InType) {
+		case EAdvancedNoiseType::Pink:
+			return MakeUnique<TNoiseNotchVolumeOperator<Audio::FPinkNoise>>(
+				Settings, InSeed, InType, InFrequency, InBandwidth, InGain,
+				InNotchFrequency, InNotchCutoff, InNotchBandwidth, InAmplitude);
+		case EAdvancedNoiseType::Brown:
+			return MakeUnique<TNoiseNotchVolumeOperator<BachelorDSP::FBrownNoise>>(
+				Settings, InSeed, InType, InFrequency, InBandwidth, InGain,
+				InNotchFrequency, InNotchCutoff, InNotchBandwidth, InAmplitude);
+		case EAdvancedNoiseType::Green:
+			return MakeUnique<TNoiseNotchVolumeOperator<BachelorDSP::FGreenNoise>>(
+				Settings, InSeed, InType, InFrequency, InBandwidth, InGain,
+				InNotchFrequency, InNotchCutoff, InNotchBandwidth, InAmplitude);
+		default:
+			return MakeUnique<TNoiseNotchVolumeOperator<Audio::FWhiteNoise>>(
+				Settings, InSeed, InType, InFrequency, InBandwidth, InGain,
+				InNotchFrequency, InNotchCutoff, InNotchBandwidth, InAmplitude);
+		}
+	}
+}
+
+BachelorMetasound::FNoiseNotchVolumeNode::FNoiseNotchVolumeNode(const Metasound::FNodeInitData& InitData)
+	: Metasound::FNodeFacade(
+		InitData.InstanceName,
+		InitData.InstanceID,
+		Metasound::TFacadeOperatorClass<NoiseNotchVolumeNode::FNoiseNotchVolumeOperator>())
+{}
+
+namespace BachelorMetasound {
+	METASOUND_REGISTER_NODE(FNoiseNotchVolumeNode)
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -8,6 +8,8 @@
 
 
 #include "NotchFilterNode.h"
+#include "NodeBuildHelpers.h"
+#include "NodeRenderStats.h"
 
 #define LOCTEXT_NAMESPACE "BluSumMetasound_NotchFilterNode"
 
@@ -19,6 +21,56 @@ namespace BachelorMetasound::NotchFilterNode {
 	METASOUND_PARAM(InParamNameBandwidth, "Bandwidth", "Bandwidth coefficient.")
 	// Output params
 	METASOUND_PARAM(OutParamNameAudio, "Out", "Audio output.")
+
+	/**
+	 * @class FNotchFilterSilenceOperator
+	 * @brief Notch filter operator for constant parameters the filter rejects.
+	 * 
+	 * A FNotchFilter that never accepted its parameters keeps zero coefficients and outputs silence,
+	 * so the output is zeroed once and no execute function is needed.
+	 */
+	class FNotchFilterSilenceOperator final : public Metasound::IOperator {
+	public:
+		FNotchFilterSilenceOperator(
+			const Metasound::FOperatorSettings& InSettings,
+			const Metasound::FAudioBufferReadRef& InAudioInput,
+			const Metasound::FFloatReadRef& InSampleFrequency,
+			const Metasound::FFloatReadRef& InCutoffFrequency,
+			const Metasound::FFloatReadRef& InBandwidthCoefficients
+		) : AudioInput(InAudioInput),
+			AudioOutput(Metasound::FAudioBufferWriteRef::CreateNew(InSettings)),
+			SampleFrequency(InSampleFrequency),
+			CutoffFrequency(InCutoffFrequency),
+			BandwidthCoefficients(InBandwidthCoefficients) {
+			AudioOutput->Zero();
+		}
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameFrequency), SampleFrequency);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameCutoff), CutoffFrequency);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameBandwidth), BandwidthCoefficients);
+		}
+
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioOutput);
+		}
+
+		virtual FExecuteFunction GetExecuteFunction() override { return nullptr; }
+		virtual FPostExecuteFunction GetPostExecuteFunction() override { return nullptr; }
+		virtual FResetFunction GetResetFunction() override {
+			return [](IOperator* InOperator, const FResetParams& InParams) {
+				static_cast<FNotchFilterSilenceOperator*>(InOperator)->AudioOutput->Zero();
+			};
+		}
+
+	private:
+		Metasound::FAudioBufferReadRef AudioInput;
+		Metasound::FAudioBufferWriteRef AudioOutput;
+		Metasound::FFloatReadRef SampleFrequency;
+		Metasound::FFloatReadRef CutoffFrequency;
+		Metasound::FFloatReadRef BandwidthCoefficients;
+	};
 }
 
 BachelorMetasound::FNotchFilterOperator::FNotchFilterOperator(
@@ -31,7 +83,8 @@ BachelorMetasound::FNotchFilterOperator::FNotchFilterOperator(
 	AudioOutput(Metasound::FAudioBufferWriteRef::CreateNew(InSettings)),
 	SampleFrequency(InSampleFrequency),
 	CutoffFrequency(InCutoffFrequency),
-	BandwidthCoefficients(InBandwidthCoefficients) {}
+	BandwidthCoefficients(InBandwidthCoefficients),
+	FilterParameters(InSettings.GetActualBlockRate()) {}
 
 const Metasound::FNodeClassMetadata& BachelorMetasound::FNotchFilterOperator::GetNodeInfo() {
 	auto InitNodeInfo = []() -> Metasound::FNodeClassMetadata {
@@ -95,6 +148,26 @@ TUniquePtr<Metasound::IOperator> BachelorMetasound::FNotchFilterOperator::Create
 				METASOUND_GET_PARAM_NAME(InParamNameBandwidth),
 				InParams.OperatorSettings
 			);
+
+		// Constant parameters the filter rejects can never produce anything but silence.
+		float ConstantFrequency = 0.f;
+		float ConstantCutoff = 0.f;
+		float ConstantBandwidth = 0.f;
+		const bool bConstantBandwidth
+			= TryGetConstantInput<float>(InParams, METASOUND_GET_PARAM_NAME(InParamNameBandwidth), ConstantBandwidth);
+		const bool bConstantValues = bConstantBandwidth
+			&& TryGetConstantInput<float>(InParams, METASOUND_GET_PARAM_NAME(InParamNameFrequency), ConstantFrequency)
+			&& TryGetConstantInput<float>(InParams, METASOUND_GET_PARAM_NAME(InParamNameCutoff), ConstantCutoff);
+		if ((bConstantBandwidth && !BachelorDSP::FNotchFilter::IsBandwidthCoefficientValid(ConstantBandwidth))
+			|| (bConstantValues && !BachelorDSP::FNotchFilter::AreValuesValid(ConstantFrequency, ConstantCutoff, ConstantBandwidth))) {
+			return MakeUnique<FNotchFilterSilenceOperator>(
+				InParams.OperatorSettings,
+				AudioIn,
+				InFrequency,
+				InCutoff,
+				InBandwidth);
+		}
+
 		return MakeUnique<FNotchFilterOperator>(
 			InParams.OperatorSettings, 
 			AudioIn, 
@@ -119,14 +192,30 @@ void BachelorMetasound::FNotchFilterOperator::Execute() {
 	float* OutputAudio = AudioOutput->GetData();
 
 	const int32 NumSamples = AudioInput->Num();
+	const FScopedNodeRenderStats RenderStats(ENodeRenderClass::NotchFilter, NumSamples);
 
-	NotchFilterProcessor.SetValues(
-		*SampleFrequency, 
-		*CutoffFrequency, 
-		*BandwidthCoefficients);
+	UpdateFilterParameters();
 	NotchFilterProcessor.Process(InputAudio, OutputAudio, NumSamples);
 }
 
+void BachelorMetasound::FNotchFilterOperator::UpdateFilterParameters() {
+	if (!FilterParameters.Update({ *SampleFrequency, *CutoffFrequency, *BandwidthCoefficients })) return;
+	NotchFilterProcessor.SetValues(FilterParameters[0], FilterParameters[1], FilterParameters[2]);
+}
+
+void BachelorMetasound::FNotchFilterOperator::Reset(const Metasound::IOperator::FResetParams& InParams) {
+	FilterParameters.Reset();
+	UpdateFilterParameters();
+	NotchFilterProcessor.Reset();
+	AudioOutput->Zero();
+}
+
+Metasound::IOperator::FResetFunction BachelorMetasound::FNotchFilterOperator::GetResetFunction() {
+	return [](Metasound::IOperator* InOperator, const Metasound::IOperator::FResetParams& InParams) {
+		static_cast<FNotchFilterOperator*>(InOperator)->Reset(InParams);
+	};
+}
+
 namespace BachelorMetasound {
 	METASOUND_REGISTER_NODE(FNotchFilterNode)
 }
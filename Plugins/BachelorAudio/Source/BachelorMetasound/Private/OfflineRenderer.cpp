@@ -0,0 +1,200 @@
+﻿/**
+ * @file OfflineRenderer.cpp
+ * @brief Parallel offline rendering of BachelorDSP processor chains into WAV files.
+ */
+
+#include "OfflineRenderer.h"
+
+#include "Audio.h"
+#include "Async/ParallelFor.h"
+#include "DSP/BachelorVolume.h"
+#include "DSP/NoiseBank.h"
+#include "DSP/NotchFilter.h"
+#include "DSP/PeakingFilter.h"
+#include "DSP/ProcessorRegistry.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace BachelorMetasound {
+
+	namespace OfflineRenderer {
+
+		FORCEINLINE float GetParameter(const FOfflineRenderStage& InStage, const int32 InIndex) {
+			return InStage.Parameters.IsValidIndex(InIndex) ? InStage.Parameters[InIndex] : 0.f;
+		}
+
+		/**
+		 * Applies the stage parameters and clears the processor state, so every job starts silent.
+		 *
+		 * @return False with OutError set if the stage type has no configuration.
+		 */
+		bool ConfigureProcessor(
+			BachelorDSP::FProcessorBase& InOutProcessor,
+			const FOfflineRenderStage& InStage,
+			const float InSampleRate,
+			FString& OutError
+		) {
+			switch (InStage.Type) {
+			case BachelorDSP::EDSPType::NotchFilter: {
+				BachelorDSP::FNotchFilter& Notch = static_cast<BachelorDSP::FNotchFilter&>(InOutProcessor);
+				Notch.SetValues(InSampleRate, GetParameter(InStage, 0), GetParameter(InStage, 1));
+				Notch.Reset();
+				return true;
+			}
+			case BachelorDSP::EDSPType::PeakingFilter: {
+				BachelorDSP::FPeakingFilter& Peaking = static_cast<BachelorDSP::FPeakingFilter&>(InOutProcessor);
+				Peaking.SetValues(InSampleRate, GetParameter(InStage, 0), GetParameter(InStage, 1), GetParameter(InStage, 2));
+				Peaking.Init();
+				return true;
+			}
+			case BachelorDSP::EDSPType::Volume: {
+				BachelorDSP::FBachelorVolume& Volume = static_cast<BachelorDSP::FBachelorVolume&>(InOutProcessor);
+				Volume.Init();
+				Volume.SetAmplitude(GetParameter(InStage, 0));
+				return true;
+			}
+			default:
+				OutError = FString::Printf(TEXT("Processor type %d can not be configured"), static_cast<int32>(InStage.Type));
+				return false;
+			}
+		}
+
+		/**
+		 * @class FWorker
+		 * @brief Processors and buffers of one worker thread, reused by all jobs the worker renders.
+		 *
+		 * Buffers only grow and processors come from the worker's pool, so after the longest job a worker
+		 * renders without allocating, apart from file IO.
+		 */
+		class FWorker {
+		public:
+			FOfflineRenderResult Render(const FOfflineRenderJob& InJob) {
+				FOfflineRenderResult Result;
+				const double StartSeconds = FPlatformTime::Seconds();
+
+				int32 SampleRate = InJob.SampleRate;
+				if (!MakeInput(InJob, SampleRate, Result.Error)) return Result;
+
+				// The chain of the previous job goes back to the pool, its memory is reused for this one.
+				Chain.Reset();
+				for (const FOfflineRenderStage& Stage : InJob.Chain) {
+					BachelorDSP::FProcessorPool::FProcessorPtr Processor = Pool.Acquire(Stage.Type);
+					if (!Processor.IsValid()) {
+						Result.Error = FString::Printf(TEXT("Unknown processor type %d"), static_cast<int32>(Stage.Type));
+						return Result;
+					}
+					if (!ConfigureProcessor(*Processor, Stage, static_cast<float>(SampleRate), Result.Error)) return Result;
+					Chain.Add(MoveTemp(Processor));
+				}
+
+				// The whole chain runs per chunk, so a chunk stays in cache from the first to the last stage.
+				float* Data = Buffer.GetData();
+				BachelorDSP::ForEachChunk(Buffer.Num(), [this, Data](const int32 Offset, const int32 NumChunkSamples) {
+					for (const BachelorDSP::FProcessorPool::FProcessorPtr& Processor : Chain) {
+						Processor->Process(Data + Offset, Data + Offset, NumChunkSamples);
+					}
+				});
+
+				if (!WriteOutput(InJob, SampleRate, Result.Error)) return Result;
+
+				Result.bSucceeded = true;
+				Result.NumFrames = Buffer.Num();
+				Result.Seconds = FPlatformTime::Seconds() - StartSeconds;
+				return Result;
+			}
+
+		private:
+			bool MakeInput(const FOfflineRenderJob& InJob, int32& OutSampleRate, FString& OutError) {
+				if (InJob.InputPath.IsEmpty()) {
+					if (InJob.NumFrames <= 0 || InJob.SampleRate <= 0) {
+						OutError = TEXT("Generated input needs NumFrames and SampleRate");
+						return false;
+					}
+					Buffer.SetNumUninitialized(InJob.NumFrames, false);
+					BachelorDSP::TNoiseBank<1> Noise(static_cast<float>(InJob.SampleRate), InJob.Seed);
+					float* Channels[1] = { Buffer.GetData() };
+					Noise.Generate(InJob.NoiseColor, Channels, InJob.NumFrames);
+					return true;
+				}
+				return LoadWave(InJob.InputPath, OutSampleRate, OutError);
+			}
+
+			/** Loads a 16 bit PCM WAV file, multichannel files are mixed down to mono. */
+			bool LoadWave(const FString& InPath, int32& OutSampleRate, FString& OutError) {
+				if (!FFileHelper::LoadFileToArray(FileBytes, *InPath)) {
+					OutError = FString::Printf(TEXT("Can not read %s"), *InPath);
+					return false;
+				}
+				FWaveModInfo WaveInfo;
+				if (!WaveInfo.ReadWaveInfo(FileBytes.GetData(), FileBytes.Num(), &OutError)) return false;
+				if (*WaveInfo.pBitsPerSample != 16 || *WaveInfo.pChannels == 0) {
+					OutError = FString::Printf(TEXT("%s is no 16 bit PCM file"), *InPath);
+					return false;
+				}
+
+				const int32 NumChannels = *WaveInfo.pChannels;
+				const int32 NumFrames = WaveInfo.SampleDataSize / (sizeof(int16) * NumChannels);
+				const int16* Samples = reinterpret_cast<const int16*>(WaveInfo.SampleDataStart);
+				const float Scale = 1.f / (32768.f * NumChannels);
+				Buffer.SetNumUninitialized(NumFrames, false);
+				for (int32 Frame = 0; Frame < NumFrames; ++Frame) {
+					int32 Sum = 0;
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel) {
+						Sum += Samples[Frame * NumChannels + Channel];
+					}
+					Buffer[Frame] = Sum * Scale;
+				}
+				OutSampleRate = static_cast<int32>(*WaveInfo.pSamplesPerSec);
+				return true;
+			}
+
+			bool WriteOutput(const FOfflineRenderJob& InJob, const int32 InSampleRate, FString& OutError) {
+				Pcm.SetNumUninitialized(Buffer.Num(), false);
+				for (int32 Index = 0; Index < Buffer.Num(); ++Index) {
+					Pcm[Index] = static_cast<int16>(FMath::Clamp(Buffer[Index] * 32767.f, -32768.f, 32767.f));
+				}
+
+				FileBytes.Reset();
+				SerializeWaveFile(FileBytes, reinterpret_cast<const uint8*>(Pcm.GetData()), Pcm.Num() * sizeof(int16), 1, InSampleRate);
+				IFileManager::Get().MakeDirectory(*FPaths::GetPath(InJob.OutputPath), true);
+				if (!FFileHelper::SaveArrayToFile(FileBytes, *InJob.OutputPath)) {
+					OutError = FString::Printf(TEXT("Can not write %s"), *InJob.OutputPath);
+					return false;
+				}
+				return true;
+			}
+
+			/** Memory of all processors the worker ever needed at once. */
+			BachelorDSP::FProcessorPool Pool;
+
+			/** Processors of the current job in chain order, declared after Pool to be released first. */
+			TArray<BachelorDSP::FProcessorPool::FProcessorPtr> Chain;
+
+			/** Mono signal of the current job, rendered in place. */
+			TArray<float> Buffer;
+
+			/** 16 bit samples of the current job. */
+			TArray<int16> Pcm;
+
+			/** Raw bytes of the loaded or written WAV file. */
+			TArray<uint8> FileBytes;
+		};
+	}
+
+	TArray<FOfflineRenderResult> FOfflineRenderer::Render(const TArray<FOfflineRenderJob>& InJobs, const bool bInSingleThreaded) {
+		TArray<FOfflineRenderResult> Results;
+		Results.SetNum(InJobs.Num());
+
+		TArray<OfflineRenderer::FWorker> Workers;
+		ParallelForWithTaskContext(
+			Workers,
+			InJobs.Num(),
+			[&InJobs, &Results](OfflineRenderer::FWorker& Worker, const int32 Index) {
+				Results[Index] = Worker.Render(InJobs[Index]);
+			},
+			bInSingleThreaded ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+		return Results;
+	}
+
+}
@@ -0,0 +1,140 @@
+﻿/**
+ * @file AdvancedNoiseModulatorBank.Test.cpp
+ * @brief Tests of the structure of arrays noise modulator bank against the single noise modulators.
+ */
+
+#include "DSP/AdvancedNoiseModulatorBank.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+namespace {
+
+    /** Control rate of the tested banks. */
+    constexpr float TestControlRate = 1000.f;
+
+    /** Ticks rendered per measurement, five seconds at the test control rate. */
+    constexpr int32 TestNumTicks = 5000;
+
+    /** Single modulator of the given color, as the bank replaces it. */
+    TUniquePtr<FAdvancedNoiseModulator> MakeModulator(const float& SampleRate, const FAdvancedNoiseParameterPack& Pack, const uint8 Type) {
+        switch (Type) {
+        case 1: return MakeUnique<FPinkNoiseModulator>(SampleRate, Pack);
+        case 2: return MakeUnique<FBrownNoiseModulator>(SampleRate, Pack);
+        case 3: return MakeUnique<FGreenNoiseModulator>(SampleRate, Pack);
+        default: return MakeUnique<FWhiteNoiseModulator>(SampleRate, Pack);
+        }
+    }
+
+    /** Renders the bank and returns the values of one modulator. */
+    TArray<float> RenderModulator(FAdvancedNoiseModulatorBank& Bank, const int32 Index) {
+        TArray<float> Values;
+        TArray<float> Tick;
+        Tick.SetNumZeroed(Bank.Num());
+        for (int32 Step = 0; Step < TestNumTicks; ++Step) {
+            Bank.Process(Tick);
+            Values.Add(Tick[Index]);
+        }
+        return Values;
+    }
+
+    /** @return Root mean square of the values. */
+    float GetRms(const TArray<float>& Values) {
+        double Sum = 0.0;
+        for (const float Value : Values) Sum += static_cast<double>(Value) * Value;
+        return static_cast<float>(FMath::Sqrt(Sum / FMath::Max(Values.Num(), 1)));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAdvancedNoiseModulatorBankColorTest,
+    "prototype.BachelorAudio.BachelorMetasound.AdvancedNoiseModulatorBank.000_ColorTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAdvancedNoiseModulatorBankColorTest::RunTest(const FString& Parameters) {
+    const float ControlRate = TestControlRate;
+    const FAdvancedNoiseParameterPack Pack;
+
+    for (uint8 Type = 0; Type < 4; ++Type) {
+        const FString What = FString::Printf(TEXT("Type %d"), Type);
+        const TUniquePtr<FAdvancedNoiseModulator> Modulator = MakeModulator(ControlRate, Pack, Type);
+
+        FAdvancedNoiseModulatorBank Bank(ControlRate, 1, 1234);
+        const int32 Index = Bank.Add(Pack, Type);
+        TestEqual(What + TEXT(" should keep the color of the single modulator"), Bank.GetType(Index), Modulator->GetType());
+        TestEqual(What + TEXT(" should default to the scale of the single modulator"), Modulator->GetScale(), 1.f);
+
+        const TArray<float> Values = RenderModulator(Bank, Index);
+        bool bIsFinite = true;
+        float Peak = 0.f;
+        for (const float Value : Values) {
+            bIsFinite &= FMath::IsFinite(Value);
+            Peak = FMath::Max(Peak, FMath::Abs(Value));
+        }
+        TestTrue(What + TEXT(" should stay finite"), bIsFinite);
+        TestTrue(What + TEXT(" should not be silent with default parameters"), GetRms(Values) > 1.e-3f);
+        TestTrue(What + TEXT(" should stay within full scale at 0 dB"), Peak <= 4.f);
+    }
+
+    // The single modulators fall back to white for unknown types, so does the bank
+    FAdvancedNoiseModulatorBank Bank(ControlRate, 1, 1234);
+    TestEqual(TEXT("Unknown types should fall back to white"), Bank.GetType(Bank.Add(Pack, 7)), static_cast<uint8>(0));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAdvancedNoiseModulatorBankParameterTest,
+    "prototype.BachelorAudio.BachelorMetasound.AdvancedNoiseModulatorBank.005_ParameterTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAdvancedNoiseModulatorBankParameterTest::RunTest(const FString& Parameters) {
+    // Same seed and index, so both banks draw the same noise and differ only by gain
+    FAdvancedNoiseParameterPack Pack;
+    FAdvancedNoiseModulatorBank Reference(TestControlRate, 1, 1234);
+    FAdvancedNoiseModulatorBank Louder(TestControlRate, 1, 1234);
+    Reference.Add(Pack, 0);
+    Pack.Gain = 20.f * FMath::LogX(10.f, 2.f);
+    Louder.Add(Pack, 0);
+    const TArray<float> ReferenceValues = RenderModulator(Reference, 0);
+    const TArray<float> LouderValues = RenderModulator(Louder, 0);
+    TestEqual(TEXT("+6 dB should double the output"), GetRms(LouderValues), 2.f * GetRms(ReferenceValues), 1.e-3f);
+
+    // Brown and Green apply offset and scale, a zero scale leaves only the offset
+    FAdvancedNoiseParameterPack OffsetPack;
+    OffsetPack.Scale = 0.f;
+    OffsetPack.Offset = 0.5f;
+    FAdvancedNoiseModulatorBank Bank(TestControlRate, 3, 1234);
+    Bank.Add(OffsetPack, 0);
+    const int32 Brown = Bank.Add(OffsetPack, 2);
+    TestEqual(TEXT("Brown should output the offset at zero scale"), RenderModulator(Bank, Brown).Last(), 0.5f);
+
+    // The last modulator takes the removed index
+    Bank.RemoveAtSwap(0);
+    TestEqual(TEXT("RemoveAtSwap should remove one modulator"), Bank.Num(), 1);
+    TestEqual(TEXT("The last modulator should take the removed index"), Bank.GetType(0), static_cast<uint8>(2));
+
+    // A modulator added after a removal reuses an index, but must not repeat the noise of the moved one
+    FAdvancedNoiseModulatorBank Reused(TestControlRate, 2, 1234);
+    Reused.Add(Pack, 0);
+    Reused.Add(Pack, 0);
+    Reused.RemoveAtSwap(0);
+    Reused.Add(Pack, 0);
+    TArray<float> Tick;
+    Tick.SetNumZeroed(Reused.Num());
+    int32 NumEqual = 0;
+    for (int32 Step = 0; Step < TestNumTicks; ++Step) {
+        Reused.Process(Tick);
+        NumEqual += Tick[0] == Tick[1] ? 1 : 0;
+    }
+    TestTrue(TEXT("A reused index should get a new random sequence"), NumEqual < TestNumTicks);
+    return true;
+}
+
+#endif
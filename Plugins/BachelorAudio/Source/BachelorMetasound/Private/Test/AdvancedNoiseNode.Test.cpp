@@ -0,0 +1,241 @@
+﻿/**
+ * @file AdvancedNoiseNode.Test.cpp
+ * @brief Headless render and benchmark tests for every operator variant of the advanced noise node.
+ */
+
+#include "AdvancedNoiseNode.h"
+#include "Test/OperatorTestHarness.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorMetasound::Test;
+
+namespace {
+
+    /** Noise types covered by the tests. */
+    constexpr Metasound::EAdvancedNoiseType NoiseTypes[] = {
+        Metasound::EAdvancedNoiseType::Pink,
+        Metasound::EAdvancedNoiseType::White,
+        Metasound::EAdvancedNoiseType::Brown,
+        Metasound::EAdvancedNoiseType::Green
+    };
+
+    /** Binds the static pins selecting the operator variant in CreateOperator. */
+    void SetVariantInputs(
+        FOperatorTestHarness& Harness,
+        const Metasound::EAdvancedNoiseType Type,
+        const bool bUseWavetable,
+        const bool bRuntimeType
+    ) {
+        Harness.SetInput<int32>(TEXT("Seed"), 1234);
+        Harness.SetInput<Metasound::FEnumAdvancedNoiseType>(TEXT("Type"), Metasound::FEnumAdvancedNoiseType(Type));
+        Harness.SetInput<bool>(TEXT("Use Wavetable"), bUseWavetable);
+        Harness.SetInput<bool>(TEXT("Runtime Type"), bRuntimeType);
+    }
+
+    /** Blocks rendered by the type change tests, Type changes before SwitchBlock. */
+    constexpr int32 NumTypeChangeBlocks = 32;
+    constexpr int32 SwitchBlock = 16;
+
+    /**
+     * Renders NumTypeChangeBlocks with the given type, optionally switching to another one before SwitchBlock.
+     *
+     * @param bRuntimeType Whether the Runtime Type operator is used, required for a switch.
+     * @param bUseWavetable Whether the noise is read from the shared tables.
+     * @return Concatenated output, empty if the operator could not be built.
+     */
+    TArray<float> RenderTypeChange(
+        const Metasound::INode& Node,
+        const Metasound::EAdvancedNoiseType FromType,
+        const Metasound::EAdvancedNoiseType ToType,
+        const bool bRuntimeType,
+        const float Gain,
+        const bool bUseWavetable = false
+    ) {
+        FOperatorTestHarness Harness(Node);
+        Harness.SetInput<int32>(TEXT("Seed"), 1234);
+        const Metasound::TDataWriteReference<Metasound::FEnumAdvancedNoiseType> Type =
+            Harness.SetWritableInput<Metasound::FEnumAdvancedNoiseType>(TEXT("Type"), Metasound::FEnumAdvancedNoiseType(FromType));
+        Harness.SetInput<bool>(TEXT("Runtime Type"), bRuntimeType);
+        Harness.SetInput<bool>(TEXT("Use Wavetable"), bUseWavetable);
+        Harness.SetInput<float>(TEXT("Gain (db)"), Gain);
+        Harness.SetInput<float>(TEXT("Bandwidth"), 0.5f);
+
+        TArray<float> Rendered;
+        if (!Harness.Build()) return Rendered;
+        const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+        if (Output == nullptr) return Rendered;
+
+        for (int32 Block = 0; Block < NumTypeChangeBlocks; ++Block) {
+            if (Block == SwitchBlock) *Type = Metasound::FEnumAdvancedNoiseType(ToType);
+            Harness.Render(1);
+            Rendered.Append(Output->GetData(), Output->Num());
+        }
+        return Rendered;
+    }
+
+    /** @return Largest step between two neighboring samples in [Begin, End). */
+    float GetMaxStep(const TArray<float>& Samples, const int32 Begin, const int32 End) {
+        float MaxStep = 0.f;
+        for (int32 Index = FMath::Max(Begin, 1); Index < End; ++Index) {
+            MaxStep = FMath::Max(MaxStep, FMath::Abs(Samples[Index] - Samples[Index - 1]));
+        }
+        return MaxStep;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAdvancedNoiseNodeRenderTest,
+    "prototype.BachelorAudio.BachelorMetasound.AdvancedNoiseNode.000_RenderTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAdvancedNoiseNodeRenderTest::RunTest(const FString& Parameters) {
+    const Metasound::FAdvancedNoiseNode Node({ TEXT("AdvancedNoiseTest"), FGuid::NewGuid() });
+
+    for (const Metasound::EAdvancedNoiseType Type : NoiseTypes) {
+        for (int32 Variant = 0; Variant < 3; ++Variant) {
+            FOperatorTestHarness Harness(Node);
+            SetVariantInputs(Harness, Type, Variant == 1, Variant == 2);
+            Harness.SetInput<float>(TEXT("Gain (db)"), 6.f);
+
+            const FString What = FString::Printf(TEXT("Type %d, variant %d"), static_cast<int32>(Type), Variant);
+            if (!TestTrue(What + TEXT(" should be created"), Harness.Build())) continue;
+            Harness.Render(16);
+
+            const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+            if (!TestNotNull(What + TEXT(" should bind its output"), Output)) continue;
+
+            bool bIsFinite = true;
+            float Peak = 0.f;
+            for (int32 Index = 0; Index < Output->Num(); ++Index) {
+                bIsFinite &= FMath::IsFinite(Output->GetData()[Index]);
+                Peak = FMath::Max(Peak, FMath::Abs(Output->GetData()[Index]));
+            }
+            TestTrue(What + TEXT(" should stay finite"), bIsFinite);
+            TestTrue(What + TEXT(" should produce a signal"), Peak > 0.f);
+        }
+    }
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAdvancedNoiseNodeBenchmarkTest,
+    "prototype.BachelorAudio.BachelorMetasound.AdvancedNoiseNode.005_BenchmarkTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAdvancedNoiseNodeBenchmarkTest::RunTest(const FString& Parameters) {
+    const Metasound::FAdvancedNoiseNode Node({ TEXT("AdvancedNoiseBenchmark"), FGuid::NewGuid() });
+    const TCHAR* VariantNames[] = { TEXT("Generator"), TEXT("Wavetable"), TEXT("Runtime Type") };
+
+    for (const Metasound::EAdvancedNoiseType Type : NoiseTypes) {
+        for (int32 Variant = 0; Variant < 3; ++Variant) {
+            FOperatorTestHarness Harness(Node);
+            SetVariantInputs(Harness, Type, Variant == 1, Variant == 2);
+            if (!TestTrue(TEXT("Advanced noise operator should be created"), Harness.Build())) continue;
+
+            const FOperatorBenchmarkResult Result = Harness.Benchmark(4096);
+            AddInfo(FString::Printf(
+                TEXT("AdvancedNoise type %d, %s: %s"), static_cast<int32>(Type), VariantNames[Variant], *Result.ToString()));
+
+            TestEqual(TEXT("Advanced noise operator should not allocate while rendering"), Result.AllocationsPerBlock, 0.0);
+        }
+    }
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAdvancedNoiseNodeTypeChangeTest,
+    "prototype.BachelorAudio.BachelorMetasound.AdvancedNoiseNode.010_TypeChangeTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAdvancedNoiseNodeTypeChangeTest::RunTest(const FString& Parameters) {
+    using Metasound::EAdvancedNoiseType;
+    const Metasound::FAdvancedNoiseNode Node({ TEXT("AdvancedNoiseTypeChange"), FGuid::NewGuid() });
+    const int32 NumFramesPerBlock = FOperatorTestHarness(Node).GetOperatorSettings().GetNumFramesPerBlock();
+    const int32 SwitchFrame = SwitchBlock * NumFramesPerBlock;
+
+    // Brown barely moves between samples, a hard switch to White would jump by about the white noise amplitude
+    const TArray<float> Switched = RenderTypeChange(Node, EAdvancedNoiseType::Brown, EAdvancedNoiseType::White, true, 0.f);
+    if (!TestEqual(TEXT("Runtime type operator should render every block"), Switched.Num(), NumTypeChangeBlocks * NumFramesPerBlock)) {
+        return false;
+    }
+    const float BrownStep = GetMaxStep(Switched, 0, SwitchFrame);
+    TestTrue(
+        TEXT("The first sample after the switch should continue the previous type without a click"),
+        FMath::Abs(Switched[SwitchFrame] - Switched[SwitchFrame - 1]) <= 2.f * BrownStep);
+    TestTrue(
+        TEXT("The crossfade should not step further than the new type itself"),
+        GetMaxStep(Switched, SwitchFrame, SwitchFrame + 2 * NumFramesPerBlock) <= GetMaxStep(Switched, SwitchFrame + 2 * NumFramesPerBlock, Switched.Num()));
+
+    // White is untouched before the switch, so after the fade it has to equal a White operator started at the switch
+    const TArray<float> White = RenderTypeChange(Node, EAdvancedNoiseType::White, EAdvancedNoiseType::White, false, 0.f);
+    const int32 SettledFrame = SwitchFrame + 4 * NumFramesPerBlock;
+    bool bIsWhite = White.Num() == Switched.Num();
+    for (int32 Index = SettledFrame; bIsWhite && Index < Switched.Num(); ++Index) {
+        bIsWhite &= Switched[Index] == White[Index - SwitchFrame];
+    }
+    TestTrue(TEXT("After the crossfade the output should be the new type"), bIsWhite);
+
+    // Green changes the shaping quality, after the filter settled the output matches a Green operator
+    const TArray<float> SwitchedGreen = RenderTypeChange(Node, EAdvancedNoiseType::Pink, EAdvancedNoiseType::Green, true, 6.f);
+    const TArray<float> Green = RenderTypeChange(Node, EAdvancedNoiseType::Green, EAdvancedNoiseType::Green, false, 6.f);
+    if (SwitchedGreen.Num() == Switched.Num() && Green.Num() == Switched.Num()) {
+        float MaxError = 0.f;
+        for (int32 Index = SettledFrame; Index < SwitchedGreen.Num(); ++Index) {
+            MaxError = FMath::Max(MaxError, FMath::Abs(SwitchedGreen[Index] - Green[Index - SwitchFrame]));
+        }
+        TestTrue(TEXT("After the crossfade the output should have the shaping of the new type"), MaxError < 1.e-4f);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FAdvancedNoiseNodeRuntimeWavetableTest,
+    "prototype.BachelorAudio.BachelorMetasound.AdvancedNoiseNode.015_RuntimeWavetableTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FAdvancedNoiseNodeRuntimeWavetableTest::RunTest(const FString& Parameters) {
+    using Metasound::EAdvancedNoiseType;
+    const Metasound::FAdvancedNoiseNode Node({ TEXT("AdvancedNoiseRuntimeWavetable"), FGuid::NewGuid() });
+    const int32 NumFramesPerBlock = FOperatorTestHarness(Node).GetOperatorSettings().GetNumFramesPerBlock();
+    const int32 SwitchFrame = SwitchBlock * NumFramesPerBlock;
+
+    // Without a switch Runtime Type has to read the same table as the plain wavetable operator
+    const TArray<float> Runtime = RenderTypeChange(Node, EAdvancedNoiseType::Pink, EAdvancedNoiseType::Pink, true, 0.f, true);
+    const TArray<float> Wavetable = RenderTypeChange(Node, EAdvancedNoiseType::Pink, EAdvancedNoiseType::Pink, false, 0.f, true);
+    if (!TestEqual(TEXT("Runtime type operator should render every block"), Runtime.Num(), NumTypeChangeBlocks * NumFramesPerBlock)) {
+        return false;
+    }
+    TestTrue(TEXT("Use Wavetable should not be ignored with Runtime Type"), Runtime == Wavetable);
+
+    // The White reader is untouched before the switch, so after the fade it matches a White table started at the switch
+    const TArray<float> Switched = RenderTypeChange(Node, EAdvancedNoiseType::Brown, EAdvancedNoiseType::White, true, 0.f, true);
+    const TArray<float> White = RenderTypeChange(Node, EAdvancedNoiseType::White, EAdvancedNoiseType::White, false, 0.f, true);
+    const int32 SettledFrame = SwitchFrame + 4 * NumFramesPerBlock;
+    bool bIsWhite = White.Num() == Switched.Num();
+    for (int32 Index = SettledFrame; bIsWhite && Index < Switched.Num(); ++Index) {
+        bIsWhite &= Switched[Index] == White[Index - SwitchFrame];
+    }
+    TestTrue(TEXT("After the crossfade the output should be the table of the new type"), bIsWhite);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,259 @@
+﻿/**
+ * @file BlockSize.Test.cpp
+ * @brief Tests that every node renders bit identical output for any block size.
+ *
+ * Offline rendering uses blocks of 4096 samples and more, realtime rendering a few hundred. Both
+ * have to produce the same signal, so every node renders the same input with several block sizes and
+ * the concatenated outputs are compared bit by bit.
+ */
+
+#include "AdvancedNoiseNode.h"
+#include "NoiseBankNode.h"
+#include "NoiseNotchVolumeNode.h"
+#include "NotchFilterNode.h"
+#include "VolumeNode.h"
+#include "Test/OperatorTestHarness.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorMetasound::Test;
+
+namespace {
+
+    /** Frames rendered per block size. */
+    constexpr int32 NumTotalFrames = 12288;
+
+    /** Frames of the longest render, tests changing inputs render past the first NumTotalFrames. */
+    constexpr int32 MaxTotalFrames = 2 * NumTotalFrames;
+
+    /** 384 is no multiple of the DSP chunk size, 12288 renders everything in one block. */
+    constexpr int32 BlockSizes[] = { 128, 384, 4096, 12288 };
+
+    /** Deterministic input for the whole render, sliced into the blocks of every block size. */
+    TArray<float> MakeInputSignal() {
+        TArray<float> Signal;
+        Signal.SetNumUninitialized(MaxTotalFrames);
+        FRandomStream Random(7);
+        const float Increment = 2.f * PI * 440.f / 48000.f;
+        for (int32 Index = 0; Index < MaxTotalFrames; ++Index) {
+            Signal[Index] = 0.5f * FMath::Sin(Increment * Index) + 0.25f * Random.FRandRange(-1.f, 1.f);
+        }
+        return Signal;
+    }
+
+    /**
+     * Renders NumFrames with one block size.
+     *
+     * @param OnBlock Called with the first frame of every block before it is rendered, to change inputs.
+     * @return Concatenated output, empty if the operator could not be built.
+     */
+    TArray<float> RenderWithBlockSize(
+        const Metasound::INode& Node,
+        const int32 BlockSize,
+        TFunctionRef<void(FOperatorTestHarness&)> SetInputs,
+        const bool bHasAudioInput,
+        const Metasound::FVertexName& OutputName,
+        const int32 NumFrames,
+        TFunctionRef<void(int32)> OnBlock
+    ) {
+        FOperatorTestHarness Harness(Node, 48000.f, BlockSize);
+        TOptional<Metasound::FAudioBufferWriteRef> Input;
+        if (bHasAudioInput) Input = Harness.SetAudioInput(TEXT("In"));
+        SetInputs(Harness);
+
+        TArray<float> Rendered;
+        if (!Harness.Build() || Harness.GetOperatorSettings().GetNumFramesPerBlock() != BlockSize) return Rendered;
+        const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(OutputName);
+        if (Output == nullptr) return Rendered;
+
+        static const TArray<float> Signal = MakeInputSignal();
+        Rendered.Reserve(NumFrames);
+        for (int32 Offset = 0; Offset < NumFrames; Offset += BlockSize) {
+            if (Input.IsSet()) {
+                FMemory::Memcpy(Input.GetValue()->GetData(), Signal.GetData() + Offset, BlockSize * sizeof(float));
+            }
+            OnBlock(Offset);
+            Harness.Render(1);
+            Rendered.Append(Output->GetData(), BlockSize);
+        }
+        return Rendered;
+    }
+
+    /**
+     * Renders with every block size and compares against the smallest one.
+     *
+     * @param NumFrames Frames to render, a multiple of every block size.
+     * @param OnBlock Called with the first frame of every block before it is rendered, to change inputs.
+     */
+    void TestBlockSizes(
+        FAutomationTestBase& Test,
+        const FString& What,
+        const Metasound::INode& Node,
+        TFunctionRef<void(FOperatorTestHarness&)> SetInputs,
+        const bool bHasAudioInput,
+        const Metasound::FVertexName& OutputName = TEXT("Out"),
+        const int32 NumFrames = NumTotalFrames,
+        TFunctionRef<void(int32)> OnBlock = [](int32) {}
+    ) {
+        const TArray<float> Reference = RenderWithBlockSize(Node, BlockSizes[0], SetInputs, bHasAudioInput, OutputName, NumFrames, OnBlock);
+        if (!Test.TestEqual(What + TEXT(" should render all frames"), Reference.Num(), NumFrames)) return;
+
+        for (int32 Size = 1; Size < UE_ARRAY_COUNT(BlockSizes); ++Size) {
+            const TArray<float> Rendered = RenderWithBlockSize(Node, BlockSizes[Size], SetInputs, bHasAudioInput, OutputName, NumFrames, OnBlock);
+            const FString WhatSize = FString::Printf(TEXT("%s with %d frames per block"), *What, BlockSizes[Size]);
+            if (!Test.TestEqual(WhatSize + TEXT(" should render all frames"), Rendered.Num(), NumFrames)) continue;
+            Test.TestTrue(
+                WhatSize + TEXT(" should be bit identical"),
+                FMemory::Memcmp(Reference.GetData(), Rendered.GetData(), NumFrames * sizeof(float)) == 0);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBlockSizeVolumeTest,
+    "prototype.BachelorAudio.BachelorMetasound.BlockSize.000_VolumeTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FBlockSizeVolumeTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FVolumeNode Node({ TEXT("VolumeBlockSize"), FGuid::NewGuid() });
+    TestBlockSizes(*this, TEXT("Volume"), Node, [](FOperatorTestHarness& Harness) {
+        Harness.SetInput<float>(TEXT("Amplitude"), 0.5f);
+    }, true);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBlockSizeNotchFilterTest,
+    "prototype.BachelorAudio.BachelorMetasound.BlockSize.005_NotchFilterTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FBlockSizeNotchFilterTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNotchFilterNode Node({ TEXT("NotchFilterBlockSize"), FGuid::NewGuid() });
+    TestBlockSizes(*this, TEXT("Notch filter"), Node, [](FOperatorTestHarness& Harness) {
+        Harness.SetInput<float>(TEXT("Frequency"), Harness.GetOperatorSettings().GetSampleRate());
+        Harness.SetInput<float>(TEXT("Cutoff"), 440.f);
+        Harness.SetInput<float>(TEXT("Bandwidth"), 0.9f);
+    }, true);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBlockSizeAdvancedNoiseTest,
+    "prototype.BachelorAudio.BachelorMetasound.BlockSize.010_AdvancedNoiseTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FBlockSizeAdvancedNoiseTest::RunTest(const FString& Parameters) {
+    const Metasound::FAdvancedNoiseNode Node({ TEXT("AdvancedNoiseBlockSize"), FGuid::NewGuid() });
+    constexpr Metasound::EAdvancedNoiseType NoiseTypes[] = {
+        Metasound::EAdvancedNoiseType::Pink,
+        Metasound::EAdvancedNoiseType::White,
+        Metasound::EAdvancedNoiseType::Brown,
+        Metasound::EAdvancedNoiseType::Green
+    };
+
+    for (const Metasound::EAdvancedNoiseType Type : NoiseTypes) {
+        for (int32 Variant = 0; Variant < 3; ++Variant) {
+            const FString What = FString::Printf(TEXT("Advanced noise type %d, variant %d"), static_cast<int32>(Type), Variant);
+            TestBlockSizes(*this, What, Node, [Type, Variant](FOperatorTestHarness& Harness) {
+                Harness.SetInput<int32>(TEXT("Seed"), 1234);
+                Harness.SetInput<Metasound::FEnumAdvancedNoiseType>(TEXT("Type"), Metasound::FEnumAdvancedNoiseType(Type));
+                Harness.SetInput<bool>(TEXT("Use Wavetable"), Variant == 1);
+                Harness.SetInput<bool>(TEXT("Runtime Type"), Variant == 2);
+                Harness.SetInput<float>(TEXT("Gain (db)"), 6.f);
+            }, false);
+        }
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBlockSizeAdvancedNoiseTypeChangeTest,
+    "prototype.BachelorAudio.BachelorMetasound.BlockSize.012_AdvancedNoiseTypeChangeTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FBlockSizeAdvancedNoiseTypeChangeTest::RunTest(const FString& Parameters) {
+    const Metasound::FAdvancedNoiseNode Node({ TEXT("AdvancedNoiseTypeChangeBlockSize"), FGuid::NewGuid() });
+    constexpr Metasound::EAdvancedNoiseType FromTypes[] = {
+        Metasound::EAdvancedNoiseType::Pink,
+        Metasound::EAdvancedNoiseType::Brown
+    };
+    constexpr Metasound::EAdvancedNoiseType ToTypes[] = {
+        Metasound::EAdvancedNoiseType::Green,
+        Metasound::EAdvancedNoiseType::White
+    };
+
+    // The switch lands on a block boundary of every block size, the crossfade then spans blocks for the small ones
+    for (int32 Case = 0; Case < UE_ARRAY_COUNT(FromTypes); ++Case) {
+        TOptional<Metasound::TDataWriteReference<Metasound::FEnumAdvancedNoiseType>> Type;
+        const FString What = FString::Printf(
+            TEXT("Advanced noise switching type %d to %d"), static_cast<int32>(FromTypes[Case]), static_cast<int32>(ToTypes[Case]));
+        TestBlockSizes(*this, What, Node, [&Type, &FromTypes, Case](FOperatorTestHarness& Harness) {
+            Harness.SetInput<int32>(TEXT("Seed"), 1234);
+            Type = Harness.SetWritableInput<Metasound::FEnumAdvancedNoiseType>(
+                TEXT("Type"), Metasound::FEnumAdvancedNoiseType(FromTypes[Case]));
+            Harness.SetInput<bool>(TEXT("Runtime Type"), true);
+            Harness.SetInput<float>(TEXT("Gain (db)"), 6.f);
+            Harness.SetInput<float>(TEXT("Bandwidth"), 0.5f);
+        }, false, TEXT("Out"), MaxTotalFrames, [&Type, &ToTypes, Case](const int32 Offset) {
+            if (Offset == NumTotalFrames) *Type.GetValue() = Metasound::FEnumAdvancedNoiseType(ToTypes[Case]);
+        });
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBlockSizeNoiseBankTest,
+    "prototype.BachelorAudio.BachelorMetasound.BlockSize.015_NoiseBankTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FBlockSizeNoiseBankTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::TNoiseBankNode<2> Node({ TEXT("NoiseBankBlockSize"), FGuid::NewGuid() });
+    for (const TCHAR* OutputName : { TEXT("Out 0"), TEXT("Out 1") }) {
+        TestBlockSizes(*this, FString::Printf(TEXT("Noise bank %s"), OutputName), Node, [](FOperatorTestHarness& Harness) {
+            Harness.SetInput<int32>(TEXT("Seed"), 1234);
+        }, false, OutputName);
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FBlockSizeNoiseNotchVolumeTest,
+    "prototype.BachelorAudio.BachelorMetasound.BlockSize.020_NoiseNotchVolumeTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FBlockSizeNoiseNotchVolumeTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNoiseNotchVolumeNode Node({ TEXT("NoiseNotchVolumeBlockSize"), FGuid::NewGuid() });
+    TestBlockSizes(*this, TEXT("Noise notch volume"), Node, [](FOperatorTestHarness& Harness) {
+        Harness.SetInput<int32>(TEXT("Seed"), 1234);
+        Harness.SetInput<float>(TEXT("Gain (db)"), 6.f);
+        Harness.SetInput<float>(TEXT("Notch Frequency"), Harness.GetOperatorSettings().GetSampleRate());
+        Harness.SetInput<float>(TEXT("Notch Cutoff"), 440.f);
+        Harness.SetInput<float>(TEXT("Notch Bandwidth"), 0.9f);
+        Harness.SetInput<float>(TEXT("Amplitude"), 0.5f);
+    }, false);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,114 @@
+﻿/**
+ * @file NoiseBank.Test.cpp
+ * @brief Tests that a lane of the noise bank sounds like the single AdvancedNoise node it replaces.
+ */
+
+#include "DSP/NoiseBank.h"
+#include "AdvancedNoiseNode.h"
+#include "Test/OperatorTestHarness.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorMetasound::Test;
+
+namespace {
+
+    /** Noise types covered by the tests. */
+    constexpr Metasound::EAdvancedNoiseType NoiseTypes[] = {
+        Metasound::EAdvancedNoiseType::Pink,
+        Metasound::EAdvancedNoiseType::White,
+        Metasound::EAdvancedNoiseType::Brown,
+        Metasound::EAdvancedNoiseType::Green
+    };
+
+    /** Blocks rendered per measurement, about four seconds at the default block size. */
+    constexpr int32 NumTestBlocks = 750;
+
+    /** Lanes of the tested bank, the compared lane runs alongside the others. */
+    constexpr int32 NumTestLanes = 4;
+
+    /**
+     * @struct FNoiseStats
+     * @brief Level and spectral tilt of a noise signal.
+     */
+    struct FNoiseStats {
+        /** Root mean square of the signal. */
+        float Rms = 0.f;
+
+        /** Correlation of neighboring samples, near 0 for white and near 1 for brown noise. */
+        float Correlation = 0.f;
+    };
+
+    FNoiseStats GetNoiseStats(const TArray<float>& Samples) {
+        double Energy = 0.0;
+        double Lagged = 0.0;
+        for (int32 Index = 0; Index < Samples.Num(); ++Index) {
+            Energy += static_cast<double>(Samples[Index]) * Samples[Index];
+            if (Index > 0) Lagged += static_cast<double>(Samples[Index]) * Samples[Index - 1];
+        }
+        FNoiseStats Stats;
+        if (Samples.Num() == 0 || Energy <= 0.0) return Stats;
+        Stats.Rms = static_cast<float>(FMath::Sqrt(Energy / Samples.Num()));
+        Stats.Correlation = static_cast<float>(Lagged / Energy);
+        return Stats;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FNoiseBankColorTest,
+    "prototype.BachelorAudio.BachelorMetasound.NoiseBank.000_ColorTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FNoiseBankColorTest::RunTest(const FString& Parameters) {
+    const Metasound::FAdvancedNoiseNode Node({ TEXT("NoiseBankReference"), FGuid::NewGuid() });
+
+    for (const Metasound::EAdvancedNoiseType Type : NoiseTypes) {
+        const FString What = FString::Printf(TEXT("Type %d"), static_cast<int32>(Type));
+
+        FOperatorTestHarness Harness(Node);
+        Harness.SetInput<int32>(TEXT("Seed"), 1234);
+        Harness.SetInput<Metasound::FEnumAdvancedNoiseType>(TEXT("Type"), Metasound::FEnumAdvancedNoiseType(Type));
+        if (!TestTrue(What + TEXT(" node should be created"), Harness.Build())) continue;
+        const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+        if (!TestNotNull(What + TEXT(" node should have an output"), Output)) continue;
+
+        const int32 NumFramesPerBlock = Harness.GetOperatorSettings().GetNumFramesPerBlock();
+        BachelorDSP::TNoiseBank<NumTestLanes> Bank(Harness.GetOperatorSettings().GetSampleRate(), 1234);
+        TArray<float> LaneBuffers[NumTestLanes];
+        float* LaneData[NumTestLanes];
+        for (int32 Lane = 0; Lane < NumTestLanes; ++Lane) {
+            LaneBuffers[Lane].SetNumZeroed(NumFramesPerBlock);
+            LaneData[Lane] = LaneBuffers[Lane].GetData();
+        }
+
+        TArray<float> NodeSamples;
+        TArray<float> LaneSamples;
+        for (int32 Block = 0; Block < NumTestBlocks; ++Block) {
+            Harness.Render(1);
+            NodeSamples.Append(Output->GetData(), Output->Num());
+            Bank.Generate(Metasound::GetNoiseColor(Type), LaneData, NumFramesPerBlock);
+            LaneSamples.Append(LaneBuffers[1]);
+        }
+
+        // The random streams differ, so the lane can only match the node statistically.
+        const FNoiseStats NodeStats = GetNoiseStats(NodeSamples);
+        const FNoiseStats LaneStats = GetNoiseStats(LaneSamples);
+        TestTrue(What + TEXT(" node should render noise"), NodeStats.Rms > 1.e-3f);
+        TestTrue(
+            What + TEXT(" lane should have the level of the node"),
+            FMath::IsNearlyEqual(LaneStats.Rms, NodeStats.Rms, 0.15f * NodeStats.Rms));
+        TestTrue(
+            What + TEXT(" lane should have the spectral tilt of the node"),
+            FMath::IsNearlyEqual(LaneStats.Correlation, NodeStats.Correlation, 0.05f));
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,134 @@
+﻿/**
+ * @file NoiseNotchVolumeNode.Test.cpp
+ * @brief Equivalence and benchmark tests for the fused noise, notch filter and volume node.
+ */
+
+#include "NoiseNotchVolumeNode.h"
+#include "AdvancedNoiseNode.h"
+#include "NotchFilterNode.h"
+#include "VolumeNode.h"
+#include "Test/OperatorTestHarness.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorMetasound::Test;
+
+namespace {
+
+    /** Noise types covered by the tests. */
+    constexpr Metasound::EAdvancedNoiseType NoiseTypes[] = {
+        Metasound::EAdvancedNoiseType::Pink,
+        Metasound::EAdvancedNoiseType::White,
+        Metasound::EAdvancedNoiseType::Brown,
+        Metasound::EAdvancedNoiseType::Green
+    };
+
+    constexpr int32 Seed = 1234;
+    constexpr float ShapingGain = 6.f;
+    constexpr float NotchCutoff = 440.f;
+    constexpr float NotchBandwidth = 0.9f;
+    constexpr float Amplitude = 0.5f;
+
+    /** Binds the same parameters the chain of single nodes gets. */
+    void SetFusedInputs(FOperatorTestHarness& Harness, const Metasound::EAdvancedNoiseType Type) {
+        Harness.SetInput<int32>(TEXT("Seed"), Seed);
+        Harness.SetInput<Metasound::FEnumAdvancedNoiseType>(TEXT("Type"), Metasound::FEnumAdvancedNoiseType(Type));
+        Harness.SetInput<float>(TEXT("Gain (db)"), ShapingGain);
+        Harness.SetInput<float>(TEXT("Notch Frequency"), Harness.GetOperatorSettings().GetSampleRate());
+        Harness.SetInput<float>(TEXT("Notch Cutoff"), NotchCutoff);
+        Harness.SetInput<float>(TEXT("Notch Bandwidth"), NotchBandwidth);
+        Harness.SetInput<float>(TEXT("Amplitude"), Amplitude);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FNoiseNotchVolumeNodeEquivalenceTest,
+    "prototype.BachelorAudio.BachelorMetasound.NoiseNotchVolumeNode.000_EquivalenceTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FNoiseNotchVolumeNodeEquivalenceTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNoiseNotchVolumeNode FusedNode({ TEXT("NoiseNotchVolumeTest"), FGuid::NewGuid() });
+    const Metasound::FAdvancedNoiseNode NoiseNode({ TEXT("NoiseTest"), FGuid::NewGuid() });
+    const BachelorMetasound::FNotchFilterNode NotchNode({ TEXT("NotchFilterTest"), FGuid::NewGuid() });
+    const BachelorMetasound::FVolumeNode VolumeNode({ TEXT("VolumeTest"), FGuid::NewGuid() });
+
+    for (const Metasound::EAdvancedNoiseType Type : NoiseTypes) {
+        const FString What = FString::Printf(TEXT("Type %d"), static_cast<int32>(Type));
+
+        FOperatorTestHarness Fused(FusedNode);
+        SetFusedInputs(Fused, Type);
+
+        FOperatorTestHarness Noise(NoiseNode);
+        Noise.SetInput<int32>(TEXT("Seed"), Seed);
+        Noise.SetInput<Metasound::FEnumAdvancedNoiseType>(TEXT("Type"), Metasound::FEnumAdvancedNoiseType(Type));
+        Noise.SetInput<float>(TEXT("Gain (db)"), ShapingGain);
+
+        FOperatorTestHarness Notch(NotchNode);
+        const Metasound::FAudioBufferWriteRef NotchInput = Notch.SetAudioInput(TEXT("In"));
+        Notch.SetInput<float>(TEXT("Frequency"), Notch.GetOperatorSettings().GetSampleRate());
+        Notch.SetInput<float>(TEXT("Cutoff"), NotchCutoff);
+        Notch.SetInput<float>(TEXT("Bandwidth"), NotchBandwidth);
+
+        FOperatorTestHarness Volume(VolumeNode);
+        const Metasound::FAudioBufferWriteRef VolumeInput = Volume.SetAudioInput(TEXT("In"));
+        Volume.SetInput<float>(TEXT("Amplitude"), Amplitude);
+
+        if (!TestTrue(What + TEXT(" fused operator should be created"), Fused.Build())) continue;
+        if (!TestTrue(What + TEXT(" chain should be created"), Noise.Build() && Notch.Build() && Volume.Build())) continue;
+
+        const Metasound::FAudioBuffer* FusedOutput = Fused.GetAudioOutput(TEXT("Out"));
+        const Metasound::FAudioBuffer* NoiseOutput = Noise.GetAudioOutput(TEXT("Out"));
+        const Metasound::FAudioBuffer* NotchOutput = Notch.GetAudioOutput(TEXT("Out"));
+        const Metasound::FAudioBuffer* VolumeOutput = Volume.GetAudioOutput(TEXT("Out"));
+        if (!TestTrue(What + TEXT(" should bind all outputs"),
+            FusedOutput && NoiseOutput && NotchOutput && VolumeOutput)) continue;
+
+        // Same kernels in the same order, so the fused output has to be bit identical to the chain.
+        for (int32 Block = 0; Block < 16; ++Block) {
+            Noise.Render(1);
+            FMemory::Memcpy(NotchInput->GetData(), NoiseOutput->GetData(), NoiseOutput->Num() * sizeof(float));
+            Notch.Render(1);
+            FMemory::Memcpy(VolumeInput->GetData(), NotchOutput->GetData(), NotchOutput->Num() * sizeof(float));
+            Volume.Render(1);
+            Fused.Render(1);
+
+            const bool bEqual = FMemory::Memcmp(
+                FusedOutput->GetData(), VolumeOutput->GetData(), FusedOutput->Num() * sizeof(float)) == 0;
+            if (!TestTrue(FString::Printf(TEXT("%s block %d should match the chain"), *What, Block), bEqual)) break;
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FNoiseNotchVolumeNodeBenchmarkTest,
+    "prototype.BachelorAudio.BachelorMetasound.NoiseNotchVolumeNode.005_BenchmarkTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FNoiseNotchVolumeNodeBenchmarkTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNoiseNotchVolumeNode Node({ TEXT("NoiseNotchVolumeBenchmark"), FGuid::NewGuid() });
+    FOperatorTestHarness Harness(Node);
+    SetFusedInputs(Harness, Metasound::EAdvancedNoiseType::Pink);
+
+    if (!TestTrue(TEXT("Noise notch volume operator should be created"), Harness.Build())) return false;
+
+    const FOperatorBenchmarkResult Result = Harness.Benchmark(4096);
+    AddInfo(FString::Printf(TEXT("NoiseNotchVolume: %s"), *Result.ToString()));
+
+    TestEqual(TEXT("Noise notch volume operator should not allocate while rendering"), Result.AllocationsPerBlock, 0.0);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -0,0 +1,192 @@
+﻿/**
+ * @file NotchFilterNode.Test.cpp
+ * @brief Headless render and benchmark tests for the notch filter node.
+ */
+
+#include "NotchFilterNode.h"
+#include "Test/OperatorTestHarness.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorMetasound::Test;
+
+namespace {
+
+    /** Frequency of the test tone in Hz. */
+    constexpr float ToneFrequency = 440.f;
+
+    /** Blocks rendered before measuring, so the filter and its parameter smoothing settle. */
+    constexpr int32 NumSettleBlocks = 32;
+
+    /** Blocks measured after settling. */
+    constexpr int32 NumMeasureBlocks = 32;
+
+    /**
+     * Renders a continuous sine of ToneFrequency through a notch filter with the given cutoff.
+     *
+     * @return RMS of the output divided by RMS of the input after settling, negative if the operator was not built.
+     */
+    float GetToneGain(const Metasound::INode& Node, const float Cutoff) {
+        FOperatorTestHarness Harness(Node);
+        const Metasound::FAudioBufferWriteRef Input = Harness.SetAudioInput(TEXT("In"));
+        Harness.SetInput<float>(TEXT("Frequency"), Harness.GetOperatorSettings().GetSampleRate());
+        Harness.SetInput<float>(TEXT("Cutoff"), Cutoff);
+        Harness.SetInput<float>(TEXT("Bandwidth"), 0.9f);
+        if (!Harness.Build()) return -1.f;
+        const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+        if (Output == nullptr) return -1.f;
+
+        const double Increment = 2.0 * PI * ToneFrequency / Harness.GetOperatorSettings().GetSampleRate();
+        double InputEnergy = 0.0;
+        double OutputEnergy = 0.0;
+        for (int32 Block = 0; Block < NumSettleBlocks + NumMeasureBlocks; ++Block) {
+            // Refilled every block, so the tone continues without a phase jump at the block borders
+            float* InputData = Input->GetData();
+            for (int32 Index = 0; Index < Input->Num(); ++Index) {
+                InputData[Index] = 0.5f * static_cast<float>(FMath::Sin(Increment * (Block * Input->Num() + Index)));
+            }
+            Harness.Render(1);
+            if (Block < NumSettleBlocks) continue;
+            for (int32 Index = 0; Index < Output->Num(); ++Index) {
+                InputEnergy += static_cast<double>(InputData[Index]) * InputData[Index];
+                OutputEnergy += static_cast<double>(Output->GetData()[Index]) * Output->GetData()[Index];
+            }
+        }
+        return static_cast<float>(FMath::Sqrt(OutputEnergy / InputEnergy));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FNotchFilterNodeRenderTest,
+    "prototype.BachelorAudio.BachelorMetasound.NotchFilterNode.000_RenderTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FNotchFilterNodeRenderTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNotchFilterNode Node({ TEXT("NotchFilterTest"), FGuid::NewGuid() });
+    FOperatorTestHarness Harness(Node);
+
+    Harness.SetAudioInput(TEXT("In"));
+    Harness.SetInput<float>(TEXT("Frequency"), Harness.GetOperatorSettings().GetSampleRate());
+    Harness.SetInput<float>(TEXT("Cutoff"), 440.f);
+    Harness.SetInput<float>(TEXT("Bandwidth"), 0.9f);
+
+    if (!TestTrue(TEXT("Notch filter operator should be created"), Harness.Build())) return false;
+    Harness.Render(64);
+
+    const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+    if (!TestNotNull(TEXT("Notch filter operator should bind its output"), Output)) return false;
+
+    for (int32 Index = 0; Index < Output->Num(); ++Index) {
+        if (!TestTrue(TEXT("Output should stay finite"), FMath::IsFinite(Output->GetData()[Index]))) break;
+    }
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FNotchFilterNodeBenchmarkTest,
+    "prototype.BachelorAudio.BachelorMetasound.NotchFilterNode.005_BenchmarkTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FNotchFilterNodeBenchmarkTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNotchFilterNode Node({ TEXT("NotchFilterBenchmark"), FGuid::NewGuid() });
+    FOperatorTestHarness Harness(Node);
+    Harness.SetAudioInput(TEXT("In"));
+    Harness.SetInput<float>(TEXT("Frequency"), Harness.GetOperatorSettings().GetSampleRate());
+    Harness.SetInput<float>(TEXT("Cutoff"), 440.f);
+    Harness.SetInput<float>(TEXT("Bandwidth"), 0.9f);
+
+    if (!TestTrue(TEXT("Notch filter operator should be created"), Harness.Build())) return false;
+
+    const FOperatorBenchmarkResult Result = Harness.Benchmark(4096);
+    AddInfo(FString::Printf(TEXT("NotchFilter: %s"), *Result.ToString()));
+    
+    TestEqual(TEXT("Notch filter operator should not allocate while rendering"), Result.AllocationsPerBlock, 0.0);
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FNotchFilterNodeToneTest,
+    "prototype.BachelorAudio.BachelorMetasound.NotchFilterNode.010_ToneTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FNotchFilterNodeToneTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNotchFilterNode Node({ TEXT("NotchFilterTone"), FGuid::NewGuid() });
+
+    const float NotchedGain = GetToneGain(Node, ToneFrequency);
+    if (!TestTrue(TEXT("Notch filter operator should be created"), NotchedGain >= 0.f)) return false;
+    AddInfo(FString::Printf(TEXT("Tone gain at the notch: %.4f"), NotchedGain));
+    TestTrue(TEXT("A tone at the cutoff should be attenuated by more than 26 dB"), NotchedGain < 0.05f);
+
+    const float PassedGain = GetToneGain(Node, 8000.f);
+    AddInfo(FString::Printf(TEXT("Tone gain away from the notch: %.4f"), PassedGain));
+    TestTrue(TEXT("A tone far from the cutoff should pass within 1 dB"), FMath::Abs(PassedGain - 1.f) < 0.11f);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FNotchFilterNodeSilenceTest,
+    "prototype.BachelorAudio.BachelorMetasound.NotchFilterNode.015_SilenceTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FNotchFilterNodeSilenceTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FNotchFilterNode Node({ TEXT("NotchFilterSilence"), FGuid::NewGuid() });
+
+    // Bandwidth stays unconnected, its default of 0 is constant and rejected by the filter.
+    FOperatorTestHarness Harness(Node);
+    const Metasound::FAudioBufferWriteRef Input = Harness.SetAudioInput(TEXT("In"));
+    Harness.SetInput<float>(TEXT("Frequency"), Harness.GetOperatorSettings().GetSampleRate());
+    Harness.SetInput<float>(TEXT("Cutoff"), 440.f);
+    if (!TestTrue(TEXT("Silence operator should be created"), Harness.Build())) return false;
+    const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+    if (!TestNotNull(TEXT("Silence operator should bind its output"), Output)) return false;
+
+    Input->Zero();
+    const FOperatorBenchmarkResult Result = Harness.Benchmark(256);
+    TestEqual(TEXT("Silence operator should not allocate while rendering"), Result.AllocationsPerBlock, 0.0);
+    bool bIsSilent = true;
+    for (int32 Index = 0; Index < Output->Num(); ++Index) bIsSilent &= Output->GetData()[Index] == 0.f;
+    TestTrue(TEXT("Silent input should render silence"), bIsSilent);
+
+    // The same rejected Bandwidth through a connected pin builds the filtering operator, both have to agree.
+    FOperatorTestHarness Reference(Node);
+    const Metasound::FAudioBufferWriteRef ReferenceInput = Reference.SetAudioInput(TEXT("In"));
+    Reference.SetInput<float>(TEXT("Frequency"), Reference.GetOperatorSettings().GetSampleRate());
+    Reference.SetInput<float>(TEXT("Cutoff"), 440.f);
+    Reference.SetInput<float>(TEXT("Bandwidth"), 0.f);
+    if (!TestTrue(TEXT("Filtering operator should be created"), Reference.Build())) return false;
+    const Metasound::FAudioBuffer* ReferenceOutput = Reference.GetAudioOutput(TEXT("Out"));
+    if (!TestNotNull(TEXT("Filtering operator should bind its output"), ReferenceOutput)) return false;
+
+    // A non-silent input after the silent blocks
+    FMemory::Memcpy(Input->GetData(), ReferenceInput->GetData(), Input->Num() * sizeof(float));
+    bool bMatches = true;
+    for (int32 Block = 0; Block < 8; ++Block) {
+        Harness.Render(1);
+        Reference.Render(1);
+        for (int32 Index = 0; Index < Output->Num(); ++Index) {
+            bMatches &= Output->GetData()[Index] == ReferenceOutput->GetData()[Index];
+        }
+    }
+    TestTrue(TEXT("Non-silent input should render like the filter with the same parameters"), bMatches);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
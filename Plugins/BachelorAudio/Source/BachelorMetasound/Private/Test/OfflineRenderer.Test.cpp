@@ -0,0 +1,90 @@
+﻿/**
+ * @file OfflineRenderer.Test.cpp
+ * @brief Tests of the parallel offline renderer.
+ */
+
+#include "OfflineRenderer.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace {
+
+    /** Noise jobs with every processor type, written below the given directory. */
+    TArray<BachelorMetasound::FOfflineRenderJob> MakeJobs(const FString& Directory) {
+        TArray<BachelorMetasound::FOfflineRenderJob> Jobs;
+        for (int32 Index = 0; Index < 8; ++Index) {
+            BachelorMetasound::FOfflineRenderJob& Job = Jobs.AddDefaulted_GetRef();
+            Job.NoiseColor = static_cast<BachelorDSP::ENoiseColor>(Index % static_cast<int32>(BachelorDSP::ENoiseColor::Num));
+            Job.Seed = Index + 1;
+            Job.NumFrames = 48000 + Index * 1000;
+            Job.OutputPath = FPaths::Combine(Directory, FString::Printf(TEXT("Job_%d.wav"), Index));
+            Job.Chain.Add({ BachelorDSP::EDSPType::PeakingFilter, { 2000.f, 0.707f, 6.f } });
+            Job.Chain.Add({ BachelorDSP::EDSPType::NotchFilter, { 440.f + Index * 100.f, 0.9f } });
+            Job.Chain.Add({ BachelorDSP::EDSPType::Volume, { 0.5f } });
+        }
+        return Jobs;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FOfflineRendererRenderTest,
+    "prototype.BachelorAudio.BachelorMetasound.OfflineRenderer.000_RenderTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FOfflineRendererRenderTest::RunTest(const FString& Parameters) {
+    const FString Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("OfflineRenderer"));
+    const TArray<BachelorMetasound::FOfflineRenderJob> ParallelJobs = MakeJobs(FPaths::Combine(Directory, TEXT("Parallel")));
+    const TArray<BachelorMetasound::FOfflineRenderJob> SerialJobs = MakeJobs(FPaths::Combine(Directory, TEXT("Serial")));
+
+    const TArray<BachelorMetasound::FOfflineRenderResult> ParallelResults = BachelorMetasound::FOfflineRenderer::Render(ParallelJobs);
+    const TArray<BachelorMetasound::FOfflineRenderResult> SerialResults = BachelorMetasound::FOfflineRenderer::Render(SerialJobs, true);
+
+    for (int32 Index = 0; Index < ParallelJobs.Num(); ++Index) {
+        const FString What = FString::Printf(TEXT("Job %d"), Index);
+        if (!TestTrue(What + TEXT(" should render in parallel"), ParallelResults[Index].bSucceeded)) continue;
+        if (!TestTrue(What + TEXT(" should render single threaded"), SerialResults[Index].bSucceeded)) continue;
+        TestEqual(What + TEXT(" should render all frames"), ParallelResults[Index].NumFrames, ParallelJobs[Index].NumFrames);
+
+        // Jobs are independent, the number of workers must not change a single byte.
+        TArray<uint8> ParallelBytes;
+        TArray<uint8> SerialBytes;
+        FFileHelper::LoadFileToArray(ParallelBytes, *ParallelJobs[Index].OutputPath);
+        FFileHelper::LoadFileToArray(SerialBytes, *SerialJobs[Index].OutputPath);
+        TestTrue(What + TEXT(" should write a file"), ParallelBytes.Num() > ParallelJobs[Index].NumFrames);
+        TestTrue(What + TEXT(" should not depend on the number of workers"), ParallelBytes == SerialBytes);
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FOfflineRendererInvalidJobTest,
+    "prototype.BachelorAudio.BachelorMetasound.OfflineRenderer.005_InvalidJobTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FOfflineRendererInvalidJobTest::RunTest(const FString& Parameters) {
+    TArray<BachelorMetasound::FOfflineRenderJob> Jobs;
+    Jobs.AddDefaulted_GetRef().InputPath = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("DoesNotExist.wav"));
+    Jobs.AddDefaulted();
+
+    const TArray<BachelorMetasound::FOfflineRenderResult> Results = BachelorMetasound::FOfflineRenderer::Render(Jobs);
+    TestFalse(TEXT("Missing input file should fail"), Results[0].bSucceeded);
+    TestFalse(TEXT("Generated input without frames should fail"), Results[1].bSucceeded);
+    TestFalse(TEXT("Failures should report an error"), Results[0].Error.IsEmpty() || Results[1].Error.IsEmpty());
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
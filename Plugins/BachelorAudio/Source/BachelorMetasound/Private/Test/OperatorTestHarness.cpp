@@ -0,0 +1,225 @@
+﻿/**
+ * @file OperatorTestHarness.cpp
+ * @brief Headless render and benchmark harness for BachelorMetasound operators.
+ */
+
+#include "Test/OperatorTestHarness.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include <atomic>
+#include "MetasoundOperatorBuilder.h"
+
+namespace BachelorMetasound::Test {
+
+	/**
+	 * @class FCountingMalloc
+	 * @brief Forwards to the original allocator and counts allocations of one thread.
+	 *
+	 * Only sits in front of GMalloc while a FScopedCountingMalloc is alive, the original allocator is
+	 * restored afterward. The proxy itself is never destroyed, so a thread that loaded the proxy pointer
+	 * just before it was removed can still call into it and reaches the original allocator.
+	 */
+	class FCountingMalloc final : public FMalloc {
+	public:
+		/** @return The proxy, not installed until BeginCounting(). */
+		static FCountingMalloc& Get() {
+			// Intentionally leaked, see the class comment
+			static FCountingMalloc* const Instance = new FCountingMalloc();
+			return *Instance;
+		}
+
+		/**
+		 * @brief Puts the proxy in front of GMalloc and counts the allocations of the given thread from now on.
+		 *
+		 * @param InThreadId Thread to count, one measurement at a time.
+		 */
+		void BeginCounting(const uint32 InThreadId) {
+			check(GMalloc != this);
+			Inner.store(GMalloc, std::memory_order_release);
+			NumAllocations.store(0, std::memory_order_relaxed);
+			CountedThreadId.store(InThreadId, std::memory_order_release);
+			FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), this);
+		}
+
+		/**
+		 * @brief Stops counting and restores the allocator that was installed before BeginCounting().
+		 *
+		 * @return Allocations of the counted thread since BeginCounting().
+		 */
+		int64 EndCounting() {
+			// Leaves GMalloc alone if something else was put in front of the proxy meanwhile
+			FPlatformAtomics::InterlockedCompareExchangePointer(
+				reinterpret_cast<void**>(&GMalloc), Inner.load(std::memory_order_acquire), this);
+			CountedThreadId.store(NoThreadId, std::memory_order_release);
+			return NumAllocations.load(std::memory_order_relaxed);
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override {
+			CountAllocation();
+			return GetInner()->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override {
+			CountAllocation();
+			return GetInner()->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override {
+			CountAllocation();
+			return GetInner()->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override {
+			CountAllocation();
+			return GetInner()->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { GetInner()->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return GetInner()->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return GetInner()->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { GetInner()->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { GetInner()->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { GetInner()->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return GetInner()->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return GetInner()->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return GetInner()->GetDescriptiveName(); }
+
+	private:
+		/** Thread id meaning no thread is counted, never handed out by the platform. */
+		static constexpr uint32 NoThreadId = 0;
+
+		FCountingMalloc() = default;
+
+		FORCEINLINE FMalloc* GetInner() const { return Inner.load(std::memory_order_acquire); }
+
+		FORCEINLINE void CountAllocation() {
+			const uint32 ThreadId = CountedThreadId.load(std::memory_order_acquire);
+			if (ThreadId != NoThreadId && FPlatformTLS::GetCurrentThreadId() == ThreadId) {
+				NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		/** Allocator that was installed before the proxy, every call is forwarded to it. */
+		std::atomic<FMalloc*> Inner{nullptr};
+		std::atomic<uint32> CountedThreadId{NoThreadId};
+		std::atomic<int64> NumAllocations{0};
+	};
+
+	/**
+	 * @class FScopedCountingMalloc
+	 * @brief Counts the allocations of the calling thread while in scope.
+	 *
+	 * GMalloc is restored when the scope ends, so tests other than the benchmark never run on the proxy.
+	 */
+	class FScopedCountingMalloc {
+	public:
+		/** @param OutNumAllocations Receives the allocations of the scope when it ends. */
+		explicit FScopedCountingMalloc(int64& OutNumAllocations) : NumAllocations(OutNumAllocations) {
+			FCountingMalloc::Get().BeginCounting(FPlatformTLS::GetCurrentThreadId());
+		}
+
+		~FScopedCountingMalloc() {
+			NumAllocations = FCountingMalloc::Get().EndCounting();
+		}
+
+		FScopedCountingMalloc(const FScopedCountingMalloc&) = delete;
+		FScopedCountingMalloc& operator=(const FScopedCountingMalloc&) = delete;
+
+	private:
+		int64& NumAllocations;
+	};
+
+	FString FOperatorBenchmarkResult::ToString() const {
+		return FString::Printf(
+			TEXT("%d blocks of %d frames: %.2f ns/sample, %.2f allocations/block"),
+			NumBlocks, NumFramesPerBlock, NanosecondsPerSample, AllocationsPerBlock);
+	}
+
+	FOperatorTestHarness::FOperatorTestHarness(
+		const Metasound::INode& InNode,
+		const float InSampleRate,
+		const int32 InNumFramesPerBlock
+	) : Node(InNode),
+		OperatorSettings(InSampleRate, InSampleRate / InNumFramesPerBlock),
+		InputData(InNode.GetVertexInterface().GetInputInterface()),
+		OutputData(InNode.GetVertexInterface().GetOutputInterface()) {}
+
+	Metasound::FAudioBufferWriteRef FOperatorTestHarness::SetAudioInput(const Metasound::FVertexName& InName, const int32 InSeed) {
+		Metasound::FAudioBufferWriteRef Buffer = Metasound::FAudioBufferWriteRef::CreateNew(OperatorSettings);
+
+		// Sine with some noise, so filters and gains see a broadband but reproducible signal.
+		FRandomStream Random(InSeed);
+		const float Increment = 2.f * PI * 440.f / OperatorSettings.GetSampleRate();
+		float* Data = Buffer->GetData();
+		for (int32 Index = 0; Index < Buffer->Num(); ++Index) {
+			Data[Index] = 0.5f * FMath::Sin(Increment * Index) + 0.25f * Random.FRandRange(-1.f, 1.f);
+		}
+
+		InputData.BindReadVertex(InName, Metasound::FAudioBufferReadRef(Buffer));
+		return Buffer;
+	}
+
+	bool FOperatorTestHarness::Build() {
+		BuildResults = Metasound::FBuildResults();
+		Operator.Reset();
+		ExecuteFunction = nullptr;
+
+		const Metasound::FOperatorBuilder Builder(Metasound::FOperatorBuilderSettings::GetDefaultSettings());
+		const Metasound::FBuildOperatorParams Params {
+			Node,
+			OperatorSettings,
+			InputData,
+			Environment,
+			Builder
+		};
+
+		Operator = Node.GetDefaultOperatorFactory()->CreateOperator(Params, BuildResults);
+		if (!Operator.IsValid() || BuildResults.Errors.Num() > 0) return false;
+
+		Operator->BindOutputs(OutputData);
+		ExecuteFunction = Operator->GetExecuteFunction();
+		return true;
+	}
+
+	void FOperatorTestHarness::Render(const int32 InNumBlocks) {
+		if (!Operator.IsValid() || ExecuteFunction == nullptr) return;
+		for (int32 Block = 0; Block < InNumBlocks; ++Block) {
+			ExecuteFunction(Operator.Get());
+		}
+	}
+
+	FOperatorBenchmarkResult FOperatorTestHarness::Benchmark(const int32 InNumBlocks, const int32 InNumWarmupBlocks) {
+		FOperatorBenchmarkResult Result;
+		Result.NumFramesPerBlock = OperatorSettings.GetNumFramesPerBlock();
+		if (!Operator.IsValid() || InNumBlocks <= 0) return Result;
+
+		Render(InNumWarmupBlocks);
+
+		int64 NumAllocations = 0;
+		uint64 StartCycles = 0;
+		uint64 EndCycles = 0;
+		{
+			const FScopedCountingMalloc CountingMalloc(NumAllocations);
+			StartCycles = FPlatformTime::Cycles64();
+			Render(InNumBlocks);
+			EndCycles = FPlatformTime::Cycles64();
+		}
+
+		const double Seconds = FPlatformTime::ToSeconds64(EndCycles - StartCycles);
+		Result.NumBlocks = InNumBlocks;
+		Result.NanosecondsPerSample = Seconds * 1.0e9 / (static_cast<double>(InNumBlocks) * Result.NumFramesPerBlock);
+		Result.AllocationsPerBlock = static_cast<double>(NumAllocations) / InNumBlocks;
+		return Result;
+	}
+
+	const Metasound::FAudioBuffer* FOperatorTestHarness::GetAudioOutput(const Metasound::FVertexName& InName) const {
+		if (!Operator.IsValid()) return nullptr;
+		const Metasound::FAnyDataReference* Reference = OutputData.FindDataReference(InName);
+		if (Reference == nullptr) return nullptr;
+		return Reference->GetValue<Metasound::FAudioBuffer>();
+	}
+
+}
+
+#endif
@@ -0,0 +1,168 @@
+﻿/**
+ * @file OperatorTestHarness.h
+ * @brief Headless render and benchmark harness for BachelorMetasound operators.
+ *
+ * Builds an operator through the node's operator factory with synthetic build parameters, drives its
+ * execute function block by block and measures time and heap allocations. No audio device, world or
+ * editor is needed, so the tests run e.g. with
+ * UnrealEditor-Cmd prototype.uproject -nullrhi -nosound -unattended
+ * -ExecCmds="Automation RunTests prototype.BachelorAudio.BachelorMetasound; Quit"
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundBuilderInterface.h"
+#include "MetasoundDataReference.h"
+#include "MetasoundNodeInterface.h"
+#include "MetasoundOperatorInterface.h"
+#include "MetasoundVertexData.h"
+
+namespace BachelorMetasound::Test {
+
+	/**
+	 * @struct FOperatorBenchmarkResult
+	 * @brief Measurements of one benchmark run.
+	 */
+	struct FOperatorBenchmarkResult {
+		/** Number of executed blocks. */
+		int32 NumBlocks = 0;
+
+		/** Frames per executed block. */
+		int32 NumFramesPerBlock = 0;
+
+		/** Average render time per output frame in nanoseconds. */
+		double NanosecondsPerSample = 0.0;
+
+		/** Average number of heap allocations per block on the rendering thread. */
+		double AllocationsPerBlock = 0.0;
+
+		/** Formats the result for test logs. */
+		FString ToString() const;
+	};
+
+	/**
+	 * @class FOperatorTestHarness
+	 * @brief Builds one operator of a node and renders blocks with it.
+	 *
+	 * Inputs that are not set explicitly fall back to the defaults of the node's vertex interface,
+	 * exactly like an unconnected pin in a MetaSound graph.
+	 */
+	class FOperatorTestHarness {
+	public:
+		/**
+		 * @param InNode Node whose operator factory is used, must outlive the harness.
+		 * @param InSampleRate Sample rate of the synthetic operator settings.
+		 * @param InNumFramesPerBlock Block size of the synthetic operator settings.
+		 */
+		explicit FOperatorTestHarness(
+			const Metasound::INode& InNode,
+			const float InSampleRate = 48000.f,
+			const int32 InNumFramesPerBlock = 256
+		);
+
+		/**
+		 * @brief Binds a constant value to an input vertex.
+		 *
+		 * @param InName Vertex name as shown on the node pin.
+		 * @param InValue Value of the input.
+		 */
+		template<typename DataType>
+		void SetInput(const Metasound::FVertexName& InName, const DataType& InValue) {
+			InputData.BindReadVertex(
+				InName, Metasound::TDataReadReference<DataType>::CreateNew(InValue));
+		}
+
+		/**
+		 * @brief Binds a value to an input vertex that can change between blocks, like a connected pin.
+		 *
+		 * @param InName Vertex name as shown on the node pin.
+		 * @param InValue Initial value of the input.
+		 * @return Writable value, to change the input between blocks.
+		 */
+		template<typename DataType>
+		Metasound::TDataWriteReference<DataType> SetWritableInput(const Metasound::FVertexName& InName, const DataType& InValue) {
+			const Metasound::TDataWriteReference<DataType> Value = Metasound::TDataWriteReference<DataType>::CreateNew(InValue);
+			InputData.BindReadVertex(InName, Metasound::TDataReadReference<DataType>(Value));
+			return Value;
+		}
+
+		/**
+		 * @brief Binds an audio buffer to an input vertex, filled with a deterministic test signal.
+		 *
+		 * @param InName Vertex name as shown on the node pin.
+		 * @param InSeed Seed of the noise mixed into the test signal.
+		 * @return Writable buffer, to replace the test signal between blocks if needed.
+		 */
+		Metasound::FAudioBufferWriteRef SetAudioInput(const Metasound::FVertexName& InName, const int32 InSeed = 0);
+
+		/**
+		 * @brief Creates the operator through the node's default operator factory.
+		 *
+		 * @return True if an operator was created without build errors.
+		 */
+		bool Build();
+
+		/**
+		 * @brief Executes the operator for the given number of blocks.
+		 *
+		 * @param InNumBlocks Number of blocks to render.
+		 */
+		void Render(const int32 InNumBlocks);
+
+		/**
+		 * @brief Renders the given number of blocks and measures time and allocations.
+		 *
+		 * @param InNumBlocks Number of blocks to measure.
+		 * @param InNumWarmupBlocks Blocks rendered before measuring, first blocks may initialize lazily.
+		 * @return Measurements of the run.
+		 */
+		FOperatorBenchmarkResult Benchmark(const int32 InNumBlocks, const int32 InNumWarmupBlocks = 8);
+
+		/**
+		 * @brief Returns an audio output of the built operator.
+		 *
+		 * @param InName Vertex name of the output.
+		 * @return Output buffer, nullptr if not built or no such audio output exists.
+		 */
+		const Metasound::FAudioBuffer* GetAudioOutput(const Metasound::FVertexName& InName) const;
+
+		/** @return Settings the operator was built with. */
+		FORCEINLINE const Metasound::FOperatorSettings& GetOperatorSettings() const { return OperatorSettings; }
+
+		/** @return Build errors of the last Build() call. */
+		FORCEINLINE const Metasound::FBuildResults& GetBuildResults() const { return BuildResults; }
+
+	private:
+		/** Node providing the operator factory and vertex interface. */
+		const Metasound::INode& Node;
+
+		/** Synthetic settings, no audio device involved. */
+		Metasound::FOperatorSettings OperatorSettings;
+
+		/** Environment of the build, left empty like for a preview graph. */
+		Metasound::FMetasoundEnvironment Environment;
+
+		/** Inputs bound before Build(). */
+		Metasound::FInputVertexInterfaceData InputData;
+
+		/** Outputs bound by the operator after Build(). */
+		Metasound::FOutputVertexInterfaceData OutputData;
+
+		/** Errors reported by the operator factory. */
+		Metasound::FBuildResults BuildResults;
+
+		/** The operator under test. */
+		TUniquePtr<Metasound::IOperator> Operator;
+
+		/** Execute function of the operator, may be null for operators without work. */
+		Metasound::IOperator::FExecuteFunction ExecuteFunction = nullptr;
+	};
+
+}
+
+#endif
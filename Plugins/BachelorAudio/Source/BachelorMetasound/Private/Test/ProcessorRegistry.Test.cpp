@@ -0,0 +1,73 @@
+﻿/**
+ * @file ProcessorRegistry.Test.cpp
+ * @brief Tests of the processor registry and pool.
+ */
+
+#include "DSP/ProcessorRegistry.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FProcessorRegistryCreateTest,
+    "prototype.BachelorAudio.BachelorMetasound.ProcessorRegistry.000_CreateTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FProcessorRegistryCreateTest::RunTest(const FString& Parameters) {
+    BachelorDSP::FProcessorPool Pool;
+    for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(BachelorDSP::EDSPType::Num); ++TypeIndex) {
+        const BachelorDSP::EDSPType Type = static_cast<BachelorDSP::EDSPType>(TypeIndex);
+        const FString What = FString::Printf(TEXT("Type %d"), TypeIndex);
+
+        TestNotNull(What + TEXT(" should be registered"), BachelorDSP::FProcessorRegistry::Get().Find(Type));
+        const BachelorDSP::FProcessorPool::FProcessorPtr Processor = Pool.Acquire(Type);
+        if (!TestTrue(What + TEXT(" should be created"), Processor.IsValid())) continue;
+        TestEqual(What + TEXT(" should create its own type"), Processor->GetType(), Type);
+    }
+    TestFalse(TEXT("Num should not be creatable"), Pool.Acquire(BachelorDSP::EDSPType::Num).IsValid());
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FProcessorRegistryReuseTest,
+    "prototype.BachelorAudio.BachelorMetasound.ProcessorRegistry.005_ReuseTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FProcessorRegistryReuseTest::RunTest(const FString& Parameters) {
+    BachelorDSP::FProcessorPool Pool;
+    Pool.Reserve(BachelorDSP::EDSPType::NotchFilter, 4);
+    TestEqual(TEXT("Reserve should provide the requested processors"), Pool.GetNumFree(BachelorDSP::EDSPType::NotchFilter), 4);
+
+    TSet<const BachelorDSP::FProcessorBase*> FirstAddresses;
+    {
+        TArray<BachelorDSP::FProcessorPool::FProcessorPtr> Chain;
+        for (int32 Index = 0; Index < 4; ++Index) {
+            Chain.Add(Pool.Acquire(BachelorDSP::EDSPType::NotchFilter));
+            FirstAddresses.Add(Chain.Last().Get());
+        }
+        TestEqual(TEXT("Acquire should use the reserved memory"), Pool.GetNumFree(BachelorDSP::EDSPType::NotchFilter), 0);
+    }
+    TestEqual(TEXT("Released processors should return to the pool"), Pool.GetNumFree(BachelorDSP::EDSPType::NotchFilter), 4);
+
+    // A rebuilt chain of the same size lives in exactly the same memory.
+    TArray<BachelorDSP::FProcessorPool::FProcessorPtr> Chain;
+    for (int32 Index = 0; Index < 4; ++Index) {
+        Chain.Add(Pool.Acquire(BachelorDSP::EDSPType::NotchFilter));
+        TestTrue(TEXT("Acquire should reuse released memory"), FirstAddresses.Contains(Chain.Last().Get()));
+    }
+    TestEqual(TEXT("Other types should stay untouched"), Pool.GetNumFree(BachelorDSP::EDSPType::Volume), 0);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
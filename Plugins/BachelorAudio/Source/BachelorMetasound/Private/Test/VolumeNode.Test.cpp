@@ -0,0 +1,93 @@
+﻿/**
+ * @file VolumeNode.Test.cpp
+ * @brief Headless render and benchmark tests for the volume node.
+ */
+
+#include "VolumeNode.h"
+#include "Test/OperatorTestHarness.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+using namespace BachelorMetasound::Test;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FVolumeNodeRenderTest,
+    "prototype.BachelorAudio.BachelorMetasound.VolumeNode.000_RenderTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FVolumeNodeRenderTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FVolumeNode Node({ TEXT("VolumeTest"), FGuid::NewGuid() });
+    FOperatorTestHarness Harness(Node);
+
+    const Metasound::FAudioBufferWriteRef Input = Harness.SetAudioInput(TEXT("In"));
+    Harness.SetInput<float>(TEXT("Amplitude"), 0.5f);
+
+    if (!TestTrue(TEXT("Volume operator should be created"), Harness.Build())) return false;
+    Harness.Render(1);
+
+    const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+    if (!TestNotNull(TEXT("Volume operator should bind its output"), Output)) return false;
+
+    for (int32 Index = 0; Index < Output->Num(); ++Index) {
+        if (!TestEqual(TEXT("Output should be the scaled input"), Output->GetData()[Index], 0.5f * Input->GetData()[Index])) break;
+    }
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FVolumeNodeBenchmarkTest,
+    "prototype.BachelorAudio.BachelorMetasound.VolumeNode.005_BenchmarkTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FVolumeNodeBenchmarkTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FVolumeNode Node({ TEXT("VolumeBenchmark"), FGuid::NewGuid() });
+    FOperatorTestHarness Harness(Node);
+    Harness.SetAudioInput(TEXT("In"));
+    Harness.SetInput<float>(TEXT("Amplitude"), 0.5f);
+
+    if (!TestTrue(TEXT("Volume operator should be created"), Harness.Build())) return false;
+
+    const FOperatorBenchmarkResult Result = Harness.Benchmark(4096);
+    AddInfo(FString::Printf(TEXT("Volume: %s"), *Result.ToString()));
+    
+    TestEqual(TEXT("Volume operator should not allocate while rendering"), Result.AllocationsPerBlock, 0.0);
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FVolumeNodePassthroughTest,
+    "prototype.BachelorAudio.BachelorMetasound.VolumeNode.010_PassthroughTest",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::EngineFilter
+)
+
+bool FVolumeNodePassthroughTest::RunTest(const FString& Parameters) {
+    const BachelorMetasound::FVolumeNode Node({ TEXT("VolumePassthrough"), FGuid::NewGuid() });
+    FOperatorTestHarness Harness(Node);
+
+    // Amplitude stays unconnected, its default of 1 is constant at build time.
+    const Metasound::FAudioBufferWriteRef Input = Harness.SetAudioInput(TEXT("In"));
+
+    if (!TestTrue(TEXT("Volume operator should be created"), Harness.Build())) return false;
+    Harness.Render(1);
+
+    const Metasound::FAudioBuffer* Output = Harness.GetAudioOutput(TEXT("Out"));
+    TestEqual(TEXT("Output should alias the input buffer"), Output, static_cast<const Metasound::FAudioBuffer*>(&*Input));
+    
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -7,6 +7,8 @@
  */
 
 #include "VolumeNode.h"
+#include "NodeBuildHelpers.h"
+#include "NodeRenderStats.h"
 
 #define LOCTEXT_NAMESPACE "BluSumMetasound_VolumeNode"
 
@@ -17,6 +19,79 @@ namespace BachelorMetasound::VolumeNode {
 
 	// Output params
 	METASOUND_PARAM(OutParamNameAudio, "Out", "Audio output.")
+
+	/**
+	 * @class FVolumePassthroughOperator
+	 * @brief Volume operator for a constant amplitude of 1.
+	 * 
+	 * Binds the input buffer as output buffer, so neither a buffer nor a pass over it is needed.
+	 */
+	class FVolumePassthroughOperator final : public Metasound::IOperator {
+	public:
+		FVolumePassthroughOperator(
+			const Metasound::FAudioBufferReadRef& InAudioInput,
+			const Metasound::FFloatReadRef& InAmplitude
+		) : Amplitude(InAmplitude), AudioInput(InAudioInput) {}
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAmplitude), Amplitude);
+		}
+
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioInput);
+		}
+
+		virtual FExecuteFunction GetExecuteFunction() override { return nullptr; }
+		virtual FPostExecuteFunction GetPostExecuteFunction() override { return nullptr; }
+		// Owns no state and no buffer, nothing to reset.
+		virtual FResetFunction GetResetFunction() override { return nullptr; }
+
+	private:
+		Metasound::FFloatReadRef Amplitude;
+		Metasound::FAudioBufferReadRef AudioInput;
+	};
+
+	/**
+	 * @class FVolumeSilenceOperator
+	 * @brief Volume operator for a constant amplitude of 0.
+	 * 
+	 * Zeroes its output once and has no execute function.
+	 */
+	class FVolumeSilenceOperator final : public Metasound::IOperator {
+	public:
+		FVolumeSilenceOperator(
+			const Metasound::FOperatorSettings& InSettings,
+			const Metasound::FAudioBufferReadRef& InAudioInput,
+			const Metasound::FFloatReadRef& InAmplitude
+		) : Amplitude(InAmplitude),
+			AudioInput(InAudioInput),
+			AudioOutput(Metasound::FAudioBufferWriteRef::CreateNew(InSettings)) {
+			AudioOutput->Zero();
+		}
+
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAudioInput), AudioInput);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InParamNameAmplitude), Amplitude);
+		}
+
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override {
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutParamNameAudio), AudioOutput);
+		}
+
+		virtual FExecuteFunction GetExecuteFunction() override { return nullptr; }
+		virtual FPostExecuteFunction GetPostExecuteFunction() override { return nullptr; }
+		virtual FResetFunction GetResetFunction() override {
+			return [](IOperator* InOperator, const FResetParams& InParams) {
+				static_cast<FVolumeSilenceOperator*>(InOperator)->AudioOutput->Zero();
+			};
+		}
+
+	private:
+		Metasound::FFloatReadRef Amplitude;
+		Metasound::FAudioBufferReadRef AudioInput;
+		Metasound::FAudioBufferWriteRef AudioOutput;
+	};
 }
 
 BachelorMetasound::FVolumeOperator::FVolumeOperator(const Metasound::FOperatorSettings& InSettings,
@@ -73,6 +148,13 @@ TUniquePtr<Metasound::IOperator> BachelorMetasound::FVolumeOperator::CreateOpera
 			METASOUND_GET_PARAM_NAME(InParamNameAmplitude), 
 			InParams.OperatorSettings
 		);
+
+	// A constant amplitude of 1 or 0 makes the operator trivial, decided once at build time.
+	float ConstantAmplitude = 0.f;
+	if (TryGetConstantInput<float>(InParams, METASOUND_GET_PARAM_NAME(InParamNameAmplitude), ConstantAmplitude)) {
+		if (ConstantAmplitude == 1.f) return MakeUnique<FVolumePassthroughOperator>(AudioIn, InAmplitude);
+		if (ConstantAmplitude == 0.f) return MakeUnique<FVolumeSilenceOperator>(InParams.OperatorSettings, AudioIn, InAmplitude);
+	}
 	return MakeUnique<FVolumeOperator>(InParams.OperatorSettings, AudioIn, InAmplitude);
 }
 
@@ -90,11 +172,23 @@ void BachelorMetasound::FVolumeOperator::Execute() {
 	float* OutputAudio = AudioOutput->GetData();
 
 	const int32 NumSamples = AudioInput->Num();
+	const FScopedNodeRenderStats RenderStats(ENodeRenderClass::Volume, NumSamples);
 
 	VolumeDSPProcessor.SetAmplitude(*Amplitude);
 	VolumeDSPProcessor.Process(InputAudio, OutputAudio, NumSamples);
 }
 
+void BachelorMetasound::FVolumeOperator::Reset(const Metasound::IOperator::FResetParams& InParams) {
+	VolumeDSPProcessor.Init();
+	AudioOutput->Zero();
+}
+
+Metasound::IOperator::FResetFunction BachelorMetasound::FVolumeOperator::GetResetFunction() {
+	return [](Metasound::IOperator* InOperator, const Metasound::IOperator::FResetParams& InParams) {
+		static_cast<FVolumeOperator*>(InOperator)->Reset(InParams);
+	};
+}
+
 namespace BachelorMetasound {
 	METASOUND_REGISTER_NODE(FVolumeNode)
 }
@@ -10,11 +10,49 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MetasoundEnumRegistrationMacro.h"
 #include "MetasoundFacade.h"
 #include "MetasoundVertex.h"
+#include "DSP/NoiseColor.h"
 
 namespace Metasound {
 
+	/**
+	 * @enum EAdvancedNoiseType
+	 * @brief Noise types selectable on the noise generator nodes.
+	 */
+	enum class EAdvancedNoiseType : uint8 {
+		Pink	= 0,
+		White	= 1,
+		Brown	= 2,
+		Green	= 3
+	};
+
+	DECLARE_METASOUND_ENUM(
+		EAdvancedNoiseType,
+		EAdvancedNoiseType::Pink,
+		BACHELORMETASOUND_API,
+		FEnumAdvancedNoiseType,
+		FEnumAdvancedNoiseTypeInfo,
+		FEnumAdvancedNoiseTypeReadRef,
+		FEnumAdvancedNoiseTypeWriteRef
+		);
+
+	/**
+	 * @brief Maps a node noise type onto the matching BachelorDSP noise color.
+	 *
+	 * @param InType Noise type selected on the node.
+	 * @return Matching noise color, White for unknown values.
+	 */
+	FORCEINLINE BachelorDSP::ENoiseColor GetNoiseColor(const EAdvancedNoiseType InType) {
+		switch (InType) {
+		case EAdvancedNoiseType::Pink:	return BachelorDSP::ENoiseColor::Pink;
+		case EAdvancedNoiseType::Brown:	return BachelorDSP::ENoiseColor::Brown;
+		case EAdvancedNoiseType::Green:	return BachelorDSP::ENoiseColor::Green;
+		default:						return BachelorDSP::ENoiseColor::White;
+		}
+	}
+
 	/**
 	 * @class FAdvancedNoiseNode
 	 * @brief MetaSound facade node for advanced procedural noise generation.
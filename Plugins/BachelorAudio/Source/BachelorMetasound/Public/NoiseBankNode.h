@@ -0,0 +1,141 @@
+﻿/**
+ * @file NoiseBankNode.h
+ * @brief MetaSound operator and node for generating several decorrelated noise channels.
+ *
+ * This file defines a MetaSound-compatible operator and node that wraps the
+ * BachelorDSP::TNoiseBank processor, producing N decorrelated noise outputs in a single Execute.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AdvancedNoiseNode.h"
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundParamHelper.h"
+#include "DSP/NoiseBank.h"
+
+namespace BachelorMetasound {
+
+	/**
+	 * @class TNoiseBankOperator
+	 * @brief MetaSound operator producing NumChannels decorrelated noise channels.
+	 *
+	 * All channels share noise type and spectral shaping, every channel runs its own random stream.
+	 * Replaces NumChannels AdvancedNoise nodes with different seeds by one operator.
+	 *
+	 * @tparam NumChannels Number of audio outputs.
+	 */
+	template<int32 NumChannels>
+	class TNoiseBankOperator final : public Metasound::TExecutableOperator<TNoiseBankOperator<NumChannels>> {
+	public:
+		/**
+		 * @brief Constructs a noise bank operator with references to input parameters.
+		 *
+		 * @param InSettings MetaSound operator settings (e.g., block size, sample rate).
+		 * @param InSeed Base seed, every channel derives its own stream from it.
+		 * @param InNoiseType Noise type shared by all channels.
+		 */
+		TNoiseBankOperator(
+			const Metasound::FOperatorSettings& InSettings,
+			const Metasound::FInt32ReadRef& InSeed,
+			const Metasound::FEnumAdvancedNoiseTypeReadRef& InNoiseType
+		);
+
+		/**
+		 * @brief Provides static metadata describing the node for editor/runtime registration.
+		 *
+		 * @return Reference to class metadata structure.
+		 */
+		static const Metasound::FNodeClassMetadata& GetNodeInfo();
+
+		/**
+		 * @brief Describes the MetaSound inputs and outputs for this operator.
+		 *
+		 * @return Reference to a vertex interface structure defining ports.
+		 */
+		static const Metasound::FVertexInterface& GetVertexInterface();
+
+		/**
+		 * @brief Factory method to create a new noise bank operator instance.
+		 *
+		 * @param InParams Parameters needed to build the operator (e.g., input map).
+		 * @param OutResults Contains success/failure status and any build messages.
+		 * @return Unique pointer to a valid MetaSound operator.
+		 */
+		static TUniquePtr<Metasound::IOperator> CreateOperator(
+			const Metasound::FBuildOperatorParams& InParams,
+			Metasound::FBuildResults& OutResults
+		);
+
+		/**
+		 * @brief Binds graph inputs to internal data references.
+		 *
+		 * @param InOutVertexData The input vertex map passed from MetaSound runtime.
+		 */
+		virtual void BindInputs(Metasound::FInputVertexInterfaceData& InOutVertexData) override;
+
+		/**
+		 * @brief Binds graph outputs to internal output references.
+		 *
+		 * @param InOutVertexData The output vertex map passed from MetaSound runtime.
+		 */
+		virtual void BindOutputs(Metasound::FOutputVertexInterfaceData& InOutVertexData) override;
+
+		/**
+		 * @brief Generates one block for every output channel.
+		 */
+		void Execute();
+
+		/**
+		 * @brief Reseeds all channels, clears the shaping state and all output buffers.
+		 * 
+		 * @param InParams Reset parameters passed by the MetaSound runtime.
+		 */
+		void Reset(const Metasound::IOperator::FResetParams& InParams);
+
+		/**
+		 * @brief Returns the reset function, so pooled graph instances can be reused.
+		 */
+		virtual Metasound::IOperator::FResetFunction GetResetFunction() override;
+
+	private:
+		/** Instance of the BachelorDSP noise bank processor. */
+		BachelorDSP::TNoiseBank<NumChannels> NoiseBankProcessor;
+
+		/** Base seed for all channels. */
+		Metasound::FInt32ReadRef Seed;
+
+		/** Noise type shared by all channels. */
+		Metasound::FEnumAdvancedNoiseTypeReadRef NoiseType;
+
+		/** One output buffer per channel. */
+		TArray<Metasound::FAudioBufferWriteRef> AudioOutputs;
+
+		/** Seed the processor was last seeded with. */
+		int32 OldSeed;
+	};
+
+	/**
+	 * @class TNoiseBankNode
+	 * @brief MetaSound node facade for the noise bank operator.
+	 *
+	 * Registers the TNoiseBankOperator for use in the MetaSound editor and runtime.
+	 */
+	template<int32 NumChannels>
+	class TNoiseBankNode final : public Metasound::FNodeFacade {
+	public:
+		/**
+		 * @brief Constructs the noise bank node facade.
+		 *
+		 * @param InitData Node instance metadata (e.g., name, ID).
+		 */
+		explicit TNoiseBankNode(const Metasound::FNodeInitData& InitData)
+			: Metasound::FNodeFacade(
+				InitData.InstanceName,
+				InitData.InstanceID,
+				Metasound::TFacadeOperatorClass<TNoiseBankOperator<NumChannels>>())
+		{}
+	};
+
+}
@@ -0,0 +1,35 @@
+﻿/**
+ * @file NoiseNotchVolumeNode.h
+ * @brief MetaSound node generating, notch filtering and scaling noise in one operator.
+ *
+ * This file defines the facade of a fused node that replaces the common graph
+ * AdvancedNoise -> NotchFilter -> Volume. The operator runs all three BachelorDSP kernels in a single
+ * loop per block, without intermediate buffers, and produces the same output as the three nodes.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MetasoundFacade.h"
+#include "MetasoundVertex.h"
+
+namespace BachelorMetasound {
+
+	/**
+	 * @class FNoiseNotchVolumeNode
+	 * @brief MetaSound node facade for the fused noise, notch filter and volume operator.
+	 *
+	 * Exposes the union of the inputs of the AdvancedNoise, NotchFilter and Volume nodes. The notch
+	 * inputs carry a "Notch" prefix, as their names clash with the noise inputs.
+	 */
+	class BACHELORMETASOUND_API FNoiseNotchVolumeNode final : public Metasound::FNodeFacade {
+	public:
+		/**
+		 * @brief Constructs the fused node facade.
+		 *
+		 * @param InitData Node instance metadata (e.g., name, ID).
+		 */
+		explicit FNoiseNotchVolumeNode(const Metasound::FNodeInitData& InitData);
+	};
+
+}
@@ -11,6 +11,7 @@
 #include "CoreMinimal.h"
 #include "MetasoundEnumRegistrationMacro.h"
 #include "MetasoundParamHelper.h"
+#include "ControlRate.h"
 #include "DSP/NotchFilter.h"
 
 namespace BachelorMetasound {
@@ -82,6 +83,18 @@ namespace BachelorMetasound {
 		 */
 		void Execute();
 
+		/**
+		 * @brief Clears the filter history and the output buffer, recomputes the coefficients.
+		 * 
+		 * @param InParams Reset parameters passed by the MetaSound runtime.
+		 */
+		void Reset(const Metasound::IOperator::FResetParams& InParams);
+
+		/**
+		 * @brief Returns the reset function, so pooled graph instances can be reused.
+		 */
+		virtual Metasound::IOperator::FResetFunction GetResetFunction() override;
+
 	private:
 		/** Instance of the notch filter DSP processor. */
 		BachelorDSP::FNotchFilter NotchFilterProcessor;
@@ -100,6 +113,12 @@ namespace BachelorMetasound {
 
 		/** Width of the frequency range to attenuate. */
 		Metasound::FFloatReadRef BandwidthCoefficients;
+
+		/** Sampling frequency, cutoff and bandwidth, evaluated at control rate. */
+		TControlRateParameters<3> FilterParameters;
+
+		/** Applies the control-rate filter parameters to the processor if they changed. */
+		void UpdateFilterParameters();
 	};
 
 	/**
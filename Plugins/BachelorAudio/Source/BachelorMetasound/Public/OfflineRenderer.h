@@ -0,0 +1,98 @@
+﻿/**
+ * @file OfflineRenderer.h
+ * @brief Parallel offline rendering of BachelorDSP processor chains into WAV files.
+ *
+ * Every job generates or loads a mono input, runs it through a chain of BachelorDSP processors and
+ * writes the result as 16 bit WAV. Jobs are spread over all cores, every worker reuses its processors
+ * and buffers from job to job. No audio device or world is needed, see UBachelorOfflineRenderCommandlet
+ * for the headless entry point.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DSP/NoiseColor.h"
+#include "DSP/ProcessorBase.h"
+
+namespace BachelorMetasound {
+
+	/**
+	 * @struct FOfflineRenderStage
+	 * @brief One processor of a render chain.
+	 */
+	struct FOfflineRenderStage {
+		/** Processor type of the stage. */
+		BachelorDSP::EDSPType Type = BachelorDSP::EDSPType::Volume;
+
+		/**
+		 * Parameters in the order of the processor's setters, the sample rate is taken from the job.
+		 * Volume: Amplitude. NotchFilter: Cutoff, Bandwidth. PeakingFilter: Frequency, Quality, Gain in dB.
+		 * Missing parameters are 0.
+		 */
+		TArray<float, TInlineAllocator<3>> Parameters;
+	};
+
+	/**
+	 * @struct FOfflineRenderJob
+	 * @brief Input, chain and destination of one rendered file.
+	 */
+	struct FOfflineRenderJob {
+		/** WAV file to process. If empty, noise of NoiseColor is generated instead. */
+		FString InputPath;
+
+		/** Color of the generated input. */
+		BachelorDSP::ENoiseColor NoiseColor = BachelorDSP::ENoiseColor::White;
+
+		/** Seed of the generated input, equal seeds render equal files. */
+		int32 Seed = 0;
+
+		/** Frames of generated input. A loaded input renders its full length. */
+		int32 NumFrames = 0;
+
+		/** Sample rate of generated input. A loaded input keeps its own. */
+		int32 SampleRate = 48000;
+
+		/** Processors applied in order. */
+		TArray<FOfflineRenderStage> Chain;
+
+		/** Destination WAV file, missing directories are created. */
+		FString OutputPath;
+	};
+
+	/**
+	 * @struct FOfflineRenderResult
+	 * @brief Outcome of one job.
+	 */
+	struct FOfflineRenderResult {
+		/** Whether the file was written. */
+		bool bSucceeded = false;
+
+		/** Reason of a failure, empty on success. */
+		FString Error;
+
+		/** Rendered frames. */
+		int32 NumFrames = 0;
+
+		/** Wall time the job took on its worker, including file IO. */
+		double Seconds = 0.0;
+	};
+
+	/**
+	 * @class FOfflineRenderer
+	 * @brief Renders a list of jobs across all cores.
+	 */
+	class BACHELORMETASOUND_API FOfflineRenderer {
+	public:
+		/**
+		 * @brief Renders all jobs and blocks until every file is written.
+		 *
+		 * Jobs are independent, so the output of a job does not depend on the number of workers.
+		 *
+		 * @param InJobs Jobs to render.
+		 * @param bInSingleThreaded Renders on the calling thread only, e.g. for comparisons.
+		 * @return One result per job, in the order of InJobs.
+		 */
+		static TArray<FOfflineRenderResult> Render(const TArray<FOfflineRenderJob>& InJobs, const bool bInSingleThreaded = false);
+	};
+
+}
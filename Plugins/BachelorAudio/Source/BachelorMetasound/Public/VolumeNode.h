@@ -81,6 +81,18 @@ namespace BachelorMetasound {
 		 */
 		void Execute();
 
+		/**
+		 * @brief Restores the state after construction, clears the output buffer.
+		 * 
+		 * @param InParams Reset parameters passed by the MetaSound runtime.
+		 */
+		void Reset(const Metasound::IOperator::FResetParams& InParams);
+
+		/**
+		 * @brief Returns the reset function, so pooled graph instances can be reused.
+		 */
+		virtual Metasound::IOperator::FResetFunction GetResetFunction() override;
+
 	private:
 		/** Instance of the BachelorDSP volume processor. */
 		BachelorDSP::FBachelorVolume VolumeDSPProcessor;
@@ -0,0 +1,16 @@
+﻿using UnrealBuildTool;
+
+public class BachelorRenderStats : ModuleRules
+{
+    public BachelorRenderStats(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+            }
+        );
+    }
+}
@@ -0,0 +1,8 @@
+﻿/**
+ * @file BachelorRenderStatsModule.cpp
+ * @brief Module of the node render cost counters, see NodeRenderStats.h.
+ */
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, BachelorRenderStats);
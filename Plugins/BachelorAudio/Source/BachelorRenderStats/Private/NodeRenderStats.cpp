@@ -0,0 +1,72 @@
+﻿/**
+ * @file NodeRenderStats.cpp
+ * @brief Opt-in render cost counters per BachelorMetasound node class.
+ */
+
+#include "NodeRenderStats.h"
+
+#include <atomic>
+#include "HAL/IConsoleManager.h"
+
+namespace BachelorMetasound {
+
+	namespace NodeRenderStats {
+
+		/** Counters of one node class, on their own cache line so audio render threads do not share lines. */
+		struct alignas(PLATFORM_CACHE_LINE_SIZE) FCounters {
+			std::atomic<uint64> Cycles{0};
+			std::atomic<uint64> NumExecutes{0};
+			std::atomic<uint64> NumSamples{0};
+		};
+
+		FCounters Counters[static_cast<int32>(ENodeRenderClass::Num)];
+
+		std::atomic<bool> bEnabled{false};
+
+		bool bEnabledCVar = false;
+		FAutoConsoleVariableRef CVarEnabled(
+			TEXT("au.BachelorMetasound.NodeRenderStats"),
+			bEnabledCVar,
+			TEXT("Measures the render cost of every BachelorMetasound node class.\n0: off, 1: on"),
+			FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* InVariable) {
+				bEnabled.store(InVariable->GetBool(), std::memory_order_relaxed);
+			}),
+			ECVF_Default);
+	}
+
+	const TCHAR* LexToString(const ENodeRenderClass InClass) {
+		switch (InClass) {
+		case ENodeRenderClass::Volume:			return TEXT("Volume");
+		case ENodeRenderClass::NotchFilter:		return TEXT("NotchFilter");
+		case ENodeRenderClass::AdvancedNoise:	return TEXT("AdvancedNoise");
+		case ENodeRenderClass::NoiseBank:		return TEXT("NoiseBank");
+		case ENodeRenderClass::NoiseNotchVolume:	return TEXT("NoiseNotchVolume");
+		default:								return TEXT("Unknown");
+		}
+	}
+
+	bool FNodeRenderStats::IsEnabled() {
+		return NodeRenderStats::bEnabled.load(std::memory_order_relaxed);
+	}
+
+	void FNodeRenderStats::SetEnabled(const bool bInEnabled) {
+		NodeRenderStats::bEnabled.store(bInEnabled, std::memory_order_relaxed);
+	}
+
+	void FNodeRenderStats::Add(const ENodeRenderClass InClass, const uint64 InCycles, const int32 InNumSamples) {
+		NodeRenderStats::FCounters& Counters = NodeRenderStats::Counters[static_cast<int32>(InClass)];
+		Counters.Cycles.fetch_add(InCycles, std::memory_order_relaxed);
+		Counters.NumExecutes.fetch_add(1, std::memory_order_relaxed);
+		Counters.NumSamples.fetch_add(InNumSamples, std::memory_order_relaxed);
+	}
+
+	FNodeRenderStatsSnapshot FNodeRenderStats::GetSnapshot(const ENodeRenderClass InClass) {
+		const NodeRenderStats::FCounters& Counters = NodeRenderStats::Counters[static_cast<int32>(InClass)];
+		FNodeRenderStatsSnapshot Snapshot;
+		Snapshot.Cycles = Counters.Cycles.load(std::memory_order_relaxed);
+		Snapshot.NumExecutes = Counters.NumExecutes.load(std::memory_order_relaxed);
+		Snapshot.NumSamples = Counters.NumSamples.load(std::memory_order_relaxed);
+		return Snapshot;
+	}
+
+}
@@ -0,0 +1,119 @@
+﻿/**
+ * @file NodeRenderStats.h
+ * @brief Opt-in render cost counters per BachelorMetasound node class.
+ *
+ * Every operator measures its Execute with a FScopedNodeRenderStats. While disabled the scope only
+ * checks a flag. While enabled the cycles are added to lock-free counters, which are shared by all
+ * instances of a node class and can be read from any thread, e.g. by the AudioProfiler.
+ * Enable with the console variable au.BachelorMetasound.NodeRenderStats 1 or SetEnabled().
+ *
+ * Lives in its own module that only depends on Core, so runtime consumers like the AudioProfiler
+ * read the counters without linking the MetaSound nodes and their editor dependencies.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace BachelorMetasound {
+
+	/**
+	 * @enum ENodeRenderClass
+	 * @brief Node classes with their own render cost counters.
+	 */
+	enum class ENodeRenderClass : uint8 {
+		Volume,
+		NotchFilter,
+		AdvancedNoise,
+		NoiseBank,
+		NoiseNotchVolume,
+		Num
+	};
+
+	/**
+	 * @brief Returns the display name of a node class.
+	 *
+	 * @param InClass Node class.
+	 * @return Name used in logs and exports.
+	 */
+	BACHELORRENDERSTATS_API const TCHAR* LexToString(const ENodeRenderClass InClass);
+
+	/**
+	 * @struct FNodeRenderStatsSnapshot
+	 * @brief Totals of one node class since engine start.
+	 */
+	struct FNodeRenderStatsSnapshot {
+		/** Cycles spent in Execute, see FPlatformTime::Cycles64. */
+		uint64 Cycles = 0;
+
+		/** Number of executed blocks. */
+		uint64 NumExecutes = 0;
+
+		/** Number of rendered frames. */
+		uint64 NumSamples = 0;
+	};
+
+	/**
+	 * @class FNodeRenderStats
+	 * @brief Global render cost counters of all node classes.
+	 */
+	class BACHELORRENDERSTATS_API FNodeRenderStats {
+	public:
+		/** @return Whether operators currently measure their Execute. */
+		static bool IsEnabled();
+
+		/**
+		 * @brief Enables or disables measuring, counters keep their totals.
+		 *
+		 * @param bInEnabled New state.
+		 */
+		static void SetEnabled(const bool bInEnabled);
+
+		/**
+		 * @brief Adds one measured block to the counters of a node class.
+		 *
+		 * @param InClass Node class of the measured operator.
+		 * @param InCycles Cycles spent in Execute.
+		 * @param InNumSamples Frames rendered in the block.
+		 */
+		static void Add(const ENodeRenderClass InClass, const uint64 InCycles, const int32 InNumSamples);
+
+		/**
+		 * @brief Reads the totals of a node class.
+		 *
+		 * @param InClass Node class.
+		 * @return Totals since engine start, every counter is read atomically on its own.
+		 */
+		static FNodeRenderStatsSnapshot GetSnapshot(const ENodeRenderClass InClass);
+	};
+
+	/**
+	 * @class FScopedNodeRenderStats
+	 * @brief Measures its own lifetime and adds it to the counters of a node class.
+	 */
+	class FScopedNodeRenderStats {
+	public:
+		/**
+		 * @param InClass Node class of the measured operator.
+		 * @param InNumSamples Frames rendered within the scope.
+		 */
+		FScopedNodeRenderStats(const ENodeRenderClass InClass, const int32 InNumSamples)
+			: StartCycles(FNodeRenderStats::IsEnabled() ? FPlatformTime::Cycles64() : 0),
+			  NumSamples(InNumSamples),
+			  Class(InClass) {}
+
+		~FScopedNodeRenderStats() {
+			if (StartCycles == 0) return;
+			FNodeRenderStats::Add(Class, FPlatformTime::Cycles64() - StartCycles, NumSamples);
+		}
+
+		FScopedNodeRenderStats(const FScopedNodeRenderStats&) = delete;
+		FScopedNodeRenderStats& operator=(const FScopedNodeRenderStats&) = delete;
+
+	private:
+		uint64 StartCycles;
+		int32 NumSamples;
+		ENodeRenderClass Class;
+	};
+
+}